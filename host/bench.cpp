@@ -0,0 +1,88 @@
+// 긴 스트립 렌더링 벤치마크
+// 펌웨어를 -DNUM_LEDS=10240 -DMAX_LEDS=10240으로 빌드해 모드마다 정해진 시간 동안 프레임을 그리고
+// 켜진 출력 대상으로 내보내며 지속 FPS를 잰다 (renderAndOutput() 한 번 = 한 프레임).
+// 애니메이션 시계는 멈추고 프레임마다 FRAME_PERIOD_MS씩 앞당기므로 매 프레임이 새 단계(또는 보간 프레임)가 되고,
+// 나눠 계산하는 효과도 RENDER_SLICE_US에 걸리지 않아 프레임마다 단계를 끝까지 계산한다. 시간은 실제 시계로 잰다.
+//
+// 사용법: bench [--seconds 1] [--min-fps N] [--threads N] [--spi PATH] [--shm NAME] [--socket PATH]
+//   --min-fps  어느 모드든 이보다 느리면 종료 코드 1
+//   --threads  한 번에 끝까지 계산하는 청크 단계를 이 수의 스레드로 나눔 (renderPool.h, 기본 1)
+//   --spi/--shm/--socket  출력 비용까지 재려면 lightd와 같은 출력 대상을 켬 (스트립 대체 출력은 항상 켜짐)
+//   errors는 출력 실패 수 (socket은 받는 쪽이 느리면 기다리지 않고 버리므로 여기서 셈)
+
+#include "main.cpp"
+#include "renderPool.h"
+
+static void usage()
+{
+  fprintf(stderr, "usage: bench [--seconds N] [--min-fps N] [--threads N] [--spi PATH] [--shm NAME] [--socket PATH]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  double seconds = 1;
+  double minFps = 0;
+  int threads = 1;
+  for (int i = 1; i < argc; i++)
+  {
+    if (i + 1 >= argc) usage();
+    const char *arg = argv[i];
+    const char *value = argv[++i];
+    if (strcmp(arg, "--seconds") == 0) seconds = atof(value);
+    else if (strcmp(arg, "--min-fps") == 0) minFps = atof(value);
+    else if (strcmp(arg, "--threads") == 0) threads = constrain(atoi(value), 1, RENDER_POOL_MAX_THREADS);
+    else if (strcmp(arg, "--spi") == 0) hostSinkConfig.spiPath = value;
+    else if (strcmp(arg, "--shm") == 0) hostSinkConfig.shmName = value;
+    else if (strcmp(arg, "--socket") == 0) hostSinkConfig.socketPath = value;
+    else usage();
+  }
+
+  Serial.muted = true;
+  setup();
+  sinkEnable(SINK_SPI, !hostSinkConfig.spiPath.empty());
+  sinkEnable(SINK_SHM, !hostSinkConfig.shmName.empty());
+  sinkEnable(SINK_SOCKET, !hostSinkConfig.socketPath.empty());
+  FastLED.setBrightness(128);
+  hostClockFreeze(true);
+  renderPoolStart(threads);
+
+  printf("%u픽셀, 모드마다 %.1f초, 렌더 스레드 %d, 출력:", NUMPIXELS, seconds, threads);
+  for (uint8_t id = 0; id < SINK_COUNT; id++)
+  {
+    if (sinkEnabled(id)) printf(" %s", outputSinks[id].name);
+  }
+  printf("\n%-12s %8s %9s %10s %8s\n", "mode", "frames", "fps", "ms/frame", "errors");
+
+  bool pass = true;
+  for (int mode = 0; mode < MODE_COUNT; mode++)
+  {
+    currentMode = (Mode)mode;
+    renderAndOutput();  // 모드 전환과 첫 단계는 재지 않음
+
+    uint32_t errors = 0;
+    for (uint8_t id = 0; id < SINK_COUNT; id++) errors -= sinkStats[id].errors;
+    uint64_t start = hostMonotonicUs();
+    uint64_t end = start + (uint64_t)(seconds * 1e6);
+    uint64_t now = start;
+    uint32_t frames = 0;
+    while (now < end)
+    {
+      hostClockAdvance(FRAME_PERIOD_MS * 1000UL);
+      redrawRequested = true;  // 노말 모드는 색이 그대로면 그리지 않으므로 매 프레임 다시 그리게 함
+      renderAndOutput();
+      frames++;
+      now = hostMonotonicUs();
+    }
+
+    for (uint8_t id = 0; id < SINK_COUNT; id++) errors += sinkStats[id].errors;
+    double elapsed = (now - start) / 1e6;
+    double fps = frames / elapsed;
+    printf("%-12s %8u %9.1f %10.3f %8u\n", getModeName((Mode)mode), frames, fps, elapsed * 1000 / frames, errors);
+    if (minFps > 0 && fps < minFps) pass = false;
+  }
+
+  renderPoolStop();
+  if (minFps > 0) printf("모든 모드 %.0ffps 이상: %s\n", minFps, pass ? "통과" : "실패");
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+// 호스트 빌드 전용 출력 대상 (src/outputSink.h가 HOST_BUILD일 때 포함)
+//   spi    : APA102 프레임을 spidev(예: /dev/spidev0.0)에 씀. 일반 파일이면 매 프레임 처음부터 덮어씀 (시험용)
+//   shm    : 공유 메모리 프레임 버퍼 (/dev/shm/<이름>). 시퀀스 잠금(seqlock)으로 읽는 쪽이 찢어진 프레임을 보지 않음
+//   socket : UNIX 데이터그램 소켓으로 미리보기 패킷을 보냄 (scripts/frame_viewer.py --unix)
+// 경로가 정해지지 않았으면 write()가 실패로 기록된다. 열기는 첫 출력 때 하고, 실패하면 다음 프레임에 다시 시도한다.
+//
+// 공유 메모리 배치 (리틀 엔디안)
+//   [0..3]   magic    'LFRM' (0x4D52464C)
+//   [4..7]   seq      쓰는 중이면 홀수, 다 쓰면 짝수 (읽기 전후 값이 같고 짝수일 때만 유효)
+//   [8..11]  frame    프레임 번호
+//   [12..13] count    픽셀 수
+//   [14]     brightness  전역 밝기 (픽셀 값은 밝기 적용 전)
+//   [15]     reserved
+//   [16..]   픽셀 R,G,B 순서 (MAX_LEDS개 자리)
+
+#pragma once
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <linux/spi/spidev.h>
+#include <string>
+
+#define HOST_SHM_MAGIC 0x4D52464C
+#define HOST_SPI_CHUNK 4096            // spidev 한 번 전송 최대 크기 (커널 기본 bufsiz)
+#define HOST_SPI_DEFAULT_HZ 8000000
+
+struct HostShmFrame {
+  uint32_t magic;
+  uint32_t seq;
+  uint32_t frame;
+  uint16_t count;
+  uint8_t brightness;
+  uint8_t reserved;
+  uint8_t pixels[MAX_LEDS * 3];
+};
+
+// 데몬 옵션으로 정하는 출력 경로 (빈 문자열이면 사용 안 함)
+struct HostSinkConfig {
+  std::string spiPath;
+  uint32_t spiHz = HOST_SPI_DEFAULT_HZ;
+  std::string shmName;
+  std::string socketPath;
+};
+
+inline HostSinkConfig hostSinkConfig;
+
+inline int hostSpiFd = -1;
+inline bool hostSpiIsFile = false;
+inline std::vector<uint8_t> hostSpiBuffer;
+inline HostShmFrame *hostShm = nullptr;
+inline int hostSocketFd = -1;
+inline uint16_t hostSocketFrame = 0;
+
+inline bool hostSpiOpen()
+{
+  if (hostSpiFd >= 0) return true;
+  if (hostSinkConfig.spiPath.empty()) return false;
+  hostSpiFd = open(hostSinkConfig.spiPath.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+  if (hostSpiFd < 0) return false;
+  struct stat st;
+  hostSpiIsFile = fstat(hostSpiFd, &st) == 0 && S_ISREG(st.st_mode);
+  if (!hostSpiIsFile)
+  {
+    uint8_t mode = SPI_MODE_0;
+    ioctl(hostSpiFd, SPI_IOC_WR_MODE, &mode);
+    ioctl(hostSpiFd, SPI_IOC_WR_MAX_SPEED_HZ, &hostSinkConfig.spiHz);
+  }
+  return true;
+}
+
+// APA102: 시작 프레임 0 4바이트, 픽셀마다 (0xE0 | 밝기 5비트), B, G, R, 끝 프레임 (픽셀 2개당 1비트 클럭)
+// 전역 밝기는 5비트 단계 대신 채널 값에 8비트로 곱해 FastLED 스트립 출력과 같게 맞춤
+bool spiWrite(const CRGB *pixels, uint16_t count, uint8_t brightness)
+{
+  if (!hostSpiOpen()) return false;
+  size_t endBytes = (count + 15) / 16;
+  hostSpiBuffer.assign(4 + count * 4 + endBytes, 0xFF);
+  uint8_t *out = hostSpiBuffer.data();
+  memset(out, 0, 4);
+  out += 4;
+  for (uint16_t i = 0; i < count; i++)
+  {
+    *out++ = 0xFF;
+    *out++ = scale8(pixels[i].b, brightness);
+    *out++ = scale8(pixels[i].g, brightness);
+    *out++ = scale8(pixels[i].r, brightness);
+  }
+
+  const uint8_t *data = hostSpiBuffer.data();
+  size_t length = hostSpiBuffer.size();
+  if (hostSpiIsFile) return pwrite(hostSpiFd, data, length, 0) == (ssize_t)length;
+  for (size_t sent = 0; sent < length; sent += HOST_SPI_CHUNK)
+  {
+    size_t n = min(length - sent, (size_t)HOST_SPI_CHUNK);
+    if (write(hostSpiFd, data + sent, n) != (ssize_t)n) return false;
+  }
+  return true;
+}
+
+inline bool hostShmOpen()
+{
+  if (hostShm != nullptr) return true;
+  if (hostSinkConfig.shmName.empty()) return false;
+  std::string name = hostSinkConfig.shmName[0] == '/' ? hostSinkConfig.shmName : "/" + hostSinkConfig.shmName;
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0) return false;
+  void *mapped = MAP_FAILED;
+  if (ftruncate(fd, sizeof(HostShmFrame)) == 0)
+  {
+    mapped = mmap(nullptr, sizeof(HostShmFrame), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (mapped == MAP_FAILED) return false;
+  hostShm = (HostShmFrame *)mapped;
+  hostShm->magic = HOST_SHM_MAGIC;
+  return true;
+}
+
+bool shmWrite(const CRGB *pixels, uint16_t count, uint8_t brightness)
+{
+  if (!hostShmOpen()) return false;
+  // seq를 홀수로 바꾼 뒤 쓰고, 다 쓴 다음 짝수로 (읽는 쪽은 전후 seq가 같은 짝수일 때만 사용)
+  uint32_t seq = __atomic_load_n(&hostShm->seq, __ATOMIC_RELAXED);
+  __atomic_store_n(&hostShm->seq, seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  hostShm->frame++;
+  hostShm->count = count;
+  hostShm->brightness = brightness;
+  memcpy(hostShm->pixels, pixels, count * sizeof(CRGB));
+  __atomic_store_n(&hostShm->seq, seq + 2, __ATOMIC_RELEASE);
+  return true;
+}
+
+// 미리보기 패킷을 UDP 대신 UNIX 소켓으로 (받는 쪽이 느리면 기다리지 않고 그 프레임을 버림)
+bool socketWrite(const CRGB *pixels, uint16_t count, uint8_t brightness)
+{
+  if (hostSinkConfig.socketPath.empty()) return false;
+  if (hostSocketFd < 0) hostSocketFd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (hostSocketFd < 0) return false;
+
+  struct sockaddr_un to = {};
+  to.sun_family = AF_UNIX;
+  strncpy(to.sun_path, hostSinkConfig.socketPath.c_str(), sizeof(to.sun_path) - 1);
+
+  uint8_t packet[sizeof(ViewerPacketHeader) + VIEWER_PIXELS_PER_PACKET * sizeof(CRGB)];
+  bool ok = true;
+  for (uint16_t offset = 0; offset < count; offset += VIEWER_PIXELS_PER_PACKET)
+  {
+    uint16_t n = min((uint16_t)(count - offset), (uint16_t)VIEWER_PIXELS_PER_PACKET);
+    ViewerPacketHeader header = {VIEWER_MAGIC, VIEWER_VERSION, hostSocketFrame, offset, n, count, brightness, 0};
+    memcpy(packet, &header, sizeof(header));
+    memcpy(packet + sizeof(header), pixels + offset, n * sizeof(CRGB));
+    size_t length = sizeof(header) + n * sizeof(CRGB);
+    if (sendto(hostSocketFd, packet, length, MSG_DONTWAIT, (struct sockaddr *)&to, sizeof(to)) != (ssize_t)length)
+    {
+      ok = false;
+      break;
+    }
+  }
+  hostSocketFrame++;
+  return ok;
+}
@@ -0,0 +1,193 @@
+// 효과 커널 특수화 벤치마크
+// 펌웨어 길이(NUM_LEDS, 기본 173)의 스트립에서 모닥불/크리스마스/은은한 조명 커널의 전체 단계를
+// 세 가지 조합으로 반복 계산해 픽셀당 시간과 비교 기준 대비 속도를 잰다.
+//   runtime : 길이/색 순서/건너뛸 픽셀 수/밝기를 실행 시간에 읽음 (Adafruit_NeoPixel::setPixelColor()와 같은 계산)
+//   packed  : 길이와 색 순서, 건너뛸 픽셀 수가 빌드 상수인 PackedSink (AVR 펌웨어의 NeoPixel 출력)
+//   crgb    : 길이가 빌드 상수인 CrgbSink (ESP8266 펌웨어의 FastLED 출력)
+// 같은 시드에서 runtime과 packed가 쓴 바이트가 같은지도 확인한다 (다르면 종료 코드 1).
+//
+// 사용법: kernelBench [--seconds 0.5]
+
+#include "main.cpp"
+
+#define KERNEL_SKIP 18  // 비교용 앞쪽 건너뛸 픽셀 수 (AVR 펌웨어 기본값)
+#define KERNEL_BRIGHTNESS 128
+
+// 비교 기준 출력: 모든 값을 실행 시간에 읽음
+struct RuntimeSink {
+  uint8_t *bytes;
+  uint16_t skip;
+  uint8_t rOffset, gOffset, bOffset;
+  uint8_t brightness;  // 라이브러리 내부 값 (밝기 + 1, 0이면 그대로)
+
+  void set(uint16_t i, const CRGB &color) const
+  {
+    uint8_t r = color.r, g = color.g, b = color.b;
+    if (brightness)
+    {
+      r = (r * brightness) >> 8;
+      g = (g * brightness) >> 8;
+      b = (b * brightness) >> 8;
+    }
+    uint8_t *p = bytes + (skip + i) * 3;
+    p[rOffset] = r;
+    p[gOffset] = g;
+    p[bOffset] = b;
+  }
+};
+
+typedef PackedSink<LED_COLOR_ORDER, KERNEL_SKIP> BenchPackedSink;
+
+// 최적화가 길이/순서를 상수로 접지 못하도록 실행 시간 값은 volatile에서 읽음
+static volatile uint16_t runtimeCount = NUMPIXELS;
+static volatile uint16_t runtimeSkip = KERNEL_SKIP;
+static volatile uint8_t runtimeOrder = LED_COLOR_ORDER;
+
+struct KernelStrip {
+  uint8_t a[NUMPIXELS];  // 효과 현재값
+  uint8_t b[NUMPIXELS];  // 효과 목표값
+  CRGB out[NUMPIXELS];
+  uint8_t bytes[(NUMPIXELS + KERNEL_SKIP) * 3];
+
+  void init()
+  {
+    randomSeed(7);
+    for (int i = 0; i < NUMPIXELS; i++)
+    {
+      a[i] = random(50, 200);
+      b[i] = a[i];
+    }
+    memset(out, 0, sizeof(out));
+    memset(bytes, 0, sizeof(bytes));
+  }
+
+  RuntimeSink runtimeSink()
+  {
+    EOrder order = (EOrder)runtimeOrder;
+    return {bytes, runtimeSkip, orderByte(order, 0), orderByte(order, 1), orderByte(order, 2),
+            KERNEL_BRIGHTNESS + 1};
+  }
+
+  BenchPackedSink packedSink() { return {bytes, KERNEL_BRIGHTNESS + 1}; }
+};
+
+enum KernelBackend { BACKEND_RUNTIME, BACKEND_PACKED, BACKEND_CRGB, BACKEND_COUNT };
+static const char *backendNames[BACKEND_COUNT] = {"runtime", "packed", "crgb"};
+
+enum KernelEffect { KERNEL_CAMPFIRE, KERNEL_CHRISTMAS, KERNEL_WARMLIGHT, KERNEL_EFFECTS };
+static const char *effectNames[KERNEL_EFFECTS] = {"campfire", "christmas", "warmLight"};
+
+// 커널의 픽셀 수 자리 (빌드 상수면 비어 있음)
+template <uint16_t Count>
+static PixelCount<Count> pixelCount(uint16_t)
+{
+  return {};
+}
+
+template <>
+PixelCount<0> pixelCount<0>(uint16_t count)
+{
+  return {count};
+}
+
+// 전체 단계 하나 (커널을 인자 없이 불러 스트립 전체를 한 번에)
+// 커널마다 따로 된 함수로 두어 인라인 여부가 조합에 따라 달라지지 않게 함
+template <typename Kernel>
+__attribute__((noinline)) static void runKernel(const Kernel &kernel)
+{
+  kernel();
+}
+
+template <uint16_t Count, typename Sink>
+static void kernelStep(KernelStrip &s, KernelEffect effect, Sink sink, uint16_t count, uint32_t step)
+{
+  if (effect == KERNEL_CAMPFIRE)
+  {
+    CampfireKernel<Count, Sink> kernel = {s.a, s.b, sink, &HeatColors_p, nullptr, 15, 5, true,
+                                          pixelCount<Count>(count)};
+    runKernel(kernel);
+  }
+  else if (effect == KERNEL_CHRISTMAS)
+  {
+    ChristmasKernel<Count, Sink> kernel = {sink, &PartyColors_p, step, (uint8_t)(step % 3), 3,
+                                           pixelCount<Count>(count)};
+    runKernel(kernel);
+  }
+  else
+  {
+    WarmLightKernel<Count, Sink> kernel = {s.a, s.b, sink, CRGB(255, 180, 107), 10, 20, 230, 8, true,
+                                           pixelCount<Count>(count)};
+    runKernel(kernel);
+  }
+}
+
+static void backendStep(KernelStrip &s, KernelEffect effect, KernelBackend backend, uint32_t step)
+{
+  if (backend == BACKEND_RUNTIME) kernelStep<0>(s, effect, s.runtimeSink(), runtimeCount, step);
+  else if (backend == BACKEND_PACKED) kernelStep<NUMPIXELS>(s, effect, s.packedSink(), NUMPIXELS, step);
+  else kernelStep<NUMPIXELS>(s, effect, CrgbSink{s.out}, NUMPIXELS, step);
+}
+
+static void usage()
+{
+  fprintf(stderr, "usage: kernelBench [--seconds N]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  double seconds = 0.5;
+  for (int i = 1; i < argc; i++)
+  {
+    if (i + 1 >= argc) usage();
+    const char *arg = argv[i];
+    const char *value = argv[++i];
+    if (strcmp(arg, "--seconds") == 0) seconds = atof(value);
+    else usage();
+  }
+
+  printf("%u픽셀 (앞쪽 %d개 건너뜀), 커널/조합마다 %.1f초\n", NUMPIXELS, KERNEL_SKIP, seconds);
+  printf("%-10s %-8s %9s %9s %8s %5s\n", "effect", "backend", "steps", "ns/pixel", "speedup", "same");
+
+  static KernelStrip strips[BACKEND_COUNT];
+  bool pass = true;
+  for (int e = 0; e < KERNEL_EFFECTS; e++)
+  {
+    KernelEffect effect = (KernelEffect)e;
+
+    // 같은 시드에서 몇 단계: runtime과 packed는 바이트까지, crgb는 효과 상태가 같아야 함
+    for (int b = 0; b < BACKEND_COUNT; b++)
+    {
+      strips[b].init();
+      for (uint32_t step = 1; step <= 4; step++)
+      {
+        randomSeed(step);
+        backendStep(strips[b], effect, (KernelBackend)b, step);
+      }
+    }
+    bool same = memcmp(strips[BACKEND_RUNTIME].bytes, strips[BACKEND_PACKED].bytes, sizeof(strips[0].bytes)) == 0 &&
+                memcmp(strips[BACKEND_RUNTIME].a, strips[BACKEND_CRGB].a, sizeof(strips[0].a)) == 0;
+    pass = pass && same;
+
+    double baseNs = 0;
+    for (int b = 0; b < BACKEND_COUNT; b++)
+    {
+      KernelStrip &s = strips[b];
+      s.init();
+      uint64_t start = hostMonotonicUs();
+      uint64_t end = start + (uint64_t)(seconds * 1e6);
+      uint64_t now = start;
+      uint32_t steps = 0;
+      while (now < end)
+      {
+        for (int n = 0; n < 64; n++) backendStep(s, effect, (KernelBackend)b, ++steps);
+        now = hostMonotonicUs();
+      }
+      double ns = (now - start) * 1000.0 / ((double)steps * NUMPIXELS);
+      if (b == BACKEND_RUNTIME) baseNs = ns;
+      printf("%-10s %-8s %9u %9.2f %7.2fx %5s\n", effectNames[e], backendNames[b], steps, ns, baseNs / ns,
+             b == BACKEND_RUNTIME ? "" : same ? "yes" : "NO");
+    }
+  }
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+// 무드등 펌웨어를 리눅스에서 그대로 돌리는 데몬
+// src/main.cpp를 하나의 번역 단위로 포함하고 host/platform의 Arduino/ESP8266 대체 헤더로 빌드한다.
+// 웹 서버/UDP 제어는 실제 소켓을 쓰고, LED 출력은 FastLED 대체 객체에 쌓인다.
+// 프레임 간격은 기기의 Ticker 대신 timerfd(CLOCK_MONOTONIC)가 정하고, 프레임은 출력 대상(host/hostSinks.h)으로 나간다.
+//
+// 사용법: lightd [--http-port N] [--udp-port N] [--eeprom FILE] [--port-file FILE] [--quiet]
+//                [--spi PATH [--spi-hz N]] [--shm NAME] [--socket PATH] [--render-threads N]
+//   --http-port/--udp-port  기기 포트(80/4210) 대신 열 포트 (0이면 빈 포트)
+//   --eeprom                설정을 저장할 파일 (없으면 메모리에만)
+//   --port-file             부팅이 끝나면 실제로 열린 포트를 "http N\nudp N\n" 형식으로 씀 (시험/부하 발생기용)
+//   --quiet                 시리얼 로그 출력 안 함
+//   --spi                   APA102 프레임을 쓸 spidev 장치 (일반 파일이면 마지막 프레임을 덮어씀), --spi-hz 클럭
+//   --shm                   공유 메모리 프레임 버퍼 이름 (/dev/shm/NAME)
+//   --socket                미리보기 패킷을 보낼 UNIX 데이터그램 소켓 (scripts/frame_viewer.py --unix PATH)
+//   --render-threads        효과 단계의 청크를 이 수의 스레드로 나눠 계산 (host/renderPool.h, 기본 1 = 순차)
+// 경로를 준 대상은 처음부터 켜지고, /output?spi=0 처럼 끄고 켤 수 있다.
+
+#include "main.cpp"
+#include "renderPool.h"
+
+#include <signal.h>
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int)
+{
+  stopRequested = 1;
+}
+
+static void usage()
+{
+  fprintf(stderr,
+          "usage: lightd [--http-port N] [--udp-port N] [--eeprom FILE] [--port-file FILE] [--quiet]\n"
+          "              [--spi PATH [--spi-hz N]] [--shm NAME] [--socket PATH] [--render-threads N]\n");
+  exit(2);
+}
+
+static bool writePortFile(const char *path)
+{
+  FILE *file = fopen(path, "w");
+  if (file == nullptr) return false;
+  fprintf(file, "http %u\nudp %u\n", hostBoundPort(80), hostBoundPort(UDP_CONTROL_PORT));
+  return fclose(file) == 0;
+}
+
+int main(int argc, char **argv)
+{
+  const char *portFile = nullptr;
+  int renderThreads = 1;
+  for (int i = 1; i < argc; i++)
+  {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (strcmp(arg, "--quiet") == 0)
+    {
+      Serial.muted = true;
+      continue;
+    }
+    if (value == nullptr) usage();
+    i++;
+    if (strcmp(arg, "--http-port") == 0) hostMapPort(80, atoi(value));
+    else if (strcmp(arg, "--udp-port") == 0) hostMapPort(UDP_CONTROL_PORT, atoi(value));
+    else if (strcmp(arg, "--eeprom") == 0) EEPROM.path = value;
+    else if (strcmp(arg, "--port-file") == 0) portFile = value;
+    else if (strcmp(arg, "--spi") == 0) hostSinkConfig.spiPath = value;
+    else if (strcmp(arg, "--spi-hz") == 0) hostSinkConfig.spiHz = atoi(value);
+    else if (strcmp(arg, "--shm") == 0) hostSinkConfig.shmName = value;
+    else if (strcmp(arg, "--socket") == 0) hostSinkConfig.socketPath = value;
+    else if (strcmp(arg, "--render-threads") == 0) renderThreads = constrain(atoi(value), 1, RENDER_POOL_MAX_THREADS);
+    else usage();
+  }
+
+  sinkEnable(SINK_SPI, !hostSinkConfig.spiPath.empty());
+  sinkEnable(SINK_SHM, !hostSinkConfig.shmName.empty());
+  sinkEnable(SINK_SOCKET, !hostSinkConfig.socketPath.empty());
+  renderPoolStart(renderThreads);
+
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+  signal(SIGPIPE, SIG_IGN);
+
+  setup();
+  bool announced = false;
+  while (!stopRequested)
+  {
+    hostRunTimers();
+    loop();
+    if (!announced && bootDone() && portFile != nullptr)
+    {
+      if (!writePortFile(portFile)) fprintf(stderr, "포트 파일을 쓸 수 없음: %s\n", portFile);
+      announced = true;
+    }
+    // 기기 loop()처럼 계속 돌지 않고 다음 프레임 타이머나 소켓 이벤트까지 잠듦
+    // (요청 처리 중에는 응답을 나누어 보내야 하므로 짧게)
+    hostWaitEvents(server.activeClients() > 0 ? 1 : FRAME_PERIOD_MS);
+  }
+
+  // 조용해지기 전에 끝나면 미뤄 둔 저장을 마저 함
+  if (settingsSaveAt != 0) saveSettings();
+  renderPoolStop();
+  return 0;
+}
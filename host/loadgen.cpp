@@ -0,0 +1,251 @@
+// 웹 서버 부하 발생기
+// 화면을 열어 둔 사용자 여러 명을 흉내낸다.
+//   - 상태 조회(poller): 일정 간격으로 GET /status (웹 페이지의 주기적 갱신)
+//   - 조작(dragger): 색상 선택기/밝기 슬라이더를 끄는 것처럼 /setColor, /setBrightness, /params를 연속으로 보냄
+// 시작할 때 /metrics?reset=1로 서버 통계를 비우고, 끝나면 /metrics를 읽어
+// 클라이언트에서 잰 지연(p50/p99, 처리량)과 서버가 잰 처리 시간/힙 감소량을 엔드포인트별로 함께 보여준다.
+// --max-p99-ms를 주면 어느 엔드포인트든 클라이언트 p99가 그보다 길거나 실패한 요청이 있으면 종료 코드 1.
+//
+// 사용법: loadgen --port N [--host 127.0.0.1] [--seconds 10] [--pollers 2] [--draggers 2]
+//                 [--poll-ms 250] [--drag-ms 30] [--max-p99-ms N]
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <poll.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+#define REQUEST_TIMEOUT_MS 5000
+
+enum LoadEndpoint {
+  LOAD_STATUS = 0,
+  LOAD_SET_COLOR,
+  LOAD_SET_BRIGHTNESS,
+  LOAD_PARAMS,
+  LOAD_COUNT
+};
+
+// 서버 /metrics의 endpoints 항목 이름과 같음
+const char *const loadEndpointNames[LOAD_COUNT] = {"status", "setColor", "setBrightness", "params"};
+
+struct LoadOptions {
+  std::string host = "127.0.0.1";
+  int port = 0;
+  int seconds = 10;
+  int pollers = 2;
+  int draggers = 2;
+  int pollMs = 250;
+  int dragMs = 30;
+  double maxP99Ms = 0;  // 0이면 검사 안 함
+};
+
+// 엔드포인트별 클라이언트 측정값
+struct LoadSamples {
+  std::mutex lock;
+  std::vector<uint32_t> latencyUs[LOAD_COUNT];
+  uint32_t failures[LOAD_COUNT] = {};
+};
+
+// 요청 하나 보내고 연결이 닫힐 때까지 응답을 읽음 (서버는 Connection: close)
+// 성공하면 상태 코드, 연결/시간 초과 실패면 -1
+int httpGet(const LoadOptions &options, const std::string &path, std::string *body)
+{
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+  int on = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+  struct timeval timeout = {REQUEST_TIMEOUT_MS / 1000, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(options.port);
+  inet_pton(AF_INET, options.host.c_str(), &addr.sin_addr);
+  if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+  {
+    close(fd);
+    return -1;
+  }
+
+  std::string request = "GET " + path + " HTTP/1.1\r\nHost: " + options.host + "\r\nConnection: close\r\n\r\n";
+  if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) != (ssize_t)request.size())
+  {
+    close(fd);
+    return -1;
+  }
+
+  std::string response;
+  char buffer[2048];
+  ssize_t n;
+  while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) response.append(buffer, n);
+  close(fd);
+  if (n < 0 || response.compare(0, 9, "HTTP/1.1 ") != 0) return -1;
+
+  if (body != nullptr)
+  {
+    size_t start = response.find("\r\n\r\n");
+    *body = start == std::string::npos ? std::string() : response.substr(start + 4);
+  }
+  return atoi(response.c_str() + 9);
+}
+
+void timedGet(const LoadOptions &options, LoadSamples &samples, LoadEndpoint ep, const std::string &path)
+{
+  Clock::time_point start = Clock::now();
+  int status = httpGet(options, path, nullptr);
+  uint32_t us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+  std::lock_guard<std::mutex> guard(samples.lock);
+  if (status == 200) samples.latencyUs[ep].push_back(us);
+  else samples.failures[ep]++;
+}
+
+void pollerThread(const LoadOptions &options, LoadSamples &samples, Clock::time_point end)
+{
+  while (Clock::now() < end)
+  {
+    Clock::time_point next = Clock::now() + std::chrono::milliseconds(options.pollMs);
+    timedGet(options, samples, LOAD_STATUS, "/status");
+    std::this_thread::sleep_until(next);
+  }
+}
+
+// 슬라이더를 끄는 사용자: 값이 조금씩 바뀌는 요청을 쉬지 않고 보냄
+void draggerThread(const LoadOptions &options, LoadSamples &samples, Clock::time_point end, unsigned seed)
+{
+  char path[96];
+  unsigned step = seed * 37;
+  while (Clock::now() < end)
+  {
+    Clock::time_point next = Clock::now() + std::chrono::milliseconds(options.dragMs);
+    step++;
+    switch (step % 3)
+    {
+      case 0:
+        snprintf(path, sizeof(path), "/setColor?r=%u&g=%u&b=%u", step % 256, (step * 3) % 256, (step * 7) % 256);
+        timedGet(options, samples, LOAD_SET_COLOR, path);
+        break;
+      case 1:
+        snprintf(path, sizeof(path), "/setBrightness?value=%u", 10 + step % 200);
+        timedGet(options, samples, LOAD_SET_BRIGHTNESS, path);
+        break;
+      default:
+        timedGet(options, samples, LOAD_PARAMS, "/params");
+        break;
+    }
+    std::this_thread::sleep_until(next);
+  }
+}
+
+double percentileMs(std::vector<uint32_t> &values, int percent)
+{
+  if (values.empty()) return 0;
+  std::sort(values.begin(), values.end());
+  size_t index = (values.size() * percent + 99) / 100;
+  if (index > 0) index--;
+  return values[std::min(index, values.size() - 1)] / 1000.0;
+}
+
+// /metrics 응답에서 "endpoints" 안의 엔드포인트 객체 필드 하나를 꺼냄 (없으면 -1)
+long metricsField(const std::string &json, const char *endpoint, const char *field)
+{
+  size_t endpoints = json.find("\"endpoints\"");
+  if (endpoints == std::string::npos) return -1;
+  size_t object = json.find("\"" + std::string(endpoint) + "\":{", endpoints);
+  if (object == std::string::npos) return -1;
+  size_t close = json.find('}', object);
+  size_t at = json.find("\"" + std::string(field) + "\":", object);
+  if (at == std::string::npos || at > close) return -1;
+  return atol(json.c_str() + at + strlen(field) + 3);
+}
+
+void usage()
+{
+  fprintf(stderr,
+          "usage: loadgen --port N [--host ADDR] [--seconds N] [--pollers N] [--draggers N]\n"
+          "               [--poll-ms N] [--drag-ms N] [--max-p99-ms N]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  LoadOptions options;
+  for (int i = 1; i < argc; i++)
+  {
+    if (i + 1 >= argc) usage();
+    const char *arg = argv[i];
+    const char *value = argv[++i];
+    if (strcmp(arg, "--host") == 0) options.host = value;
+    else if (strcmp(arg, "--port") == 0) options.port = atoi(value);
+    else if (strcmp(arg, "--seconds") == 0) options.seconds = atoi(value);
+    else if (strcmp(arg, "--pollers") == 0) options.pollers = atoi(value);
+    else if (strcmp(arg, "--draggers") == 0) options.draggers = atoi(value);
+    else if (strcmp(arg, "--poll-ms") == 0) options.pollMs = atoi(value);
+    else if (strcmp(arg, "--drag-ms") == 0) options.dragMs = atoi(value);
+    else if (strcmp(arg, "--max-p99-ms") == 0) options.maxP99Ms = atof(value);
+    else usage();
+  }
+  if (options.port <= 0 || options.seconds <= 0) usage();
+
+  if (httpGet(options, "/metrics?reset=1", nullptr) != 200)
+  {
+    fprintf(stderr, "%s:%d 에 연결할 수 없음\n", options.host.c_str(), options.port);
+    return 1;
+  }
+
+  LoadSamples samples;
+  Clock::time_point end = Clock::now() + std::chrono::seconds(options.seconds);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < options.pollers; i++) threads.emplace_back(pollerThread, std::cref(options), std::ref(samples), end);
+  for (int i = 0; i < options.draggers; i++) threads.emplace_back(draggerThread, std::cref(options), std::ref(samples), end, i + 1);
+  for (std::thread &t : threads) t.join();
+
+  std::string metrics;
+  if (httpGet(options, "/metrics", &metrics) != 200)
+  {
+    fprintf(stderr, "/metrics 를 읽을 수 없음\n");
+    return 1;
+  }
+
+  printf("%d초, 조회 %d명 (%dms 간격), 조작 %d명 (%dms 간격)\n",
+         options.seconds, options.pollers, options.pollMs, options.draggers, options.dragMs);
+  printf("%-14s %7s %6s %8s %8s %8s | %8s %8s %10s %10s\n",
+         "endpoint", "ok", "fail", "req/s", "p50ms", "p99ms", "srv p50", "srv p99", "heapDrop", "heapMax");
+
+  bool pass = true;
+  for (int ep = 0; ep < LOAD_COUNT; ep++)
+  {
+    std::vector<uint32_t> &values = samples.latencyUs[ep];
+    double p50 = percentileMs(values, 50);
+    double p99 = percentileMs(values, 99);
+    const char *name = loadEndpointNames[ep];
+    printf("%-14s %7zu %6u %8.1f %8.2f %8.2f | %6ldus %6ldus %10ld %10ld\n",
+           name, values.size(), samples.failures[ep], values.size() / (double)options.seconds, p50, p99,
+           metricsField(metrics, name, "p50Us"), metricsField(metrics, name, "p99Us"),
+           metricsField(metrics, name, "heapDropSum"), metricsField(metrics, name, "heapDropMax"));
+
+    if (options.maxP99Ms > 0 && (p99 > options.maxP99Ms || samples.failures[ep] > 0)) pass = false;
+  }
+
+  if (options.maxP99Ms > 0)
+  {
+    printf("p99 <= %.1fms, 실패 0: %s\n", options.maxP99Ms, pass ? "통과" : "실패");
+  }
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+// 호스트 빌드용 Adafruit_NeoPixel (AVR 펌웨어 src/legacy/main.cpp 시험용)
+// 픽셀 버퍼와 밝기 계산은 라이브러리와 같게 둔다: 버퍼는 전송 순서 바이트, setPixelColor()는
+// 색 순서 자리(rOffset/gOffset/bOffset)에 밝기를 곱해 쓰고, setBrightness()는 이미 쓴 값을 다시 비율로 바꾼다.
+// show()는 출력 대신 호출 수만 센다.
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef uint16_t neoPixelType;
+
+// 색 순서: 비트 7-6 W, 5-4 R, 3-2 G, 1-0 B 자리 (RGB 스트립은 W 자리가 R과 같음)
+#define NEO_RGB ((0 << 6) | (0 << 4) | (1 << 2) | (2))
+#define NEO_RBG ((0 << 6) | (0 << 4) | (2 << 2) | (1))
+#define NEO_GRB ((1 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_GBR ((2 << 6) | (2 << 4) | (0 << 2) | (1))
+#define NEO_BRG ((1 << 6) | (1 << 4) | (2 << 2) | (0))
+#define NEO_BGR ((2 << 6) | (2 << 4) | (1 << 2) | (0))
+#define NEO_KHZ800 0x0000
+
+class Adafruit_NeoPixel
+{
+public:
+  Adafruit_NeoPixel(uint16_t n, int16_t, neoPixelType type)
+      : numLEDs(n), rOffset((type >> 4) & 3), gOffset((type >> 2) & 3), bOffset(type & 3),
+        pixels((uint8_t *)calloc(n, 3))
+  {
+  }
+  ~Adafruit_NeoPixel() { free(pixels); }
+
+  void begin() {}
+  void show() { shows++; }
+  void clear() { memset(pixels, 0, numLEDs * 3); }
+
+  void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b)
+  {
+    if (n >= numLEDs) return;
+    if (brightness)
+    {
+      r = (r * brightness) >> 8;
+      g = (g * brightness) >> 8;
+      b = (b * brightness) >> 8;
+    }
+    uint8_t *p = &pixels[n * 3];
+    p[rOffset] = r;
+    p[gOffset] = g;
+    p[bOffset] = b;
+  }
+
+  void setPixelColor(uint16_t n, uint32_t c) { setPixelColor(n, (uint8_t)(c >> 16), (uint8_t)(c >> 8), (uint8_t)c); }
+
+  static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) { return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b; }
+
+  // 라이브러리처럼 내부에는 b + 1을 두고 (255면 0 = 그대로), 이미 쓴 값을 새 밝기로 다시 계산
+  void setBrightness(uint8_t b)
+  {
+    uint8_t newBrightness = b + 1;
+    if (newBrightness == brightness) return;
+    uint8_t oldBrightness = brightness - 1;
+    uint16_t scale;
+    if (oldBrightness == 0) scale = 0;
+    else if (b == 255) scale = 65535 / oldBrightness;
+    else scale = (((uint16_t)newBrightness << 8) - 1) / oldBrightness;
+    for (uint16_t i = 0; i < numLEDs * 3; i++) pixels[i] = (pixels[i] * scale) >> 8;
+    brightness = newBrightness;
+  }
+
+  uint8_t getBrightness() const { return brightness - 1; }
+  uint8_t *getPixels() const { return pixels; }
+  uint16_t numPixels() const { return numLEDs; }
+
+  uint32_t shows = 0;  // 호스트 전용: show() 호출 수
+
+private:
+  uint16_t numLEDs;
+  uint8_t brightness = 0;
+  uint8_t rOffset, gOffset, bOffset;
+  uint8_t *pixels;
+};
@@ -0,0 +1,31 @@
+// 호스트 빌드용 SSD1306 OLED (화면이 없으므로 그리기 호출은 버림)
+
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define SSD1306_SWITCHCAPVCC 0x02
+#define WHITE 1
+#define BLACK 0
+
+class Adafruit_SSD1306 : public Print
+{
+public:
+  Adafruit_SSD1306(int16_t, int16_t, TwoWire *, int8_t) {}
+
+  bool begin(uint8_t, uint8_t) { return true; }
+  void display() { updates++; }
+  void clearDisplay() {}
+  void fillScreen(uint16_t) {}
+  void setTextSize(uint8_t) {}
+  void setTextColor(uint16_t) {}
+  void setCursor(int16_t, int16_t) {}
+  void cp437(bool) {}
+  void startscrollleft(uint8_t, uint8_t) {}
+  void stopscroll() {}
+  size_t write(uint8_t) override { return 1; }
+  using Print::write;
+
+  uint32_t updates = 0;  // 호스트 전용: display() 호출 수
+};
@@ -0,0 +1,301 @@
+// 호스트(Linux) 빌드용 Arduino 코어
+// src/ 펌웨어가 쓰는 만큼만 구현한다 (헤더만으로 동작, 전역 객체는 inline 변수).
+//   - millis()/micros(): CLOCK_MONOTONIC 기준, hostClockAdvance()로 앞당기고 hostClockFreeze()로 멈출 수 있음 (시험/벤치마크)
+//   - random()/randomSeed(): newlib rand()와 같은 64비트 LCG라서 같은 시드면 기기와 같은 난수열.
+//     상태는 스레드마다 따로 있으므로 병렬 렌더러의 스레드들이 서로의 난수열을 건드리지 않는다.
+//   - GPIO: hostGpioInput 비트가 GPI 레지스터 값 (시험에서 핀 상태를 직접 씀)
+//   - ESP.getFreeHeap(): 가상의 큰 힙에서 malloc 사용량을 뺀 값 (요청 전후 차이로 힙 변화 측정)
+//   - delay()/yield(): 기기처럼 그 사이에 Ticker 콜백을 실행 (Ticker.h)
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <malloc.h>
+#include <algorithm>
+#include <string>
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define RISING 1
+#define FALLING 2
+#define CHANGE 3
+
+#define F_CPU 80000000L
+
+// 플래시/IRAM 배치 지시자는 호스트에서 의미 없음
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define snprintf_P snprintf
+#define vsnprintf_P vsnprintf
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define digitalPinToInterrupt(p) (p)
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+#define FPSTR(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+
+// --- 시계 ---
+
+inline int64_t hostClockOffsetUs = 0;  // hostClockAdvance()로 더한 시간
+inline bool hostClockFrozen = false;   // hostClockFreeze(true) 동안은 실제 시간이 흐르지 않음
+inline uint64_t hostFrozenAtUs = 0;
+
+inline uint64_t hostMonotonicUs()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+inline const uint64_t hostStartUs = hostMonotonicUs();
+
+inline unsigned long micros()
+{
+  uint64_t now = hostClockFrozen ? hostFrozenAtUs : hostMonotonicUs();
+  return (unsigned long)(now - hostStartUs + hostClockOffsetUs);
+}
+
+inline unsigned long millis()
+{
+  return micros() / 1000;
+}
+
+// 애니메이션 시계를 실제로 기다리지 않고 앞당김 (벤치마크/시험)
+inline void hostClockAdvance(uint32_t us)
+{
+  hostClockOffsetUs += us;
+}
+
+// 시계를 멈춤/다시 흐르게 함: 멈춘 동안에는 hostClockAdvance()로만 움직여 시간 계산을 정확히 검사할 수 있음
+inline void hostClockFreeze(bool on)
+{
+  if (on == hostClockFrozen) return;
+  if (on) hostFrozenAtUs = hostMonotonicUs();
+  else hostClockOffsetUs -= (int64_t)(hostMonotonicUs() - hostFrozenAtUs);
+  hostClockFrozen = on;
+}
+
+// delay()/yield() 중에 실행할 타이머 콜백 (Ticker.h가 설정, Ticker를 쓰지 않는 시험에서는 없음)
+inline void (*hostTimerHook)() = nullptr;
+
+inline void yield()
+{
+  if (hostTimerHook) hostTimerHook();
+}
+
+inline void delayMicroseconds(unsigned int us)
+{
+  struct timespec ts = {(time_t)(us / 1000000), (long)(us % 1000000) * 1000};
+  nanosleep(&ts, nullptr);
+}
+
+inline void delay(unsigned long ms)
+{
+  delayMicroseconds(ms * 1000);
+  yield();
+}
+
+// --- 난수 (newlib rand()와 같은 계산, 스레드별 상태) ---
+
+inline thread_local uint64_t hostRandState = 1;
+
+inline void randomSeed(unsigned long seed)
+{
+  if (seed != 0) hostRandState = seed;
+}
+
+inline long random(long howbig)
+{
+  if (howbig == 0) return 0;
+  hostRandState = hostRandState * 6364136223846793005ULL + 1;
+  return (long)((hostRandState >> 32) & 0x7FFFFFFF) % howbig;
+}
+
+inline long random(long howsmall, long howbig)
+{
+  if (howsmall >= howbig) return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+// --- GPIO ---
+
+inline volatile uint32_t hostGpioInput = 0xFFFFFFFF;  // 풀업 입력은 기본 HIGH
+#define GPI hostGpioInput
+
+inline void (*hostInterruptHandlers[17])() = {};
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t pin) { return (hostGpioInput >> pin) & 1; }
+inline void digitalWrite(uint8_t, uint8_t) {}
+
+inline void attachInterrupt(uint8_t pin, void (*handler)(), int)
+{
+  if (pin < 17) hostInterruptHandlers[pin] = handler;
+}
+
+// --- String (펌웨어는 버전/MAC 표시에만 씀) ---
+
+class String
+{
+public:
+  String(const char *s = "") : text(s ? s : "") {}
+  String(const std::string &s) : text(s) {}
+  String(const __FlashStringHelper *s) : text(reinterpret_cast<const char *>(s)) {}
+  String(int v) : text(std::to_string(v)) {}
+  String(unsigned int v) : text(std::to_string(v)) {}
+  String(long v) : text(std::to_string(v)) {}
+  String(unsigned long v) : text(std::to_string(v)) {}
+
+  const char *c_str() const { return text.c_str(); }
+  unsigned int length() const { return text.size(); }
+  long toInt() const { return atol(text.c_str()); }
+
+  String substring(unsigned int from) const { return from < text.size() ? String(text.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const
+  {
+    return from < to && from < text.size() ? String(text.substr(from, to - from)) : String();
+  }
+
+  String &operator+=(const String &s) { text += s.text; return *this; }
+  String &operator+=(const char *s) { text += s; return *this; }
+  friend String operator+(const String &a, const String &b) { return String(a.text + b.text); }
+  bool operator==(const char *s) const { return text == s; }
+  bool operator==(const String &s) const { return text == s.text; }
+
+private:
+  std::string text;
+};
+
+// --- Print/Stream ---
+
+class Print;
+
+class Printable
+{
+public:
+  virtual ~Printable() {}
+  virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print
+{
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size)
+  {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+  }
+  size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+  size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+  virtual int availableForWrite() { return 0; }
+  virtual void flush() {}
+
+  size_t print(const char *s) { return write(s); }
+  size_t print(const __FlashStringHelper *s) { return write(reinterpret_cast<const char *>(s)); }
+  size_t print(const String &s) { return write(s.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v) { return print((long)v); }
+  size_t print(unsigned int v) { return print((unsigned long)v); }
+  size_t print(long v) { return printf("%ld", v); }
+  size_t print(unsigned long v) { return printf("%lu", v); }
+  size_t print(double v) { return printf("%.2f", v); }
+  size_t print(const Printable &p) { return p.printTo(*this); }
+
+  template <typename T>
+  size_t println(const T &v) { return print(v) + println(); }
+  size_t println() { return write("\r\n"); }
+
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)))
+  {
+    char line[256];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (n < 0) return 0;
+    return write((const uint8_t *)line, min((size_t)n, sizeof(line) - 1));
+  }
+};
+
+class Stream : public Print
+{
+public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  virtual int peek() { return -1; }
+};
+
+// 표준 출력으로 보내는 시리얼 (hostSerialMute로 끌 수 있음, 시험에서 로그를 숨길 때)
+class HardwareSerial : public Stream
+{
+public:
+  bool muted = false;
+
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buffer, size_t size) override
+  {
+    if (muted) return size;
+    ssize_t n = ::write(STDOUT_FILENO, buffer, size);
+    return n > 0 ? n : 0;
+  }
+  using Print::write;
+  int availableForWrite() override { return 128; }  // UART 송신 FIFO 크기
+};
+
+inline HardwareSerial Serial;
+
+// --- ESP ---
+
+class EspClass
+{
+public:
+  // 가상의 1GB 힙에서 현재 malloc 사용량을 뺀 값 (절대값이 아니라 요청 전후 차이를 보는 용도)
+  uint32_t getFreeHeap()
+  {
+    struct mallinfo2 info = mallinfo2();
+    size_t used = info.uordblks + info.hblkhd;
+    return used < HEAP_SIZE ? HEAP_SIZE - used : 0;
+  }
+  uint32_t getMaxFreeBlockSize() { return getFreeHeap(); }
+  uint8_t getHeapFragmentation() { return 0; }
+  uint32_t getCycleCount() { return (uint32_t)(micros() * (F_CPU / 1000000)); }
+  uint32_t getChipId() { return (uint32_t)gethostid() & 0xFFFFFF; }
+
+private:
+  static const size_t HEAP_SIZE = 1UL << 30;
+};
+
+inline EspClass ESP;
@@ -0,0 +1,82 @@
+// 호스트 빌드용 EEPROM
+// 기기처럼 begin()에서 RAM 사본을 만들고 commit()에서만 저장한다. 지운 플래시처럼 처음 값은 0xFF.
+// hostEepromPath를 정하면 begin()에서 그 파일을 읽고 commit()마다 파일에 쓴다 (데몬 재시작 후에도 설정 유지).
+
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+
+class EEPROMClass
+{
+public:
+  void begin(size_t size)
+  {
+    data.assign(size, 0xFF);
+    if (path.empty()) return;
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == nullptr) return;
+    size_t n = fread(data.data(), 1, size, file);
+    (void)n;
+    fclose(file);
+  }
+
+  uint8_t read(int address) const
+  {
+    return address >= 0 && (size_t)address < data.size() ? data[address] : 0;
+  }
+
+  void write(int address, uint8_t value)
+  {
+    if (address < 0 || (size_t)address >= data.size() || data[address] == value) return;
+    data[address] = value;
+    dirty = true;
+  }
+
+  template <typename T>
+  T &get(int address, T &t) const
+  {
+    if (address >= 0 && address + sizeof(T) <= data.size()) memcpy((void *)&t, data.data() + address, sizeof(T));
+    else memset((void *)&t, 0xFF, sizeof(T));  // 범위 밖은 지운 플래시처럼
+    return t;
+  }
+
+  template <typename T>
+  const T &put(int address, const T &t)
+  {
+    const uint8_t *bytes = (const uint8_t *)&t;
+    for (size_t i = 0; i < sizeof(T); i++) write(address + i, bytes[i]);
+    return t;
+  }
+
+  // 바뀐 내용이 있을 때만 저장 (기기와 같음)
+  bool commit()
+  {
+    if (!dirty) return true;
+    dirty = false;
+    commits++;
+    if (path.empty()) return true;
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr) return false;
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    return fclose(file) == 0 && ok;
+  }
+
+  uint8_t *getDataPtr()
+  {
+    dirty = true;
+    return data.data();
+  }
+
+  size_t length() const { return data.size(); }
+
+  // 호스트 전용
+  std::string path;      // 저장 파일 (비어 있으면 메모리에만)
+  uint32_t commits = 0;  // 실제로 쓴 횟수
+
+private:
+  std::vector<uint8_t> data;
+  bool dirty = false;
+};
+
+inline EEPROMClass EEPROM;
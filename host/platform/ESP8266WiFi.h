@@ -0,0 +1,310 @@
+// 호스트 빌드용 ESP8266WiFi
+// WiFiServer/WiFiClient는 논블로킹 TCP 소켓이다. 기기와 같이 read/write는 기다리지 않고
+// 지금 되는 만큼만 처리하며, availableForWrite()는 소켓 송신 버퍼의 남은 크기를 돌려준다.
+// WiFi 객체는 모드/절전 설정을 기억만 한다. STA는 begin()을 부르면 연결된 것으로 본다.
+
+#pragma once
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include "hostIo.h"
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <linux/sockios.h>
+#include <memory>
+
+enum WiFiMode_t {
+  WIFI_OFF = 0,
+  WIFI_STA = 1,
+  WIFI_AP = 2,
+  WIFI_AP_STA = 3
+};
+
+enum wl_status_t {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_DISCONNECTED = 6
+};
+
+enum WiFiSleepType_t {
+  WIFI_NONE_SLEEP = 0,
+  WIFI_LIGHT_SLEEP = 1,
+  WIFI_MODEM_SLEEP = 2
+};
+
+class ESP8266WiFiClass
+{
+public:
+  bool mode(WiFiMode_t m)
+  {
+    wifiMode = m;
+    if (!(m & WIFI_STA)) staStatus = WL_DISCONNECTED;
+    return true;
+  }
+  WiFiMode_t getMode() const { return wifiMode; }
+
+  bool softAP(const char *, const char *) { return true; }
+  IPAddress softAPIP() const { return IPAddress(127, 0, 0, 1); }
+  IPAddress localIP() const { return IPAddress(127, 0, 0, 1); }
+
+  void begin(const char *, const char *) { staStatus = WL_CONNECTED; }
+
+  // 이름으로 주소 찾기 (기기와 같이 timeout까지 기다리는 호출)
+  int hostByName(const char *name, IPAddress &result, uint32_t)
+  {
+    struct addrinfo hints = {}, *found = nullptr;
+    hints.ai_family = AF_INET;
+    if (getaddrinfo(name, nullptr, &hints, &found) != 0 || found == nullptr) return 0;
+    result = IPAddress(((struct sockaddr_in *)found->ai_addr)->sin_addr.s_addr);
+    freeaddrinfo(found);
+    return 1;
+  }
+  wl_status_t status() const { return staStatus; }
+
+  bool setSleepMode(WiFiSleepType_t type)
+  {
+    sleepType = type;
+    sleepChanges++;
+    return true;
+  }
+  WiFiSleepType_t getSleepMode() const { return sleepType; }
+
+  String macAddress() const
+  {
+    uint32_t id = ESP.getChipId();
+    char text[18];
+    snprintf(text, sizeof(text), "02:00:00:%02X:%02X:%02X", (id >> 16) & 0xFF, (id >> 8) & 0xFF, id & 0xFF);
+    return String(text);
+  }
+
+  // 호스트 전용: 시험에서 바꾸거나 확인하는 값
+  WiFiMode_t wifiMode = WIFI_OFF;
+  wl_status_t staStatus = WL_DISCONNECTED;
+  WiFiSleepType_t sleepType = WIFI_MODEM_SLEEP;  // SDK 기본값
+  uint32_t sleepChanges = 0;
+};
+
+inline ESP8266WiFiClass WiFi;
+
+// 연결 하나 (WiFiClient 복사본끼리 공유, 마지막 복사본이 없어질 때 닫힘)
+struct HostTcpSocket {
+  int fd;
+  explicit HostTcpSocket(int f) : fd(f) { hostWatch(fd); }
+  ~HostTcpSocket() { close(); }
+  void close()
+  {
+    if (fd < 0) return;
+    hostUnwatch(fd);
+    ::close(fd);
+    fd = -1;
+  }
+};
+
+class WiFiClient : public Stream
+{
+public:
+  WiFiClient() {}
+  explicit WiFiClient(int fd) : socket(std::make_shared<HostTcpSocket>(fd)) {}
+
+  // 기기와 같이 timeout(ms)까지만 기다리는 연결 (setTimeout, 기본 5초)
+  int connect(IPAddress ip, uint16_t port)
+  {
+    stop();
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0) return 0;
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = (uint32_t)ip;
+    if (::connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 && errno != EINPROGRESS)
+    {
+      ::close(fd);
+      return 0;
+    }
+    struct pollfd p = {fd, POLLOUT, 0};
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (poll(&p, 1, timeoutMs) != 1 || getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) < 0 || error != 0)
+    {
+      ::close(fd);
+      return 0;
+    }
+    socket = std::make_shared<HostTcpSocket>(fd);
+    setNoDelay(noDelay);
+    return 1;
+  }
+
+  int connect(const char *host, uint16_t port)
+  {
+    IPAddress ip;
+    return ip.fromString(host) ? connect(ip, port) : 0;
+  }
+
+  void setTimeout(unsigned long ms) { timeoutMs = ms; }
+
+  int available() override
+  {
+    int n = 0;
+    if (!open() || ioctl(socket->fd, FIONREAD, &n) < 0) return 0;
+    return n;
+  }
+
+  int read() override
+  {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+  }
+
+  int read(uint8_t *buffer, size_t size)
+  {
+    if (!open()) return 0;
+    ssize_t n = recv(socket->fd, buffer, size, MSG_DONTWAIT);
+    return n > 0 ? n : 0;
+  }
+
+  int peek() override
+  {
+    uint8_t c;
+    if (!open() || recv(socket->fd, &c, 1, MSG_DONTWAIT | MSG_PEEK) != 1) return -1;
+    return c;
+  }
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buffer, size_t size) override
+  {
+    if (!open()) return 0;
+    ssize_t n = send(socket->fd, buffer, size, MSG_DONTWAIT | MSG_NOSIGNAL);
+    return n > 0 ? n : 0;
+  }
+  using Print::write;
+
+  // 송신 버퍼에 남은 크기
+  int availableForWrite() override
+  {
+    if (!open()) return 0;
+    int capacity = 0, queued = 0;
+    socklen_t length = sizeof(capacity);
+    if (getsockopt(socket->fd, SOL_SOCKET, SO_SNDBUF, &capacity, &length) < 0) return 0;
+    if (ioctl(socket->fd, SIOCOUTQ, &queued) < 0) return 0;
+    return capacity > queued ? capacity - queued : 0;
+  }
+
+  // 읽을 데이터가 남아 있거나 상대가 아직 닫지 않았으면 연결된 것으로 봄
+  uint8_t connected()
+  {
+    if (!open()) return 0;
+    if (available() > 0) return 1;
+    uint8_t c;
+    ssize_t n = recv(socket->fd, &c, 1, MSG_DONTWAIT | MSG_PEEK);
+    return n > 0 || (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+  }
+
+  // 호스트 소켓은 close()가 기다리지 않으므로 maxWaitMs와 관계없이 바로 닫음
+  bool stop(unsigned int) { stop(); return true; }
+  void stop()
+  {
+    if (socket) socket->close();
+    socket.reset();
+  }
+
+  // 송신 대기 데이터를 버리고 RST로 바로 끊음
+  void abort()
+  {
+    if (!open()) return;
+    struct linger hard = {1, 0};
+    setsockopt(socket->fd, SOL_SOCKET, SO_LINGER, &hard, sizeof(hard));
+    stop();
+  }
+
+  void setNoDelay(bool on)
+  {
+    noDelay = on;
+    int flag = on;
+    if (open()) setsockopt(socket->fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+  }
+
+  IPAddress remoteIP() const
+  {
+    struct sockaddr_in addr = {};
+    socklen_t length = sizeof(addr);
+    if (!socket || getpeername(socket->fd, (struct sockaddr *)&addr, &length) < 0) return IPAddress();
+    return IPAddress(addr.sin_addr.s_addr);
+  }
+
+  explicit operator bool() const { return socket && socket->fd >= 0; }
+
+private:
+  std::shared_ptr<HostTcpSocket> socket;
+  unsigned long timeoutMs = 5000;
+  bool noDelay = false;
+
+  bool open() const { return socket && socket->fd >= 0; }
+};
+
+class WiFiServer
+{
+public:
+  WiFiServer(uint16_t p) : port(p) {}
+  ~WiFiServer()
+  {
+    if (pending >= 0) ::close(pending);
+    if (fd >= 0)
+    {
+      hostUnwatch(fd);
+      ::close(fd);
+    }
+  }
+
+  void begin()
+  {
+    fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0) return;
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(hostPortFor(port));
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, 16) < 0)
+    {
+      fprintf(stderr, "TCP %u 포트를 열 수 없음: %s\n", hostPortFor(port), strerror(errno));
+      ::close(fd);
+      fd = -1;
+      return;
+    }
+    socklen_t length = sizeof(addr);
+    getsockname(fd, (struct sockaddr *)&addr, &length);
+    hostNoteBound(port, ntohs(addr.sin_port));
+    hostWatch(fd);
+  }
+
+  void setNoDelay(bool on) { noDelay = on; }
+
+  bool hasClient()
+  {
+    if (pending < 0 && fd >= 0) pending = accept4(fd, nullptr, nullptr, SOCK_NONBLOCK);
+    return pending >= 0;
+  }
+
+  WiFiClient accept()
+  {
+    if (!hasClient()) return WiFiClient();
+    WiFiClient client(pending);
+    pending = -1;
+    client.setNoDelay(noDelay);
+    return client;
+  }
+
+  WiFiClient available() { return accept(); }
+
+private:
+  uint16_t port;
+  int fd = -1;
+  int pending = -1;
+  bool noDelay = false;
+};
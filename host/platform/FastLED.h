@@ -0,0 +1,395 @@
+// 호스트 빌드용 FastLED
+// 펌웨어가 쓰는 부분만 FastLED 3.6의 계산 그대로 옮겼다 (scale8/qadd8/blend8, 팔레트 보간,
+// 그래디언트 팔레트 펼치기, 팔레트 전환, beatsin16). 효과 결과가 기기와 같은 값이 되도록 하기 위함이다.
+// show()는 LED를 구동하지 않고 횟수만 센다. 실제 출력은 출력 대상(src/outputSink.h, host/hostSinks.h)이 한다.
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef uint8_t fract8;
+typedef uint16_t accum88;
+
+// --- 8/16비트 연산 (FASTLED_SCALE8_FIXED = 1) ---
+
+inline uint8_t scale8(uint8_t i, fract8 scale)
+{
+  return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8;
+}
+
+inline uint8_t scale8_video(uint8_t i, fract8 scale)
+{
+  return (((int)i * (int)scale) >> 8) + ((i && scale) ? 1 : 0);
+}
+
+inline uint16_t scale16(uint16_t i, uint16_t scale)
+{
+  return ((uint32_t)i * (1 + (uint32_t)scale)) >> 16;
+}
+
+inline uint8_t qadd8(uint8_t i, uint8_t j)
+{
+  unsigned int t = i + j;
+  return t > 255 ? 255 : t;
+}
+
+inline uint8_t qsub8(uint8_t i, uint8_t j)
+{
+  int t = i - j;
+  return t < 0 ? 0 : t;
+}
+
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amountOfB)
+{
+  uint16_t partial = (a << 8) | b;
+  partial += b * amountOfB;
+  partial -= a * amountOfB;
+  return partial >> 8;
+}
+
+inline int16_t sin16(uint16_t theta)
+{
+  static const uint16_t base[] = {0, 6393, 12539, 18204, 23170, 27245, 30273, 32137};
+  static const uint8_t slope[] = {49, 48, 44, 38, 31, 23, 14, 4};
+
+  uint16_t offset = (theta & 0x3FFF) >> 3;
+  if (theta & 0x4000) offset = 2047 - offset;
+  uint8_t section = offset / 256;
+  uint16_t b = base[section];
+  uint8_t m = slope[section];
+  uint8_t secoffset8 = (uint8_t)offset / 2;
+  int16_t y = m * secoffset8 + b;
+  if (theta & 0x8000) y = -y;
+  return y;
+}
+
+inline uint16_t beat88(accum88 beatsPerMinute88, uint32_t timebase = 0)
+{
+  return ((millis() - timebase) * beatsPerMinute88 * 280) >> 16;
+}
+
+inline uint16_t beat16(accum88 beatsPerMinute, uint32_t timebase = 0)
+{
+  if (beatsPerMinute < 256) beatsPerMinute <<= 8;
+  return beat88(beatsPerMinute, timebase);
+}
+
+inline uint16_t beatsin16(accum88 beatsPerMinute, uint16_t lowest = 0, uint16_t highest = 65535,
+                          uint32_t timebase = 0, uint16_t phaseOffset = 0)
+{
+  uint16_t beat = beat16(beatsPerMinute, timebase);
+  uint16_t beatsin = sin16(beat + phaseOffset) + 32768;
+  return lowest + scale16(beatsin, highest - lowest);
+}
+
+// --- 색 ---
+
+struct CRGB
+{
+  union {
+    struct {
+      uint8_t r, g, b;
+    };
+    uint8_t raw[3];
+  };
+
+  enum HTMLColorCode {
+    Aqua = 0x00FFFF, Aquamarine = 0x7FFFD4, Black = 0x000000, Blue = 0x0000FF, CadetBlue = 0x5F9EA0,
+    CornflowerBlue = 0x6495ED, DarkBlue = 0x00008B, DarkCyan = 0x008B8B, DarkGreen = 0x006400,
+    DarkOliveGreen = 0x556B2F, DarkRed = 0x8B0000, ForestGreen = 0x228B22, Green = 0x008000,
+    LawnGreen = 0x7CFC00, LightBlue = 0xADD8E6, LightGreen = 0x90EE90, LightSkyBlue = 0x87CEFA,
+    LimeGreen = 0x32CD32, Maroon = 0x800000, MediumAquamarine = 0x66CDAA, MediumBlue = 0x0000CD,
+    MidnightBlue = 0x191970, Navy = 0x000080, OliveDrab = 0x6B8E23, Orange = 0xFFA500, Red = 0xFF0000,
+    SeaGreen = 0x2E8B57, SkyBlue = 0x87CEEB, Teal = 0x008080, White = 0xFFFFFF, YellowGreen = 0x9ACD32
+  };
+
+  CRGB() = default;
+  constexpr CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+  constexpr CRGB(uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+  constexpr CRGB(HTMLColorCode colorcode) : CRGB((uint32_t)colorcode) {}
+
+  uint8_t &operator[](uint8_t x) { return raw[x]; }
+  const uint8_t &operator[](uint8_t x) const { return raw[x]; }
+
+  CRGB &nscale8(uint8_t scale)
+  {
+    r = scale8(r, scale);
+    g = scale8(g, scale);
+    b = scale8(b, scale);
+    return *this;
+  }
+
+  CRGB &nscale8_video(uint8_t scale)
+  {
+    r = scale8_video(r, scale);
+    g = scale8_video(g, scale);
+    b = scale8_video(b, scale);
+    return *this;
+  }
+
+  explicit operator bool() const { return r || g || b; }
+  bool operator==(const CRGB &o) const { return r == o.r && g == o.g && b == o.b; }
+  bool operator!=(const CRGB &o) const { return !(*this == o); }
+};
+
+enum ColorTemperature {
+  UncorrectedTemperature = 0xFFFFFF
+};
+
+inline CRGB blend(const CRGB &p1, const CRGB &p2, fract8 amountOfP2)
+{
+  return CRGB(blend8(p1.r, p2.r, amountOfP2), blend8(p1.g, p2.g, amountOfP2), blend8(p1.b, p2.b, amountOfP2));
+}
+
+inline void fill_solid(CRGB *leds, int numToFill, const CRGB &color)
+{
+  for (int i = 0; i < numToFill; i++) leds[i] = color;
+}
+
+inline void fadeLightBy(CRGB *leds, uint16_t numLeds, fract8 fadeBy)
+{
+  for (uint16_t i = 0; i < numLeds; i++) leds[i].nscale8_video(255 - fadeBy);
+}
+
+// --- 팔레트 ---
+
+typedef const uint8_t TProgmemRGBGradientPalette_byte;
+typedef const TProgmemRGBGradientPalette_byte *TProgmemRGBGradientPalettePtr;
+
+#define DEFINE_GRADIENT_PALETTE(X) \
+  extern const TProgmemRGBGradientPalette_byte X[] PROGMEM; \
+  const TProgmemRGBGradientPalette_byte X[] PROGMEM =
+
+enum TBlendType {
+  NOBLEND = 0,
+  LINEARBLEND = 1
+};
+
+// leds[startpos..endpos]를 두 색 사이 그래디언트로 채움 (FastLED fill_gradient_RGB)
+inline void fill_gradient_RGB(CRGB *leds, uint16_t startpos, CRGB startcolor, uint16_t endpos, CRGB endcolor)
+{
+  if (endpos < startpos)
+  {
+    std::swap(startpos, endpos);
+    std::swap(startcolor, endcolor);
+  }
+  int16_t rdistance87 = (endcolor.r - startcolor.r) << 7;
+  int16_t gdistance87 = (endcolor.g - startcolor.g) << 7;
+  int16_t bdistance87 = (endcolor.b - startcolor.b) << 7;
+  uint16_t pixeldistance = endpos - startpos;
+  int16_t divisor = pixeldistance ? pixeldistance : 1;
+  int16_t rdelta87 = (rdistance87 / divisor) * 2;
+  int16_t gdelta87 = (gdistance87 / divisor) * 2;
+  int16_t bdelta87 = (bdistance87 / divisor) * 2;
+  uint16_t r88 = startcolor.r << 8;
+  uint16_t g88 = startcolor.g << 8;
+  uint16_t b88 = startcolor.b << 8;
+  for (uint16_t i = startpos; i <= endpos; i++)
+  {
+    leds[i] = CRGB(r88 >> 8, g88 >> 8, b88 >> 8);
+    r88 += rdelta87;
+    g88 += gdelta87;
+    b88 += bdelta87;
+  }
+}
+
+struct CRGBPalette16
+{
+  CRGB entries[16];
+
+  CRGBPalette16() = default;
+  CRGBPalette16(std::initializer_list<uint32_t> codes)
+  {
+    uint8_t i = 0;
+    for (uint32_t code : codes) entries[i++] = CRGB(code);
+  }
+  CRGBPalette16(TProgmemRGBGradientPalettePtr gradient) { loadDynamicGradientPalette(gradient); }
+  CRGBPalette16 &operator=(TProgmemRGBGradientPalettePtr gradient)
+  {
+    loadDynamicGradientPalette(gradient);
+    return *this;
+  }
+
+  CRGB &operator[](uint8_t x) { return entries[x]; }
+  const CRGB &operator[](uint8_t x) const { return entries[x]; }
+
+  // 그래디언트(칸마다 번호, R, G, B)를 16칸으로 펼침
+  void loadDynamicGradientPalette(const uint8_t *gradient)
+  {
+    int count = 0;
+    while (gradient[count * 4] != 255) count++;
+    count++;
+
+    int8_t lastSlotUsed = -1;
+    CRGB rgbstart(gradient[1], gradient[2], gradient[3]);
+    int indexstart = 0;
+    const uint8_t *entry = gradient;
+    while (indexstart < 255)
+    {
+      entry += 4;
+      int indexend = entry[0];
+      CRGB rgbend(entry[1], entry[2], entry[3]);
+      uint8_t istart8 = indexstart / 16;
+      uint8_t iend8 = indexend / 16;
+      if (count < 16)
+      {
+        if (istart8 <= lastSlotUsed && lastSlotUsed < 15)
+        {
+          istart8 = lastSlotUsed + 1;
+          if (iend8 < istart8) iend8 = istart8;
+        }
+        lastSlotUsed = iend8;
+      }
+      fill_gradient_RGB(entries, istart8, rgbstart, iend8, rgbend);
+      indexstart = indexend;
+      rgbstart = rgbend;
+    }
+  }
+};
+
+inline CRGB ColorFromPalette(const CRGBPalette16 &pal, uint8_t index, uint8_t brightness = 255,
+                             TBlendType blendType = LINEARBLEND)
+{
+  uint8_t hi4 = index >> 4;
+  uint8_t lo4 = index & 0x0F;
+  const CRGB *entry = &pal.entries[hi4];
+  uint8_t red1 = entry->r, green1 = entry->g, blue1 = entry->b;
+
+  if (lo4 && blendType != NOBLEND)
+  {
+    entry = hi4 == 15 ? &pal.entries[0] : entry + 1;
+    uint8_t f2 = lo4 << 4;
+    uint8_t f1 = 255 - f2;
+    red1 = scale8(red1, f1) + scale8(entry->r, f2);
+    green1 = scale8(green1, f1) + scale8(entry->g, f2);
+    blue1 = scale8(blue1, f1) + scale8(entry->b, f2);
+  }
+
+  if (brightness != 255)
+  {
+    if (brightness)
+    {
+      brightness++;
+      if (red1) red1 = scale8(red1, brightness);
+      if (green1) green1 = scale8(green1, brightness);
+      if (blue1) blue1 = scale8(blue1, brightness);
+    }
+    else
+    {
+      red1 = green1 = blue1 = 0;
+    }
+  }
+  return CRGB(red1, green1, blue1);
+}
+
+// current를 target 쪽으로 채널 값 1씩 최대 maxChanges개 이동
+inline void nblendPaletteTowardPalette(CRGBPalette16 &current, CRGBPalette16 &target, uint8_t maxChanges)
+{
+  uint8_t *p1 = (uint8_t *)current.entries;
+  uint8_t *p2 = (uint8_t *)target.entries;
+  uint8_t changes = 0;
+  for (uint8_t i = 0; i < 48; i++)
+  {
+    if (p1[i] == p2[i]) continue;
+    if (p1[i] < p2[i])
+    {
+      p1[i]++;
+      changes++;
+    }
+    if (p1[i] > p2[i])
+    {
+      p1[i]--;
+      changes++;
+      if (p1[i] > p2[i]) p1[i]--;
+    }
+    if (changes >= maxChanges) break;
+  }
+}
+
+inline const CRGBPalette16 CloudColors_p = {
+  CRGB::Blue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue, CRGB::DarkBlue,
+  CRGB::DarkBlue, CRGB::Blue, CRGB::DarkBlue, CRGB::SkyBlue, CRGB::SkyBlue, CRGB::LightBlue, CRGB::White,
+  CRGB::LightBlue, CRGB::SkyBlue};
+
+inline const CRGBPalette16 LavaColors_p = {
+  CRGB::Black, CRGB::Maroon, CRGB::Black, CRGB::Maroon, CRGB::DarkRed, CRGB::DarkRed, CRGB::Maroon,
+  CRGB::DarkRed, CRGB::DarkRed, CRGB::DarkRed, CRGB::Red, CRGB::Orange, CRGB::White, CRGB::Orange,
+  CRGB::Red, CRGB::DarkRed};
+
+inline const CRGBPalette16 OceanColors_p = {
+  CRGB::MidnightBlue, CRGB::DarkBlue, CRGB::MidnightBlue, CRGB::Navy, CRGB::DarkBlue, CRGB::MediumBlue,
+  CRGB::SeaGreen, CRGB::Teal, CRGB::CadetBlue, CRGB::Blue, CRGB::DarkCyan, CRGB::CornflowerBlue,
+  CRGB::Aquamarine, CRGB::SeaGreen, CRGB::Aqua, CRGB::LightSkyBlue};
+
+inline const CRGBPalette16 ForestColors_p = {
+  CRGB::DarkGreen, CRGB::DarkGreen, CRGB::DarkOliveGreen, CRGB::DarkGreen, CRGB::Green, CRGB::ForestGreen,
+  CRGB::OliveDrab, CRGB::Green, CRGB::SeaGreen, CRGB::MediumAquamarine, CRGB::LimeGreen, CRGB::YellowGreen,
+  CRGB::LightGreen, CRGB::LawnGreen, CRGB::MediumAquamarine, CRGB::ForestGreen};
+
+inline const CRGBPalette16 PartyColors_p = {
+  0x5500AB, 0x84007C, 0xB5004B, 0xE5001B, 0xE81700, 0xB84700, 0xAB7700, 0xABAB00,
+  0xAB5500, 0xDD2200, 0xF2000E, 0xC2003E, 0x8F0071, 0x5F00A1, 0x2F00D0, 0x0007F9};
+
+inline const CRGBPalette16 HeatColors_p = {
+  0x000000, 0x330000, 0x660000, 0x990000, 0xCC0000, 0xFF0000, 0xFF3300, 0xFF6600,
+  0xFF9900, 0xFFCC00, 0xFFFF00, 0xFFFF33, 0xFFFF66, 0xFFFF99, 0xFFFFCC, 0xFFFFFF};
+
+// --- 컨트롤러 ---
+
+enum EOrder {
+  RGB = 0012,
+  RBG = 0021,
+  GRB = 0102,
+  GBR = 0120,
+  BRG = 0201,
+  BGR = 0210
+};
+
+#define DISABLE_DITHER 0x00
+#define BINARY_DITHER 0x01
+
+template <uint8_t DATA_PIN, EOrder RGB_ORDER>
+class WS2812B {};
+
+class CLEDController {};
+
+class CFastLED
+{
+public:
+  template <template <uint8_t, EOrder> class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+  CLEDController &addLeds(CRGB *data, int count)
+  {
+    leds = data;
+    ledCount = count;
+    order = RGB_ORDER;
+    return controller;
+  }
+
+  void setBrightness(uint8_t scale) { brightness = scale; }
+  uint8_t getBrightness() const { return brightness; }
+  void setMaxPowerInVoltsAndMilliamps(uint8_t, uint32_t) {}
+  void setTemperature(const CRGB &temp) { temperature = temp; }
+  void setDither(uint8_t mode) { dither = mode; }
+
+  void show() { shows++; }
+  void showColor(const CRGB &) { shows++; }
+  void clear(bool writeData = false)
+  {
+    if (leds) memset((void *)leds, 0, ledCount * sizeof(CRGB));
+    if (writeData) show();
+  }
+
+  // 호스트 전용: 시험에서 확인하는 값
+  CRGB *leds = nullptr;
+  int ledCount = 0;
+  EOrder order = RGB;
+  uint8_t brightness = 255;
+  uint8_t dither = BINARY_DITHER;
+  CRGB temperature = CRGB(UncorrectedTemperature);
+  uint32_t shows = 0;
+
+private:
+  CLEDController controller;
+};
+
+inline CFastLED FastLED;
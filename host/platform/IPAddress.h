@@ -0,0 +1,42 @@
+// 호스트 빌드용 IPAddress (Arduino와 같이 네트워크 바이트 순서 그대로 uint32_t에 담음)
+
+#pragma once
+
+#include <Arduino.h>
+#include <arpa/inet.h>
+
+class IPAddress : public Printable
+{
+public:
+  IPAddress() : address(0) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+  {
+    uint8_t bytes[4] = {a, b, c, d};
+    memcpy(&address, bytes, 4);
+  }
+  IPAddress(uint32_t raw) : address(raw) {}
+
+  operator uint32_t() const { return address; }
+  uint8_t operator[](int index) const { return ((const uint8_t *)&address)[index]; }
+  bool isSet() const { return address != 0; }
+
+  bool fromString(const char *text)
+  {
+    struct in_addr parsed;
+    if (inet_pton(AF_INET, text, &parsed) != 1) return false;
+    address = parsed.s_addr;
+    return true;
+  }
+
+  String toString() const
+  {
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+    return String(text);
+  }
+
+  size_t printTo(Print &p) const override { return p.print(toString()); }
+
+private:
+  uint32_t address;
+};
@@ -0,0 +1,3 @@
+// 호스트 빌드용 SPI (펌웨어는 헤더만 포함함, SPI 스트립 출력은 host/hostSinks.h)
+
+#pragma once
@@ -0,0 +1,69 @@
+// 호스트 빌드용 Ticker
+// 주기마다 timerfd(CLOCK_MONOTONIC)가 만료되고, 콜백은 hostRunTimers()가 loop() 바깥에서 실행한다.
+// 기기에서 Ticker 콜백이 loop() 사이(또는 delay()/yield() 중)에 SDK 문맥에서 실행되는 것과 같은 시점이다.
+// 데몬은 hostWaitEvents()로 타이머 fd를 기다리므로 다음 틱까지 CPU를 쓰지 않는다.
+
+#pragma once
+
+#include <Arduino.h>
+#include "hostIo.h"
+#include <sys/timerfd.h>
+#include <functional>
+
+class Ticker;
+inline std::vector<Ticker *> hostTickers;
+inline void hostRunTimers();
+
+class Ticker
+{
+public:
+  typedef std::function<void()> callback_function_t;
+
+  ~Ticker() { detach(); }
+
+  void attach_ms(uint32_t ms, callback_function_t cb)
+  {
+    detach();
+    fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0) return;
+    struct itimerspec spec = {};
+    spec.it_interval.tv_sec = ms / 1000;
+    spec.it_interval.tv_nsec = (ms % 1000) * 1000000L;
+    spec.it_value = spec.it_interval;
+    timerfd_settime(fd, 0, &spec, nullptr);
+    callback = cb;
+    hostWatch(fd);
+    hostTickers.push_back(this);
+    hostTimerHook = hostRunTimers;
+  }
+
+  void attach(float seconds, callback_function_t cb) { attach_ms(seconds * 1000, cb); }
+
+  void detach()
+  {
+    if (fd < 0) return;
+    hostUnwatch(fd);
+    ::close(fd);
+    fd = -1;
+    hostTickers.erase(std::remove(hostTickers.begin(), hostTickers.end(), this), hostTickers.end());
+  }
+
+  bool active() const { return fd >= 0; }
+
+  // 만료된 횟수만큼 콜백 실행
+  void run()
+  {
+    uint64_t expirations = 0;
+    if (fd < 0 || ::read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) return;
+    while (expirations--) callback();
+  }
+
+private:
+  int fd = -1;
+  callback_function_t callback;
+};
+
+inline void hostRunTimers()
+{
+  for (size_t i = 0; i < hostTickers.size(); i++) hostTickers[i]->run();
+}
@@ -0,0 +1,135 @@
+// 호스트 빌드용 WiFiUDP (논블로킹 UDP 소켓)
+// parsePacket()이 데이터그램 하나를 내부 버퍼로 받고 read()가 거기서 꺼낸다.
+// beginPacket()~endPacket() 사이에 쓴 내용은 endPacket()에서 데이터그램 하나로 보낸다.
+
+#pragma once
+
+#include <ESP8266WiFi.h>
+
+class WiFiUDP : public Stream
+{
+public:
+  ~WiFiUDP() { stop(); }
+
+  uint8_t begin(uint16_t port)
+  {
+    stop();
+    if (!openSocket()) return 0;
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(hostPortFor(port));
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+      fprintf(stderr, "UDP %u 포트를 열 수 없음: %s\n", hostPortFor(port), strerror(errno));
+      stop();
+      return 0;
+    }
+    socklen_t length = sizeof(addr);
+    getsockname(fd, (struct sockaddr *)&addr, &length);
+    hostNoteBound(port, ntohs(addr.sin_port));
+    hostWatch(fd);
+    watched = true;
+    return 1;
+  }
+
+  void stop()
+  {
+    if (fd < 0) return;
+    if (watched) hostUnwatch(fd);
+    ::close(fd);
+    fd = -1;
+    watched = false;
+  }
+
+  // 다음 데이터그램 받기 (없으면 0)
+  int parsePacket()
+  {
+    rxLength = rxOffset = 0;
+    if (fd < 0) return 0;
+    struct sockaddr_in from = {};
+    socklen_t length = sizeof(from);
+    ssize_t n = recvfrom(fd, rxBuffer, sizeof(rxBuffer), MSG_DONTWAIT, (struct sockaddr *)&from, &length);
+    if (n <= 0) return 0;
+    rxLength = n;
+    remoteAddress = IPAddress(from.sin_addr.s_addr);
+    remotePortNumber = ntohs(from.sin_port);
+    return n;
+  }
+
+  int available() override { return rxLength - rxOffset; }
+
+  int read() override { return rxOffset < rxLength ? rxBuffer[rxOffset++] : -1; }
+
+  int read(uint8_t *buffer, size_t size)
+  {
+    size_t n = min(size, rxLength - rxOffset);
+    memcpy(buffer, rxBuffer + rxOffset, n);
+    rxOffset += n;
+    return n;
+  }
+
+  int read(char *buffer, size_t size) { return read((uint8_t *)buffer, size); }
+
+  int peek() override { return rxOffset < rxLength ? rxBuffer[rxOffset] : -1; }
+
+  // 남은 수신 데이터 버림 (기기 WiFiUDP::flush와 같음)
+  void flush() override { rxOffset = rxLength; }
+
+  IPAddress remoteIP() const { return remoteAddress; }
+  uint16_t remotePort() const { return remotePortNumber; }
+
+  int beginPacket(IPAddress ip, uint16_t port)
+  {
+    if (fd < 0 && !openSocket()) return 0;
+    txAddress = ip;
+    txPort = port;
+    txLength = 0;
+    return 1;
+  }
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buffer, size_t size) override
+  {
+    size_t n = min(size, sizeof(txBuffer) - txLength);
+    memcpy(txBuffer + txLength, buffer, n);
+    txLength += n;
+    return n;
+  }
+  using Print::write;
+
+  int endPacket()
+  {
+    if (fd < 0) return 0;
+    struct sockaddr_in to = {};
+    to.sin_family = AF_INET;
+    to.sin_port = htons(txPort);
+    to.sin_addr.s_addr = (uint32_t)txAddress;
+    ssize_t n = sendto(fd, txBuffer, txLength, MSG_DONTWAIT, (struct sockaddr *)&to, sizeof(to));
+    txLength = 0;
+    return n >= 0;
+  }
+
+private:
+  int fd = -1;
+  bool watched = false;
+  uint8_t rxBuffer[2048];
+  size_t rxLength = 0;
+  size_t rxOffset = 0;
+  IPAddress remoteAddress;
+  uint16_t remotePortNumber = 0;
+  uint8_t txBuffer[1472];  // 기기 UDP 페이로드 최대 크기
+  size_t txLength = 0;
+  IPAddress txAddress;
+  uint16_t txPort = 0;
+
+  bool openSocket()
+  {
+    fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if (fd < 0) return false;
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    return true;
+  }
+};
@@ -0,0 +1,7 @@
+// 호스트 빌드용 Wire (I2C 장치 없음)
+
+#pragma once
+
+class TwoWire {};
+
+inline TwoWire Wire;
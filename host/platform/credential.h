@@ -0,0 +1,4 @@
+// 호스트 빌드용 credential.h (기기 빌드에서는 사용자가 만드는 파일)
+// AP 이름/암호는 definitions.h에 있고, MQTT/STA 설정은 호스트 빌드에서 쓰지 않는다.
+
+#pragma once
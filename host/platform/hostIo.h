@@ -0,0 +1,92 @@
+// 호스트 빌드 입출력 공통 부분
+//   - 포트 바꾸기: 기기 포트(HTTP 80, UDP 4210 등)를 호스트에서 쓸 포트로 연결 (0이면 커널이 빈 포트 배정)
+//   - 대기: 열린 소켓/타이머 fd를 모아 두고 hostWaitEvents()가 그중 하나가 읽을 수 있을 때까지 잠듦
+//     (데몬이 loop() 사이에 CPU를 쓰지 않고 쉬는 데 사용)
+
+#pragma once
+
+#include <poll.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+struct HostPortMapping {
+  uint16_t devicePort;
+  uint16_t hostPort;   // 요청한 호스트 포트 (0이면 아무 포트)
+  uint16_t boundPort;  // 실제로 열린 포트
+};
+
+inline std::vector<HostPortMapping> hostPortMappings;
+inline std::vector<int> hostWatchedFds;
+
+// 기기 포트를 호스트 포트로 바꿔 열도록 설정 (begin() 전에 호출)
+inline void hostMapPort(uint16_t devicePort, uint16_t hostPort)
+{
+  for (HostPortMapping &m : hostPortMappings)
+  {
+    if (m.devicePort == devicePort)
+    {
+      m.hostPort = hostPort;
+      return;
+    }
+  }
+  hostPortMappings.push_back({devicePort, hostPort, 0});
+}
+
+inline uint16_t hostPortFor(uint16_t devicePort)
+{
+  for (const HostPortMapping &m : hostPortMappings)
+  {
+    if (m.devicePort == devicePort) return m.hostPort;
+  }
+  return devicePort;
+}
+
+inline void hostNoteBound(uint16_t devicePort, uint16_t boundPort)
+{
+  for (HostPortMapping &m : hostPortMappings)
+  {
+    if (m.devicePort == devicePort)
+    {
+      m.boundPort = boundPort;
+      return;
+    }
+  }
+  hostPortMappings.push_back({devicePort, devicePort, boundPort});
+}
+
+// 기기 포트가 실제로 열린 호스트 포트 (아직 안 열렸으면 0)
+inline uint16_t hostBoundPort(uint16_t devicePort)
+{
+  for (const HostPortMapping &m : hostPortMappings)
+  {
+    if (m.devicePort == devicePort) return m.boundPort;
+  }
+  return 0;
+}
+
+inline void hostSetNonBlocking(int fd)
+{
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+inline void hostWatch(int fd)
+{
+  if (fd >= 0) hostWatchedFds.push_back(fd);
+}
+
+inline void hostUnwatch(int fd)
+{
+  hostWatchedFds.erase(std::remove(hostWatchedFds.begin(), hostWatchedFds.end(), fd), hostWatchedFds.end());
+}
+
+// 감시 중인 fd 중 하나가 읽을 수 있게 되거나 timeoutMs가 지날 때까지 대기
+inline void hostWaitEvents(int timeoutMs)
+{
+  std::vector<struct pollfd> fds;
+  fds.reserve(hostWatchedFds.size());
+  for (int fd : hostWatchedFds) fds.push_back({fd, POLLIN, 0});
+  poll(fds.data(), fds.size(), timeoutMs);
+}
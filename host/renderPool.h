@@ -0,0 +1,190 @@
+// 호스트 빌드 전용 병렬 청크 계산 (src/renderChunks.h의 chunkParallel)
+// 스레드마다 청크 구간 [lo, hi)를 하나씩 나눠 주고, 자기 구간은 앞에서부터(lo) 꺼내 계산한다.
+// 자기 구간이 비면 다른 스레드 구간의 뒤쪽(hi)에서 하나씩 훔쳐 온다 (작업 훔치기).
+// 구간은 64비트 원자 값 하나(아래 32비트 lo, 위 32비트 hi)라서 꺼내기와 훔치기 모두 CAS 한 번이다.
+// 부르는 스레드도 0번 자리로 같이 계산하고, 모든 스레드가 손을 뗀 뒤에 돌아온다 (context는 부른 쪽 스택).
+// 난수는 Arduino.h의 스레드별 상태를 쓰고 청크마다 시드를 다시 잡으므로 스레드 수와 관계없이 결과가 같다.
+//
+//   renderPoolStart(4);   // 4스레드(부르는 스레드 포함)로 chunkParallel 설치, 1 이하면 순차 계산
+//   renderPoolStop();     // 작업 스레드 종료, chunkParallel 해제
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define RENDER_POOL_MAX_THREADS 64
+
+struct alignas(64) RenderPoolSlot {
+  std::atomic<uint64_t> range;  // (hi << 32) | lo
+};
+
+struct RenderPoolStats {
+  uint32_t runs;    // 병렬로 계산한 단계 수
+  uint32_t chunks;  // 계산한 청크 수
+  uint32_t steals;  // 다른 스레드 구간에서 훔쳐 온 청크 수
+};
+
+struct RenderPool {
+  std::vector<std::thread> workers;
+  RenderPoolSlot slots[RENDER_POOL_MAX_THREADS];
+  uint8_t threads = 1;
+
+  std::mutex lock;
+  std::condition_variable wake;  // 새 작업 (generation 증가) 또는 종료
+  std::condition_variable idle;  // 작업 스레드가 모두 손을 뗌
+  uint32_t generation = 0;
+  uint8_t busy = 0;              // 이번 작업에서 아직 계산 중인 작업 스레드 수
+  bool stopping = false;
+
+  void (*run)(void *, uint16_t) = nullptr;
+  void *context = nullptr;
+  std::atomic<uint32_t> steals{0};
+};
+
+inline RenderPool renderPool;
+inline RenderPoolStats renderPoolStats;
+
+inline uint64_t renderPoolRange(uint32_t lo, uint32_t hi)
+{
+  return ((uint64_t)hi << 32) | lo;
+}
+
+// 자기 구간 앞쪽에서 청크 하나 꺼냄 (비었으면 false)
+inline bool renderPoolTakeFront(RenderPoolSlot &slot, uint16_t &c)
+{
+  uint64_t range = slot.range.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    uint32_t lo = (uint32_t)range, hi = (uint32_t)(range >> 32);
+    if (lo >= hi) return false;
+    if (slot.range.compare_exchange_weak(range, renderPoolRange(lo + 1, hi), std::memory_order_acq_rel))
+    {
+      c = lo;
+      return true;
+    }
+  }
+}
+
+// 다른 스레드 구간 뒤쪽에서 청크 하나 훔쳐 옴 (비었으면 false)
+inline bool renderPoolTakeBack(RenderPoolSlot &slot, uint16_t &c)
+{
+  uint64_t range = slot.range.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    uint32_t lo = (uint32_t)range, hi = (uint32_t)(range >> 32);
+    if (lo >= hi) return false;
+    if (slot.range.compare_exchange_weak(range, renderPoolRange(lo, hi - 1), std::memory_order_acq_rel))
+    {
+      c = hi - 1;
+      return true;
+    }
+  }
+}
+
+// self번 자리로 계산: 자기 구간을 다 비운 뒤 남은 구간을 돌아가며 훔침
+inline void renderPoolWork(uint8_t self)
+{
+  RenderPool &pool = renderPool;
+  uint16_t c;
+  while (renderPoolTakeFront(pool.slots[self], c)) pool.run(pool.context, c);
+
+  uint32_t stolen = 0;
+  bool found = true;
+  while (found)
+  {
+    found = false;
+    for (uint8_t k = 1; k < pool.threads; k++)
+    {
+      uint8_t victim = (self + k) % pool.threads;
+      while (renderPoolTakeBack(pool.slots[victim], c))
+      {
+        pool.run(pool.context, c);
+        stolen++;
+        found = true;
+      }
+    }
+  }
+  if (stolen) pool.steals.fetch_add(stolen, std::memory_order_relaxed);
+}
+
+// seen: 시작할 때의 generation (그 이전 작업은 이미 끝났음)
+inline void renderPoolWorker(uint8_t self, uint32_t seen)
+{
+  RenderPool &pool = renderPool;
+  for (;;)
+  {
+    {
+      std::unique_lock<std::mutex> guard(pool.lock);
+      pool.wake.wait(guard, [&] { return pool.stopping || pool.generation != seen; });
+      if (pool.stopping) return;
+      seen = pool.generation;
+    }
+    renderPoolWork(self);
+    {
+      std::lock_guard<std::mutex> guard(pool.lock);
+      if (--pool.busy == 0) pool.idle.notify_one();
+    }
+  }
+}
+
+// chunkParallel: [first, last) 청크를 스레드 수만큼 고르게 나눠 계산
+inline void renderPoolRun(uint16_t first, uint16_t last, void (*run)(void *, uint16_t), void *context)
+{
+  RenderPool &pool = renderPool;
+  uint32_t count = last - first;
+  for (uint8_t t = 0; t < pool.threads; t++)
+  {
+    uint32_t lo = first + count * t / pool.threads;
+    uint32_t hi = first + count * (t + 1) / pool.threads;
+    pool.slots[t].range.store(renderPoolRange(lo, hi), std::memory_order_relaxed);
+  }
+  pool.run = run;
+  pool.context = context;
+  pool.steals.store(0, std::memory_order_relaxed);
+
+  {
+    std::lock_guard<std::mutex> guard(pool.lock);
+    pool.busy = pool.threads - 1;
+    pool.generation++;
+  }
+  pool.wake.notify_all();
+  renderPoolWork(0);
+  {
+    std::unique_lock<std::mutex> guard(pool.lock);
+    pool.idle.wait(guard, [&] { return pool.busy == 0; });
+  }
+
+  renderPoolStats.runs++;
+  renderPoolStats.chunks += count;
+  renderPoolStats.steals += pool.steals.load(std::memory_order_relaxed);
+}
+
+inline void renderPoolStop()
+{
+  RenderPool &pool = renderPool;
+  {
+    std::lock_guard<std::mutex> guard(pool.lock);
+    pool.stopping = true;
+  }
+  pool.wake.notify_all();
+  for (std::thread &worker : pool.workers) worker.join();
+  pool.workers.clear();
+  pool.stopping = false;
+  pool.threads = 1;
+  chunkParallel = nullptr;
+}
+
+// 부르는 스레드를 포함해 threads개 스레드로 계산 (1 이하면 순차 계산으로 되돌림)
+inline void renderPoolStart(uint8_t threads)
+{
+  renderPoolStop();
+  threads = constrain(threads, 1, RENDER_POOL_MAX_THREADS);
+  if (threads <= 1) return;
+  renderPool.threads = threads;
+  for (uint8_t t = 1; t < threads; t++) renderPool.workers.emplace_back(renderPoolWorker, t, renderPool.generation);
+  chunkParallel = renderPoolRun;
+}
@@ -0,0 +1,172 @@
+// 청크 계산 확장성 벤치마크
+// 10240픽셀 스트립을 여러 개 이어 10k/100k/1M 픽셀을 만들고, 모닥불/크리스마스/은은한 조명의 단계 계산을
+// 작업 훔치기 풀(renderPool.h)로 1..N 스레드에서 돌려 초당 픽셀 수와 1스레드 대비 속도를 잰다.
+// 스트립마다 ChunkJob이 따로 있고, 모든 스트립의 청크를 한 범위로 풀에 넘긴다 (단계 하나 = 전체 픽셀 한 번).
+// 스레드 수마다 처음 상태에서 몇 단계를 계산한 결과가 1스레드 결과와 비트 단위로 같은지도 확인한다.
+//
+// 사용법: renderScale [--threads N] [--seconds 0.5]
+//   --threads  최대 스레드 수 (기본: 코어 수), 1, 2, 4, ...와 N에서 잰다
+//   결과가 1스레드와 다르면 종료 코드 1
+
+#include "main.cpp"
+#include "renderPool.h"
+
+#include <vector>
+
+#define SCALE_VERIFY_STEPS 3
+
+static const uint32_t scalePixels[] = {10240, 102400, 1048576};
+
+struct ScaleStrip {
+  uint8_t a[NUMPIXELS];  // 효과 현재값
+  uint8_t b[NUMPIXELS];  // 효과 목표값
+  CRGB out[NUMPIXELS];
+  ChunkJob job;
+};
+
+enum ScaleEffect { SCALE_CAMPFIRE, SCALE_CHRISTMAS, SCALE_WARMLIGHT, SCALE_EFFECTS };
+static const char *scaleEffectNames[SCALE_EFFECTS] = {"campfire", "christmas", "warmLight"};
+
+struct ScaleRun {
+  std::vector<ScaleStrip> *strips;
+  ScaleEffect effect;
+  uint32_t step;
+};
+
+static void scaleInit(std::vector<ScaleStrip> &strips)
+{
+  for (size_t s = 0; s < strips.size(); s++)
+  {
+    randomSeed(s + 1);
+    for (int i = 0; i < NUMPIXELS; i++)
+    {
+      strips[s].a[i] = random(50, 200);
+      strips[s].b[i] = strips[s].a[i];
+      strips[s].out[i] = CRGB::Black;
+    }
+  }
+}
+
+// 풀의 청크 번호 g = 스트립 번호 * 스트립당 청크 수 + 스트립 안의 청크 번호
+static void scaleChunk(void *context, uint16_t g)
+{
+  ScaleRun &run = *(ScaleRun *)context;
+  uint16_t perStrip = chunkCount((*run.strips)[0].job);
+  ScaleStrip &s = (*run.strips)[g / perStrip];
+  uint16_t c = g % perStrip;
+  if (run.effect == SCALE_CAMPFIRE)
+  {
+    CampfireKernel<NUMPIXELS, CrgbSink> kernel = {s.a, s.b, {s.out}, &activePalette, nullptr, 15, 5, true};
+    chunkRun(s.job, c, kernel);
+  }
+  else if (run.effect == SCALE_CHRISTMAS)
+  {
+    ChristmasKernel<NUMPIXELS, CrgbSink> kernel = {{s.out}, &activePalette, run.step, (uint8_t)(run.step % 3), 3};
+    chunkRun(s.job, c, kernel);
+  }
+  else
+  {
+    WarmLightKernel<NUMPIXELS, CrgbSink> kernel = {s.a, s.b, {s.out}, CRGB(255, 180, 107), 10, 20, 230, 8, true};
+    chunkRun(s.job, c, kernel);
+  }
+}
+
+static void scaleStep(std::vector<ScaleStrip> &strips, ScaleEffect effect, uint32_t step)
+{
+  for (ScaleStrip &s : strips)
+  {
+    chunkJobStart(s.job, step, effect == SCALE_CHRISTMAS ? nullptr : s.a, NUMPIXELS);
+  }
+  ScaleRun run = {&strips, effect, step};
+  renderPoolRun(0, strips.size() * chunkCount(strips[0].job), scaleChunk, &run);
+}
+
+// 상태와 출력 전체의 FNV-1a 해시
+static uint64_t scaleHash(const std::vector<ScaleStrip> &strips)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (const ScaleStrip &s : strips)
+  {
+    const uint8_t *bytes = (const uint8_t *)&s;
+    for (size_t i = 0; i < offsetof(ScaleStrip, job); i++) hash = (hash ^ bytes[i]) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+static void usage()
+{
+  fprintf(stderr, "usage: renderScale [--threads N] [--seconds N]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  int maxThreads = max(1u, std::thread::hardware_concurrency());
+  double seconds = 0.5;
+  for (int i = 1; i < argc; i++)
+  {
+    if (i + 1 >= argc) usage();
+    const char *arg = argv[i];
+    const char *value = argv[++i];
+    if (strcmp(arg, "--threads") == 0) maxThreads = constrain(atoi(value), 1, RENDER_POOL_MAX_THREADS);
+    else if (strcmp(arg, "--seconds") == 0) seconds = atof(value);
+    else usage();
+  }
+
+  std::vector<int> threadCounts;
+  for (int t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+  threadCounts.push_back(maxThreads);
+
+  currentMode = CAMPFIRE_MODE;
+  selectPalette();
+
+  printf("코어 %u개, 스트립 %u픽셀, 측정 %.1f초\n", std::thread::hardware_concurrency(), NUMPIXELS, seconds);
+  printf("%-9s %-10s %7s %8s %9s %8s %8s %5s\n", "pixels", "effect", "threads", "steps", "Mpix/s", "speedup",
+         "steals", "same");
+
+  bool pass = true;
+  for (uint32_t pixels : scalePixels)
+  {
+    std::vector<ScaleStrip> strips((pixels + NUMPIXELS - 1) / NUMPIXELS);
+    uint32_t total = strips.size() * NUMPIXELS;
+    for (int e = 0; e < SCALE_EFFECTS; e++)
+    {
+      ScaleEffect effect = (ScaleEffect)e;
+      uint64_t expected = 0;
+      double baseRate = 0;
+      for (int threads : threadCounts)
+      {
+        renderPoolStart(threads);
+
+        // 처음 상태에서 몇 단계 계산한 결과를 1스레드 결과와 비교
+        scaleInit(strips);
+        for (uint32_t step = 0; step < SCALE_VERIFY_STEPS; step++) scaleStep(strips, effect, step);
+        uint64_t hash = scaleHash(strips);
+        if (threads == 1) expected = hash;
+        bool same = hash == expected;
+        if (!same) pass = false;
+
+        // 지속 속도 (이어서 계산, 최소 3단계)
+        renderPoolStats = {};
+        uint64_t start = hostMonotonicUs();
+        uint64_t now = start;
+        uint32_t steps = 0;
+        while (steps < 3 || now - start < seconds * 1e6)
+        {
+          scaleStep(strips, effect, SCALE_VERIFY_STEPS + steps);
+          steps++;
+          now = hostMonotonicUs();
+        }
+        double rate = (double)total * steps / ((now - start) / 1e6) / 1e6;
+        if (threads == 1) baseRate = rate;
+        printf("%-9u %-10s %7d %8u %9.1f %7.2fx %8u %5s\n", total, scaleEffectNames[e], threads, steps, rate,
+               rate / baseRate, renderPoolStats.steals, same ? "yes" : "NO");
+        fflush(stdout);
+      }
+    }
+  }
+  renderPoolStop();
+
+  printf("모든 스레드 수에서 1스레드와 같은 결과: %s\n", pass ? "통과" : "실패");
+  return pass ? 0 : 1;
+}
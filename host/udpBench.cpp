@@ -0,0 +1,109 @@
+// UDP 제어와 HTTP 엔드포인트의 지연 비교
+// 같은 색상 변경을 UDP(SET_COLOR + ACK, udpClient.h)와 HTTP(GET /setColor)로 번갈아 보내
+// 보낸 순간부터 ACK/응답을 받을 때까지의 시간을 재고 p50/p99/최대를 출력한다.
+// UDP ACK는 다음 프레임 경계에서 적용된 뒤에 오므로 "적용까지"의 시간이다.
+//
+// 사용법: udpBench --http-port N --udp-port N [--host 127.0.0.1] [--count 500]
+
+#include "udpClient.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// 요청 하나 보내고 연결이 닫힐 때까지 읽음, 상태 코드 반환 (실패하면 -1)
+static int httpGet(const char *host, int port, const std::string &path)
+{
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  inet_pton(AF_INET, host, &addr.sin_addr);
+  struct timeval timeout = {2, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+  {
+    ::close(fd);
+    return -1;
+  }
+  std::string request = "GET " + path + " HTTP/1.1\r\nHost: light\r\nConnection: close\r\n\r\n";
+  send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+  std::string response;
+  char buffer[1024];
+  ssize_t n;
+  while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) response.append(buffer, n);
+  ::close(fd);
+  return response.compare(0, 9, "HTTP/1.1 ") == 0 ? atoi(response.c_str() + 9) : -1;
+}
+
+static void report(const char *name, std::vector<uint32_t> &us, unsigned failures)
+{
+  std::sort(us.begin(), us.end());
+  auto at = [&](int percent) { return us.empty() ? 0.0 : us[std::min(us.size() - 1, us.size() * percent / 100)] / 1000.0; };
+  printf("%-10s %6zu %6u %8.3f %8.3f %8.3f\n", name, us.size(), failures, at(50), at(99),
+         us.empty() ? 0.0 : us.back() / 1000.0);
+}
+
+static void usage()
+{
+  fprintf(stderr, "usage: udpBench --http-port N --udp-port N [--host ADDR] [--count N]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  const char *host = "127.0.0.1";
+  int httpPort = 0, udpPort = 0, count = 500;
+  for (int i = 1; i < argc; i++)
+  {
+    if (i + 1 >= argc) usage();
+    const char *arg = argv[i];
+    const char *value = argv[++i];
+    if (strcmp(arg, "--host") == 0) host = value;
+    else if (strcmp(arg, "--http-port") == 0) httpPort = atoi(value);
+    else if (strcmp(arg, "--udp-port") == 0) udpPort = atoi(value);
+    else if (strcmp(arg, "--count") == 0) count = atoi(value);
+    else usage();
+  }
+  if (httpPort <= 0 || udpPort <= 0 || count <= 0) usage();
+
+  LightControlClient light;
+  if (!light.open(host, udpPort))
+  {
+    fprintf(stderr, "%s:%d UDP를 열 수 없음\n", host, udpPort);
+    return 1;
+  }
+
+  std::vector<uint32_t> udpUs, httpUs;
+  unsigned udpFailures = 0, httpFailures = 0;
+  for (int i = 0; i < count; i++)
+  {
+    uint8_t rgb[3] = {(uint8_t)i, (uint8_t)(i * 3), (uint8_t)(i * 7)};
+
+    Clock::time_point start = Clock::now();
+    int result = light.request(LIGHT_OP_SET_COLOR, rgb, sizeof(rgb));
+    uint32_t us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    if (result == 0) udpUs.push_back(us);
+    else udpFailures++;
+
+    char path[64];
+    snprintf(path, sizeof(path), "/setColor?r=%u&g=%u&b=%u", rgb[0], rgb[1], rgb[2]);
+    start = Clock::now();
+    int status = httpGet(host, httpPort, path);
+    us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    if (status == 200) httpUs.push_back(us);
+    else httpFailures++;
+  }
+
+  printf("색상 변경 %d회씩\n", count);
+  printf("%-10s %6s %6s %8s %8s %8s\n", "path", "ok", "fail", "p50ms", "p99ms", "maxms");
+  report("udp", udpUs, udpFailures);
+  report("http", httpUs, httpFailures);
+  return udpFailures == 0 && httpFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+// UDP 바이너리 제어 클라이언트 (src/udpControl.h의 패킷 구조를 쓰는 호스트 쪽 라이브러리)
+// 펌웨어 헤더 없이 쓸 수 있도록 패킷 구조와 opcode를 따로 정의한다 (크기는 static_assert로 맞춤).
+//
+//   LightControlClient light;
+//   light.open("192.168.4.1", 4210);
+//   uint8_t rgb[3] = {255, 80, 0};
+//   int result = light.request(LIGHT_OP_SET_COLOR, rgb, 3);  // ACK를 기다림: 0 성공, 1 실패, -1 시간 초과
+
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+
+#define LIGHT_MAGIC 0x4D
+#define LIGHT_VERSION 1
+
+enum LightOpcode {
+  LIGHT_OP_PING = 0,
+  LIGHT_OP_SET_MODE = 1,
+  LIGHT_OP_SET_COLOR = 2,
+  LIGHT_OP_SET_BRIGHTNESS = 3,
+  LIGHT_OP_SET_WARM = 4,
+  LIGHT_OP_ACK = 0x80
+};
+
+#define LIGHT_FLAG_ACK 0x01
+#define LIGHT_FLAG_PERSIST 0x02
+
+struct __attribute__((packed)) LightPacket {
+  uint8_t magic;
+  uint8_t version;
+  uint8_t opcode;
+  uint8_t flags;
+  uint16_t seq;
+  uint8_t payload[8];
+};
+
+static_assert(sizeof(LightPacket) == 14, "src/udpControl.h ControlPacket과 같은 크기");
+
+class LightControlClient
+{
+public:
+  ~LightControlClient() { close(); }
+
+  bool open(const char *host, uint16_t port)
+  {
+    close();
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return false;
+    struct sockaddr_in to = {};
+    to.sin_family = AF_INET;
+    to.sin_port = htons(port);
+    if (inet_pton(AF_INET, host, &to.sin_addr) != 1 || connect(fd, (struct sockaddr *)&to, sizeof(to)) < 0)
+    {
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  void close()
+  {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+  }
+
+  // 패킷 하나 보내고 seq 반환 (실패하면 -1)
+  int send(uint8_t opcode, const uint8_t *payload, size_t length, uint8_t flags = 0)
+  {
+    LightPacket packet = {};
+    packet.magic = LIGHT_MAGIC;
+    packet.version = LIGHT_VERSION;
+    packet.opcode = opcode;
+    packet.flags = flags;
+    packet.seq = ++seq;
+    memcpy(packet.payload, payload, length < sizeof(packet.payload) ? length : sizeof(packet.payload));
+    if (::send(fd, &packet, sizeof(packet), 0) != (ssize_t)sizeof(packet)) return -1;
+    return packet.seq;
+  }
+
+  // seq에 대한 ACK를 timeoutMs까지 기다림 (0 성공, 1 실패, -1 시간 초과), 다른 seq의 ACK는 버림
+  int waitAck(uint16_t expected, int timeoutMs)
+  {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    for (;;)
+    {
+      int left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+      struct pollfd p = {fd, POLLIN, 0};
+      if (left < 0 || poll(&p, 1, left) != 1) return -1;
+      LightPacket ack;
+      if (recv(fd, &ack, sizeof(ack), 0) != (ssize_t)sizeof(ack)) continue;
+      if (ack.magic == LIGHT_MAGIC && (ack.opcode & LIGHT_OP_ACK) && ack.seq == expected) return ack.payload[0];
+    }
+  }
+
+  // ACK를 요청해 보내고 결과를 기다림
+  int request(uint8_t opcode, const uint8_t *payload, size_t length, uint8_t flags = 0, int timeoutMs = 500)
+  {
+    int sent = send(opcode, payload, length, flags | LIGHT_FLAG_ACK);
+    return sent < 0 ? -1 : waitAck(sent, timeoutMs);
+  }
+
+private:
+  int fd = -1;
+  uint16_t seq = 0;
+};
@@ -0,0 +1,102 @@
+# UDP 미리보기 뷰어
+# 조명의 viewer 출력 대상(src/outputSink.h)이 보내는 프레임을 받아 터미널에 색 블록으로 그리고,
+# 받은 프레임률과 잃은 프레임 수를 표시한다. 스트립 없이 효과를 확인하거나 출력 속도를 잴 때 쓴다.
+#
+# 사용법:
+#   curl "http://192.168.4.1/output?viewer=<이 PC의 IP>"   (필요하면 &strip=0)
+#   python scripts/frame_viewer.py [--port 4211] [--width 60]
+# 리눅스 데몬(host/lightd)의 socket 출력 대상은 같은 패킷을 UNIX 데이터그램 소켓으로 보낸다:
+#   host/build/lightd --socket /tmp/lightd.sock &
+#   python scripts/frame_viewer.py --unix /tmp/lightd.sock
+import os
+import socket
+import struct
+import sys
+import time
+
+HEADER_FORMAT = "<BBHHHHBB"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+VIEWER_MAGIC = 0x46
+VIEWER_VERSION = 1
+DEFAULT_PORT = 4211
+
+
+def option(args, name, default, kind=int):
+    if name in args:
+        return kind(args[args.index(name) + 1])
+    return default
+
+
+def render(pixels, brightness, width):
+    """픽셀을 width칸 단위로 줄바꿈한 ANSI 트루컬러 블록 문자열"""
+    rows = []
+    for start in range(0, len(pixels), width):
+        row = ""
+        for r, g, b in pixels[start:start + width]:
+            r, g, b = (c * (brightness + 1) >> 8 for c in (r, g, b))
+            row += "\x1b[48;2;%d;%d;%dm " % (r, g, b)
+        rows.append(row + "\x1b[0m")
+    return "\n".join(rows)
+
+
+def main():
+    args = sys.argv[1:]
+    port = option(args, "--port", DEFAULT_PORT)
+    width = option(args, "--width", 60)
+    unix_path = option(args, "--unix", None, str)
+
+    if unix_path:
+        if os.path.exists(unix_path):
+            os.unlink(unix_path)  # 이전 실행이 남긴 소켓 파일
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_DGRAM)
+        sock.bind(unix_path)
+        print("%s 대기 중..." % unix_path)
+    else:
+        sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        sock.bind(("", port))
+        print("UDP %d 대기 중..." % port)
+
+    pixels = []
+    frame = None
+    last_frame = None
+    shown = lost = 0
+    window_start = time.time()
+    window_frames = 0
+    fps = 0.0
+    while True:
+        data, address = sock.recvfrom(2048)
+        if len(data) < HEADER_SIZE:
+            continue
+        magic, version, number, offset, count, total, brightness, _ = struct.unpack_from(HEADER_FORMAT, data)
+        if magic != VIEWER_MAGIC or version != VIEWER_VERSION:
+            continue
+        if number != frame:
+            frame = number
+            if len(pixels) != total:
+                pixels = [(0, 0, 0)] * total
+        body = data[HEADER_SIZE:HEADER_SIZE + count * 3]
+        for i in range(len(body) // 3):
+            pixels[offset + i] = tuple(body[i * 3:i * 3 + 3])
+        if offset + count < total:
+            continue  # 프레임의 마지막 패킷을 받으면 그림
+
+        # 프레임 번호는 16비트로 돌아감
+        if last_frame is not None:
+            lost += (number - last_frame - 1) & 0xFFFF
+        last_frame = number
+        shown += 1
+        window_frames += 1
+        now = time.time()
+        if now - window_start >= 1.0:
+            fps = window_frames / (now - window_start)
+            window_start, window_frames = now, 0
+        sys.stdout.write("\x1b[H\x1b[2J%s  %d픽셀  밝기 %d  %.1ffps  표시 %d  잃음 %d\n%s\n" %
+                         (unix_path or address[0], total, brightness, fps, shown, lost, render(pixels, brightness, width)))
+        sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    try:
+        sys.exit(main())
+    except KeyboardInterrupt:
+        pass
@@ -0,0 +1,38 @@
+# 빌드 후 정적 RAM 사용량 보고 (환경별)
+# firmware.elf에서 .data/.bss 심볼을 크기순으로 정렬해 합계와 상위 항목을 출력한다.
+# 효과 상태는 effectArena 하나로 합쳐져 있으므로 그 크기가 효과 RAM의 최대치이다.
+import subprocess
+
+Import("env")
+
+RAM_SYMBOL_TYPES = "bBdD"
+TOP_COUNT = 12
+
+
+def ram_report(source, target, env):
+    elf = str(target[0])
+    nm = env.subst("$CC").replace("gcc", "nm")
+    try:
+        output = subprocess.run([nm, "--size-sort", "--print-size", "-C", elf],
+                                capture_output=True, text=True, check=True).stdout
+    except (OSError, subprocess.CalledProcessError) as error:
+        print("RAM 보고 생략: %s" % error)
+        return
+
+    symbols = []
+    for line in output.splitlines():
+        parts = line.split(None, 3)
+        if len(parts) == 4 and parts[2] in RAM_SYMBOL_TYPES:
+            symbols.append((int(parts[1], 16), parts[3]))
+    symbols.sort(reverse=True)
+
+    total = sum(size for size, _ in symbols)
+    arena = next((size for size, name in symbols if name == "effectArena"), 0)
+    print("=== 정적 RAM 보고 [%s] ===" % env["PIOENV"])
+    print("  합계 (.data + .bss): %d bytes" % total)
+    print("  효과 공유 영역 (effectArena): %d bytes" % arena)
+    for size, name in symbols[:TOP_COUNT]:
+        print("  %6d  %s" % (size, name))
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", ram_report)
@@ -0,0 +1,153 @@
+# 이벤트 추적(/trace) 분석기
+# 조명에서 내려받은 이진 추적을 시간순 타임라인으로 출력하고, loop 정지마다 그 구간에 있었던
+# 이벤트 중 가장 오래 걸린 것을 원인으로 표시한다. 설정 변경 이벤트를 차례로 적용해
+# 정지 시점의 모드/밝기도 함께 보여준다.
+#
+# 사용법:
+#   python scripts/trace_timeline.py trace.bin
+#   python scripts/trace_timeline.py http://192.168.4.1/trace
+#   python scripts/trace_timeline.py http://192.168.4.1/trace?clear=1 --save trace.bin
+import struct
+import sys
+import urllib.request
+
+HEADER_FORMAT = "<IBBHII"
+RECORD_FORMAT = "<IBBH"
+TRACE_MAGIC = 0x31435254
+TRACE_VERSION = 1
+
+TYPE_NAMES = ["mark", "stall", "http", "udp", "param", "eeprom", "render", "show"]
+MARK_NAMES = ["boot", "clear", "quality"]
+STORE_NAMES = ["settings", "layout", "palette"]
+PARAM_NAMES = ["mode", "color", "brightness", "params", "whitePoint", "palette"]
+# 효과 설정 항목 (id = PARAM_TABLE_BASE + main.cpp paramTable 순서)
+PARAM_TABLE_BASE = 16
+PARAM_TABLE_NAMES = ["warm.temp", "warm.chance", "warm.min", "warm.max", "warm.speed", "warm.smooth",
+                     "noise.scale", "noise.speed", "fire.speed", "fire.change", "fire.spark",
+                     "xmas.speed", "xmas.star", "xmas.hold"]
+MODE_NAMES = ["Normal", "Campfire", "Christmas", "WarmLight", "Beatsin", "Aurora", "Ocean", "Lava"]
+UDP_NAMES = ["ping", "setMode", "setColor", "setBrightness", "setWarm", "sync", "recallPreset"]
+
+# setupWebServer()에서 server.on()을 등록한 순서와 같아야 함
+ROUTES = ["/", "/status", "/setMode", "/setColor", "/setBrightness", "/params", "/metrics", "/sync",
+          "/presets", "/savePreset", "/recallPreset", "/setWhitePoint", "/layout",
+          "/palette", "/layers", "/trace", "/output"]
+
+# 시간 값을 갖는 이벤트 (원인 후보)
+TIMED_TYPES = {"http", "eeprom", "render", "show"}
+
+
+def decode_duration(value):
+    """traceDuration() 역변환 (us)"""
+    if value & 0x8000:
+        return (value & 0x7FFF) * 1000
+    return value
+
+
+def load(source):
+    if source.startswith("http://") or source.startswith("https://"):
+        with urllib.request.urlopen(source, timeout=10) as response:
+            return response.read()
+    with open(source, "rb") as f:
+        return f.read()
+
+
+def parse(data):
+    header_size = struct.calcsize(HEADER_FORMAT)
+    magic, version, record_size, count, now_us, overwritten = struct.unpack_from(HEADER_FORMAT, data)
+    if magic != TRACE_MAGIC or version != TRACE_VERSION:
+        raise ValueError("추적 형식이 아님 (magic=%08x, version=%d)" % (magic, version))
+
+    events = []
+    for i in range(count):
+        time_us, kind, ident, value = struct.unpack_from(RECORD_FORMAT, data, header_size + i * record_size)
+        # micros()는 약 71분마다 넘치므로 내려받은 시각 기준 경과 시간으로 환산
+        age_us = (now_us - time_us) & 0xFFFFFFFF
+        events.append({"age": age_us, "type": TYPE_NAMES[kind] if kind < len(TYPE_NAMES) else str(kind),
+                       "id": ident, "value": value})
+    return events, overwritten
+
+
+def param_name(ident):
+    if ident >= PARAM_TABLE_BASE and ident - PARAM_TABLE_BASE < len(PARAM_TABLE_NAMES):
+        return PARAM_TABLE_NAMES[ident - PARAM_TABLE_BASE]
+    return PARAM_NAMES[ident] if ident < len(PARAM_NAMES) else str(ident)
+
+
+def describe(event):
+    kind, ident, value = event["type"], event["id"], event["value"]
+    if kind == "mark":
+        name = MARK_NAMES[ident] if ident < len(MARK_NAMES) else str(ident)
+        return "quality=%d" % value if name == "quality" else name
+    if kind == "stall":
+        return "loop 간격 %.1fms" % (decode_duration(value) / 1000)
+    if kind == "http":
+        path = ROUTES[ident] if ident < len(ROUTES) else ("(없는 경로)" if ident == 255 else "#%d" % ident)
+        return "%s %.1fms" % (path, decode_duration(value) / 1000)
+    if kind == "udp":
+        return UDP_NAMES[ident] if ident < len(UDP_NAMES) else "opcode %d" % ident
+    if kind == "param":
+        name = param_name(ident)
+        if name == "mode" and value < len(MODE_NAMES):
+            return "mode=%s" % MODE_NAMES[value]
+        return "%s=%d" % (name, value)
+    if kind == "eeprom":
+        name = STORE_NAMES[ident] if ident < len(STORE_NAMES) else str(ident)
+        return "commit %s %.1fms" % (name, decode_duration(value) / 1000)
+    if kind == "render":
+        mode = MODE_NAMES[ident] if ident < len(MODE_NAMES) else str(ident)
+        return "render %s %.1fms" % (mode, decode_duration(value) / 1000)
+    if kind == "show":
+        return "show %.1fms" % (decode_duration(value) / 1000)
+    return "id=%d value=%d" % (ident, value)
+
+
+def main():
+    args = sys.argv[1:]
+    if not args:
+        print("사용법: trace_timeline.py <trace.bin | http://.../trace> [--save file]")
+        return 1
+    data = load(args[0])
+    if "--save" in args:
+        with open(args[args.index("--save") + 1], "wb") as f:
+            f.write(data)
+
+    events, overwritten = parse(data)
+    if not events:
+        print("기록 없음")
+        return 0
+    start_age = events[0]["age"]
+    print("=== 추적 %d개 (덮어써서 잃은 기록 %d개) ===" % (len(events), overwritten))
+
+    state = {}
+    stalls = []
+    for index, event in enumerate(events):
+        t_ms = (start_age - event["age"]) / 1000
+        if event["type"] == "param":
+            state[param_name(event["id"])] = describe(event)
+        print("%10.1fms  %-7s %s" % (t_ms, event["type"], describe(event)))
+        if event["type"] == "stall":
+            stalls.append((index, t_ms, dict(state)))
+
+    if not stalls:
+        print("\nloop 정지 없음")
+        return 0
+
+    print("\n=== loop 정지 원인 ===")
+    for index, t_ms, snapshot in stalls:
+        stall = events[index]
+        gap_us = decode_duration(stall["value"])
+        # 정지 구간: 이전 loop 시작 ~ 이번 loop 시작 (이벤트는 끝난 시각에 기록됨)
+        window_start = stall["age"] + gap_us
+        suspects = [e for e in events[:index]
+                    if e["type"] in TIMED_TYPES and stall["age"] <= e["age"] <= window_start]
+        cause = max(suspects, key=lambda e: decode_duration(e["value"]), default=None)
+        reason = describe(cause) if cause else "기록된 작업 없음 (WiFi/시스템 또는 기록 기준 미만 작업)"
+        context = ", ".join(snapshot[k] for k in ("mode", "brightness") if k in snapshot)
+        print("%10.1fms  %.1fms 정지 <- %s%s" % (t_ms, gap_us / 1000, reason,
+                                                 "  [%s]" % context if context else ""))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
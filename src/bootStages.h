@@ -0,0 +1,44 @@
+// 단계별 부팅
+// setup()에서는 저장된 장면을 불러와 LED를 먼저 켜고, WiFi/OLED/HTTP 같은 느린 초기화는
+// loop()마다 한 단계씩 진행한다 (bootStep()). 각 단계가 끝난 시각을 기록해 /metrics에 보고한다.
+
+#define BOOT_IP_SCREEN_MS 2000  // OLED에 IP 정보를 보여주는 시간
+
+enum BootStage {
+  BOOT_WIFI = 0,   // AP 시작
+  BOOT_DISPLAY,    // OLED 초기화 + IP 화면
+  BOOT_HTTP,       // 웹 서버
+  BOOT_SERVICES,   // UDP, MQTT
+  BOOT_IP_SCREEN,  // IP 화면 표시 시간이 지나면 상태 화면으로
+  BOOT_DONE
+};
+
+struct BootTimes {
+  uint32_t firstLightUs;  // 전원 인가 후 첫 프레임 출력까지 (us)
+  uint32_t wifiMs;        // 단계별 완료 시각 (ms, 부팅 기준)
+  uint32_t displayMs;
+  uint32_t httpMs;
+  uint32_t servicesMs;
+  uint32_t doneMs;
+};
+
+BootStage bootStage = BOOT_WIFI;
+BootTimes bootTimes;
+
+inline bool bootDone()
+{
+  return bootStage == BOOT_DONE;
+}
+
+// 네트워크 서비스(HTTP/UDP/MQTT)를 폴링해도 되는지
+inline bool networkReady()
+{
+  return bootStage > BOOT_SERVICES;
+}
+
+// 현재 단계 완료 시각을 기록하고 다음 단계로
+void bootAdvance(uint32_t &doneAt)
+{
+  doneAt = millis();
+  bootStage = (BootStage)(bootStage + 1);
+}
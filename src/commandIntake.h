@@ -0,0 +1,128 @@
+// 명령 병합 (마지막 값 우선)
+// 웹/UDP/MQTT에서 들어온 설정 변경을 바로 적용하지 않고 항목별 최신 값만 보관한다.
+// 프레임 시작 직전에 applyPendingCommands()가 병합된 상태를 한 번에 적용하므로
+// 슬라이더를 끄는 동안 쌓인 중간 값은 버려지고, 프레임 중간에 상태가 바뀌지 않는다.
+// 플래시 저장은 마지막 변경 후 SAVE_QUIET_MS 동안 조용할 때 한 번만 한다.
+
+#define SAVE_QUIET_MS 1500  // 마지막 변경 후 저장까지 대기 시간
+
+enum PendingFlag {
+  PENDING_MODE = 1 << 0,
+  PENDING_COLOR = 1 << 1,
+  PENDING_BRIGHTNESS = 1 << 2,
+  PENDING_PARAMS = 1 << 3,  // 효과 설정 항목 (항목별 비트는 paramDirty)
+  PENDING_WHITE_POINT = 1 << 4,
+  PENDING_PALETTE = 1 << 5
+};
+
+struct PendingCommands {
+  uint8_t dirty;    // PendingFlag 비트
+  bool persist;     // 적용 후 저장 예약
+  uint8_t mode;
+  uint8_t red, green, blue;
+  uint8_t brightness;
+  uint16_t whitePoint;
+  uint8_t palette;
+  uint32_t paramDirty;  // 바뀐 설정 항목 비트 (bit n = 항목 n)
+  uint16_t params[PARAM_MAX];
+};
+
+struct IntakeStats {
+  uint32_t received;   // 받은 명령 수
+  uint32_t coalesced;  // 적용 전에 새 값으로 대체된 명령 수
+  uint32_t applied;    // 병합 상태를 적용한 횟수 (프레임 단위)
+  uint32_t saves;      // 지연 저장 횟수
+};
+
+PendingCommands pendingCommands;
+IntakeStats intakeStats;
+unsigned long settingsSaveAt = 0;  // 0이면 저장 예약 없음
+
+// 설정 레코드 밖의 EEPROM 블록: 바뀌면 표시만 하고 다음 지연 저장에서 설정과 함께 커밋
+#define STORE_LAYOUT 0x01   // 픽셀 배치 헤더와 사용자 좌표
+#define STORE_PALETTE 0x02  // 사용자 팔레트
+uint8_t storeDirty = 0;
+
+// 항목 하나를 대기 상태로 표시 (이미 대기 중이면 병합으로 집계)
+void markPending(uint8_t flag, bool persist)
+{
+  intakeStats.received++;
+  if (pendingCommands.dirty & flag) intakeStats.coalesced++;
+  pendingCommands.dirty |= flag;
+  if (persist) pendingCommands.persist = true;
+}
+
+void intakeMode(uint8_t mode, bool persist)
+{
+  pendingCommands.mode = mode;
+  markPending(PENDING_MODE, persist);
+}
+
+void intakeColor(uint8_t r, uint8_t g, uint8_t b, bool persist)
+{
+  pendingCommands.red = r;
+  pendingCommands.green = g;
+  pendingCommands.blue = b;
+  markPending(PENDING_COLOR, persist);
+}
+
+void intakeBrightness(uint8_t brightness, bool persist)
+{
+  pendingCommands.brightness = brightness;
+  markPending(PENDING_BRIGHTNESS, persist);
+}
+
+// 효과 설정 항목 하나 (범위 검사는 적용할 때 표 기준으로)
+void intakeParam(uint8_t id, uint16_t value, bool persist)
+{
+  intakeStats.received++;
+  if (pendingCommands.paramDirty & (1UL << id)) intakeStats.coalesced++;
+  pendingCommands.paramDirty |= 1UL << id;
+  pendingCommands.params[id] = value;
+  pendingCommands.dirty |= PENDING_PARAMS;
+  if (persist) pendingCommands.persist = true;
+}
+
+void intakeWhitePoint(uint16_t kelvin, bool persist)
+{
+  pendingCommands.whitePoint = kelvin;
+  markPending(PENDING_WHITE_POINT, persist);
+}
+
+void intakePalette(uint8_t palette, bool persist)
+{
+  pendingCommands.palette = palette;
+  markPending(PENDING_PALETTE, persist);
+}
+
+// 장면 전체가 바뀔 때(프리셋 불러오기 등) 그 전에 들어온 명령은 버림
+void discardPendingCommands()
+{
+  intakeStats.coalesced += __builtin_popcount(pendingCommands.dirty & ~PENDING_PARAMS) +
+                           __builtin_popcount(pendingCommands.paramDirty);
+  pendingCommands.dirty = 0;
+  pendingCommands.paramDirty = 0;
+}
+
+// 저장 예약 (마지막 호출 후 SAVE_QUIET_MS 뒤에 저장)
+void requestSave(unsigned long now)
+{
+  settingsSaveAt = now + SAVE_QUIET_MS;
+  if (settingsSaveAt == 0) settingsSaveAt = 1;
+}
+
+// 블록 변경 표시와 저장 예약 (조용해지면 설정과 한 번에 커밋, 나누어 올린 좌표도 한 번)
+void requestStore(uint8_t blocks, unsigned long now)
+{
+  storeDirty |= blocks;
+  requestSave(now);
+}
+
+// 예약된 저장 시각이 지났으면 true (예약은 해제됨)
+bool saveDue(unsigned long now)
+{
+  if (settingsSaveAt == 0 || (long)(now - settingsSaveAt) < 0) return false;
+  settingsSaveAt = 0;
+  intakeStats.saves++;
+  return true;
+}
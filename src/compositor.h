@@ -0,0 +1,185 @@
+// 레이어 합성
+// 기본 모드(currentMode) 위에 효과 레이어를 최대 OVERLAY_COUNT개 올려 합성한다.
+// 레이어는 효과 모드, 불투명도, 합성 방식을 가지며 자신의 픽셀 버퍼와 효과 상태 영역을 따로 쓴다.
+// 오버레이가 하나도 없으면 기본 모드가 leds[]에 바로 그리므로 지금과 비용이 같다.
+// 레이어 버퍼(픽셀, 효과 상태 영역)는 /layers로 켤 때 힙에서 잡고 끄면 돌려주며,
+// baseLayer도 보이는 레이어가 있어 합성하는 동안만 잡으므로 오버레이를 쓰지 않으면 RAM도 쓰지 않는다.
+// 합성은 픽셀마다 모든 레이어를 차례로 적용하는 한 번의 순회이고,
+// 바뀐 레이어가 차지하는 구간(이전/현재 구간의 합)만 다시 합성한다.
+// 느린 간격으로 계산하는 효과(모닥불/크리스마스)는 레이어에서도 기본 모드처럼 단계 사이를 보간하며,
+// 보간 상태(InterpState)는 레이어마다, 키프레임 두 장은 그 효과 상태와 함께 레이어의 효과 영역에 있다.
+
+#define OVERLAY_COUNT 2  // 기본 모드 위에 올릴 수 있는 레이어 수
+
+enum BlendMode {
+  BLEND_NORMAL = 0,  // 덮어쓰기
+  BLEND_ADD,         // 더하기 (포화)
+  BLEND_SCREEN,      // 스크린 (1 - (1-a)(1-b))
+  BLEND_MULTIPLY,    // 곱하기
+  BLEND_MAX,         // 채널별 최대값
+  BLEND_COUNT
+};
+
+const char *const blendModeNames[BLEND_COUNT] = {
+  "normal", "add", "screen", "multiply", "max"
+};
+
+struct OverlayLayer {
+  uint8_t mode;        // Mode 값
+  uint8_t opacity;     // 0~255
+  uint8_t blend;       // BlendMode
+  bool redraw;         // 다음 프레임에 전체를 다시 그림 (효과의 redrawRequested)
+  bool dirty;          // 설정이 바뀌어 다시 합성해야 함
+  uint16_t lo, hi;     // 합성에 영향을 주는 구간 [lo, hi)
+  uint8_t *arena;      // 효과 상태 영역 (effectArena와 같은 크기, 이 구조체 바로 뒤에 같이 할당)
+  CRGBPalette16 palette;
+  InterpState interp;  // 단계 사이 보간 (frameInterp.h)
+  CRGB pixels[MAX_LEDS];
+};
+
+struct CompositorStats {
+  uint32_t frames;     // 합성한 프레임 수
+  uint32_t pixels;     // 합성한 픽셀 수 (바뀐 구간만)
+  uint32_t skipped;    // 바뀐 레이어가 없어 합성을 건너뛴 프레임 수
+  uint32_t allocFailures;  // 레이어/baseLayer 할당 실패 횟수
+};
+
+OverlayLayer *overlays[OVERLAY_COUNT];  // 켠 레이어만 할당 (꺼져 있으면 nullptr)
+CRGB *baseLayer = nullptr;  // 합성하는 동안 기본 모드가 그리는 버퍼 (그 외에는 nullptr)
+bool compositing = false;   // 기본 모드가 baseLayer에 그리는 중
+uint32_t overlayBytes = 0;  // 지금 잡고 있는 레이어/baseLayer 버퍼 크기
+uint16_t overlayClearLo = MAX_LEDS, overlayClearHi = 0;  // 방금 끈 레이어가 덮고 있던 구간 (다시 합성)
+CompositorStats compositorStats;
+
+inline bool layerVisible(const OverlayLayer *layer)
+{
+  return layer != nullptr && layer->opacity > 0;
+}
+
+// 레이어 하나를 효과 상태 영역과 함께 한 번에 할당 (0으로 채운 상태, 실패하면 nullptr)
+OverlayLayer *overlayAlloc(uint8_t slot, size_t arenaSize)
+{
+  size_t size = sizeof(OverlayLayer) + arenaSize;
+  uint8_t *block = (uint8_t *)malloc(size);
+  if (block == nullptr)
+  {
+    compositorStats.allocFailures++;
+    return nullptr;
+  }
+  memset(block, 0, size);
+  OverlayLayer *layer = (OverlayLayer *)block;
+  layer->arena = block + sizeof(OverlayLayer);  // 구조체 크기는 정렬 단위의 배수라 영역도 정렬됨
+  overlays[slot] = layer;
+  overlayBytes += size;
+  return layer;
+}
+
+// 레이어를 끄고 버퍼를 돌려줌 (합성 중이면 덮고 있던 구간을 다음 프레임에 다시 합성)
+void overlayFree(uint8_t slot, size_t arenaSize)
+{
+  OverlayLayer *layer = overlays[slot];
+  if (layer == nullptr) return;
+  if (compositing && layer->lo < layer->hi)
+  {
+    overlayClearLo = min(overlayClearLo, layer->lo);
+    overlayClearHi = max(overlayClearHi, layer->hi);
+  }
+  overlays[slot] = nullptr;
+  overlayBytes -= sizeof(OverlayLayer) + arenaSize;
+  free(layer);
+}
+
+// 합성을 시작할 때 baseLayer 할당 (실패하면 false, 오버레이 없이 기본 모드만 출력)
+bool baseLayerAlloc(uint16_t count)
+{
+  baseLayer = (CRGB *)malloc(count * sizeof(CRGB));
+  if (baseLayer == nullptr)
+  {
+    compositorStats.allocFailures++;
+    return false;
+  }
+  overlayBytes += count * sizeof(CRGB);
+  return true;
+}
+
+void baseLayerFree(uint16_t count)
+{
+  free(baseLayer);
+  baseLayer = nullptr;
+  overlayBytes -= count * sizeof(CRGB);
+  overlayClearLo = MAX_LEDS;
+  overlayClearHi = 0;
+}
+
+bool overlaysActive()
+{
+  for (uint8_t i = 0; i < OVERLAY_COUNT; i++)
+  {
+    if (layerVisible(overlays[i])) return true;
+  }
+  return false;
+}
+
+// 검은 픽셀이 아래 색을 바꾸지 않는 방식이면 켜진 픽셀 구간만, 아니면 전체
+void layerUpdateSpan(OverlayLayer &layer, uint16_t count)
+{
+  if (layer.blend == BLEND_NORMAL || layer.blend == BLEND_MULTIPLY)
+  {
+    layer.lo = 0;
+    layer.hi = count;
+    return;
+  }
+  uint16_t lo = 0, hi = count;
+  while (lo < hi && !layer.pixels[lo]) lo++;
+  while (hi > lo && !layer.pixels[hi - 1]) hi--;
+  layer.lo = lo;
+  layer.hi = hi;
+}
+
+inline uint8_t screen8(uint8_t a, uint8_t b)
+{
+  return 255 - scale8(255 - a, 255 - b);
+}
+
+// 한 픽셀에 레이어 적용
+inline CRGB blendPixel(const CRGB &below, const CRGB &above, uint8_t mode, uint8_t opacity)
+{
+  CRGB mixed;
+  switch (mode)
+  {
+    case BLEND_ADD:
+      mixed = CRGB(qadd8(below.r, above.r), qadd8(below.g, above.g), qadd8(below.b, above.b));
+      break;
+    case BLEND_SCREEN:
+      mixed = CRGB(screen8(below.r, above.r), screen8(below.g, above.g), screen8(below.b, above.b));
+      break;
+    case BLEND_MULTIPLY:
+      mixed = CRGB(scale8(below.r, above.r), scale8(below.g, above.g), scale8(below.b, above.b));
+      break;
+    case BLEND_MAX:
+      mixed = CRGB(max(below.r, above.r), max(below.g, above.g), max(below.b, above.b));
+      break;
+    default:
+      mixed = above;
+      break;
+  }
+  return opacity == 255 ? mixed : blend(below, mixed, opacity);
+}
+
+// [lo, hi) 구간을 기본 레이어부터 다시 합성해 out에 씀
+void compositeRange(CRGB *out, const CRGB *base, uint16_t lo, uint16_t hi)
+{
+  for (uint16_t i = lo; i < hi; i++)
+  {
+    CRGB color = base[i];
+    for (uint8_t l = 0; l < OVERLAY_COUNT; l++)
+    {
+      const OverlayLayer *layer = overlays[l];
+      if (!layerVisible(layer) || i < layer->lo || i >= layer->hi) continue;
+      color = blendPixel(color, layer->pixels[i], layer->blend, layer->opacity);
+    }
+    out[i] = color;
+  }
+  compositorStats.frames++;
+  compositorStats.pixels += hi - lo;
+}
@@ -15,8 +15,19 @@ String macID = Wifi8266.macAddress();
 
 // neopixel setting
 #define LEDSPIN 14  // D5 (GPIO 14)
-#define MAX_LEDS 200  // 최대 LED 개수 (배열 크기용)                                                           
-int NUMPIXELS = 173;  // 실제 사용할 LED 개수
+#ifndef MAX_LEDS
+#define MAX_LEDS 200  // 최대 LED 개수 (배열 크기, EEPROM 배치용, 호스트 벤치마크는 빌드 플래그로 늘림)
+#endif
+// 스트립 길이와 색 순서는 빌드 시 고정 (platformio.ini build_flags로 변경)
+// 효과 루프의 반복 횟수가 상수가 되고, 색 채널 순서는 FastLED 출력 단계에서만 처리된다.
+#ifndef NUM_LEDS
+#define NUM_LEDS 173  // 실제 사용할 LED 개수
+#endif
+#ifndef LED_COLOR_ORDER
+#define LED_COLOR_ORDER GRB  // 스트립의 색 순서 (효과는 항상 R, G, B 순서로 씀)
+#endif
+static_assert(NUM_LEDS > 0 && NUM_LEDS <= MAX_LEDS, "NUM_LEDS must fit MAX_LEDS");
+constexpr uint16_t NUMPIXELS = NUM_LEDS;
 // Adafruit_NeoPixel pixels(NUMPIXELS, LEDSPIN, NEO_RGB + NEO_KHZ800);  // FastLED 사용으로 주석 처리
 int mr = 0;
 int mg = 0;
@@ -26,4 +37,16 @@ int mb = 0;
 #define SCREEN_WIDTH 128 // OLED display width, in pixels
 #define SCREEN_HEIGHT 64 // OLED display height, in pixels
 #define OLED_RESET -1    // Reset pin # (or -1 if sharing Arduino reset pin)
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
\ No newline at end of file
+Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+// 모드 정의
+enum Mode {
+  NORMAL_MODE = 0,
+  CAMPFIRE_MODE = 1,
+  CHRISTMAS_MODE = 2,
+  WARMLIGHT_MODE = 3,
+  BEATSIN_MODE = 4,
+  AURORA_MODE = 5,
+  OCEAN_MODE = 6,
+  LAVA_MODE = 7
+};
+#define MODE_COUNT 8
@@ -0,0 +1,32 @@
+// 효과 공유 스크래치 영역
+// 효과마다 static 배열을 따로 두면 실행 중이 아닌 효과의 RAM도 계속 잡혀 있으므로,
+// 모든 효과 상태를 하나의 영역에 겹쳐 두고 모드가 바뀔 때 0으로 초기화한다.
+// 효과는 자신의 상태 구조체를 선언하고 effectState<T>()로 가져오며,
+// 영역 크기는 등록된 상태 구조체 중 가장 큰 것으로 컴파일 시점에 정해진다.
+// 합성 레이어(compositor.h)는 같은 크기의 영역을 레이어마다 하나씩 더 가진다.
+
+// 가변 인자 최대값 (영역 크기 계산용)
+constexpr size_t arenaMax(size_t a) { return a; }
+template <typename... Rest>
+constexpr size_t arenaMax(size_t a, size_t b, Rest... rest)
+{
+  return arenaMax(a > b ? a : b, rest...);
+}
+
+extern uint8_t effectArena[];
+extern const size_t effectArenaSize;
+
+// 지금 그리는 효과가 쓰는 영역 (기본 모드는 effectArena, 합성 레이어는 레이어마다 따로)
+uint8_t *currentArena = effectArena;
+
+// 효과 상태 가져오기 (모드 전환 직후에는 모든 바이트가 0)
+template <typename T>
+T &effectState()
+{
+  return *reinterpret_cast<T *>(currentArena);
+}
+
+void resetEffectArena()
+{
+  memset(effectArena, 0, effectArenaSize);
+}
@@ -0,0 +1,230 @@
+// 효과 단계 커널 (모닥불/크리스마스/은은한 조명)
+// ESP8266 펌웨어(src/main.cpp)와 AVR NeoPixel 펌웨어(src/legacy/main.cpp), 호스트 벤치마크가 같이 쓴다.
+// 커널은 픽셀 수(Count)와 출력 방식(Sink)을 템플릿 인자로 받는다.
+//   Count : 스트립 길이. 빌드 상수면 이웃 확산 경계와 전체 순회 범위가 상수로 풀린다
+//           (0이면 실행 시간 길이, 벤치마크의 비교 기준용)
+//   Sink  : 픽셀 하나를 어디에 어떤 순서로 쓸지
+//     CrgbSink              : CRGB 버퍼 (FastLED, 색 순서는 addLeds<..., LED_COLOR_ORDER>가 출력할 때 처리)
+//     PackedSink<Order, Skip> : 전송 순서 바이트 버퍼 (NeoPixel getPixels(), 호스트 싱크), 색 순서와
+//                               앞쪽 건너뛸 픽셀 수가 컴파일 시간에 정해져 픽셀마다 순서 표를 읽지 않음
+// 커널은 전역 상태를 읽지 않고 [lo, hi)만 쓰므로 청크 단위로 나눠 계산할 수 있다 (renderChunks.h).
+// 인자 없이 부르면 스트립 전체를 한 번에 계산한다 (이웃 확산의 양 끝은 쓰지 않으므로 halo 없이).
+
+// 배치 표(layout.h) 없이 쓰는 빌드(AVR 펌웨어)는 1줄 배치만 있음
+#ifndef LAYOUT_COORD_SHIFT
+typedef uint8_t LayoutCoord;
+#define LAYOUT_COORD_SHIFT 0
+#endif
+
+// 크리스마스 모드 (기본 팔레트 구간: 빨강 / 초록 / 흰색 별)
+#define XMAS_COLOR_A 48
+#define XMAS_COLOR_B 144
+#define XMAS_STAR 224
+
+// 픽셀 수: 0이 아니면 빌드 상수, 0이면 초기화할 때 정하는 값
+template <uint16_t Count>
+struct PixelCount {
+  constexpr operator uint16_t() const { return Count; }
+};
+
+template <>
+struct PixelCount<0> {
+  uint16_t value;
+  operator uint16_t() const { return value; }
+};
+
+// CRGB 버퍼에 그대로 씀
+struct CrgbSink {
+  CRGB *pixels;
+
+  void set(uint16_t i, const CRGB &color) const { pixels[i] = color; }
+};
+
+// FastLED 색 순서(EOrder, 8진수 자리마다 채널 번호)에서 전송 바이트 n에 들어갈 채널
+constexpr uint8_t orderChannel(EOrder order, uint8_t n)
+{
+  return (order >> (3 * (2 - n))) & 7;
+}
+
+// 채널이 들어갈 전송 바이트 번호
+constexpr uint8_t orderByte(EOrder order, uint8_t channel)
+{
+  return orderChannel(order, 0) == channel ? 0 : orderChannel(order, 1) == channel ? 1 : 2;
+}
+
+// 전송 순서 바이트 버퍼 (픽셀 i는 Skip + i번째 자리)
+// scale은 Adafruit_NeoPixel::setPixelColor()와 같은 밝기 계산 ((값 * scale) >> 8, 256이면 그대로)
+template <EOrder Order, uint16_t Skip = 0>
+struct PackedSink {
+  uint8_t *bytes;
+  uint16_t scale;
+
+  void set(uint16_t i, const CRGB &color) const
+  {
+    uint8_t *p = bytes + (Skip + i) * 3;
+    p[0] = (color.raw[orderChannel(Order, 0)] * scale) >> 8;
+    p[1] = (color.raw[orderChannel(Order, 1)] * scale) >> 8;
+    p[2] = (color.raw[orderChannel(Order, 2)] * scale) >> 8;
+  }
+};
+
+// 모닥불: 목표값으로 이동 + 이웃 확산 + 불꽃 튐
+template <uint16_t Count, typename Sink>
+struct CampfireKernel {
+  uint8_t *firePixels;
+  uint8_t *targetPixels;
+  Sink out;
+  const CRGBPalette16 *palette;
+  const LayoutCoord *rowY;  // 2D 배치의 정규화 y (아래쪽이 뜨거움), 1줄이면 nullptr
+  uint8_t changeChance;
+  uint8_t sparkChance;
+  bool diffuse;
+  PixelCount<Count> count;  // 빌드 상수면 초기화에서 생략
+
+  void operator()() const { (*this)(0, count, 0, 0); }
+
+  void operator()(uint16_t lo, uint16_t hi, uint8_t left, uint8_t right) const
+  {
+    for (int i = lo; i < hi; i++)
+    {
+      uint8_t previous = firePixels[i];
+
+      // 설정 확률(기본 15%)로 새로운 목표값 설정
+      if (random(0, 100) < changeChance)
+      {
+        targetPixels[i] = random(40, 220);
+      }
+
+      // 현재 값을 목표값으로 부드럽게 이동
+      int diff = (int)targetPixels[i] - (int)firePixels[i];
+      firePixels[i] += diff / 10;
+
+      // 인근 픽셀들의 영향 추가 (불꽃 확산 효과, 이웃은 단계 시작 값)
+      if (diffuse && i > 0 && i < count - 1)
+      {
+        int neighborAvg = ((int)left + (int)(i + 1 < hi ? firePixels[i+1] : right)) / 2;
+        firePixels[i] = ((int)firePixels[i] * 4 + neighborAvg) / 5;
+      }
+      left = previous;
+
+      // 불꽃 강도를 팔레트 번호로 사용 (기본 팔레트: 빨강 위주, 약간의 주황색)
+      uint8_t index = firePixels[i];
+
+      // 설정 확률(기본 5%)로 더 밝은 불꽃 효과
+      if (random(0, 100) < sparkChance)
+      {
+        index = qadd8(index, random(20, 50));
+      }
+
+      // 2D 배치에서는 아래쪽(행 0)이 가장 뜨겁고 위로 갈수록 약해짐
+      if (rowY != nullptr)
+      {
+        index = scale8(index, 255 - (uint8_t)(rowY[i] >> LAYOUT_COORD_SHIFT) / 2);
+      }
+
+      out.set(i, ColorFromPalette(*palette, index));
+    }
+  }
+};
+
+// 크리스마스: 단계와 패턴 번호로 정해지는 색 + 별 반짝임
+template <uint16_t Count, typename Sink>
+struct ChristmasKernel {
+  Sink out;
+  const CRGBPalette16 *palette;
+  uint32_t step;
+  uint8_t phase;  // 0: 빨간색 켜짐, 1: 초록색 켜짐, 2: 둘 다 반짝임
+  uint8_t starChance;
+  PixelCount<Count> count;
+
+  void operator()() const { (*this)(0, count, 0, 0); }
+
+  void operator()(uint16_t lo, uint16_t hi, uint8_t, uint8_t) const
+  {
+    for (int i = lo; i < hi; i++)
+    {
+      uint8_t index;
+      uint8_t bright = 255;
+
+      if (phase == 0)
+      {
+        // 첫째 색 위주, 가끔 둘째 색
+        index = (i % 4 == 0 || i % 4 == 1) ? XMAS_COLOR_A : XMAS_COLOR_B;
+      }
+      else if (phase == 1)
+      {
+        // 둘째 색 위주, 가끔 첫째 색
+        index = (i % 4 == 0 || i % 4 == 1) ? XMAS_COLOR_B : XMAS_COLOR_A;
+      }
+      else
+      {
+        // 둘 다 반짝임 (꺼지는 쪽은 약간 어둡게, 단계마다 번갈아)
+        bool sparkleState = (step + i + 1) & 1;
+        index = (i % 2 == 0) ? XMAS_COLOR_A : XMAS_COLOR_B;
+        if (!sparkleState) bright = 100;
+      }
+
+      // 설정 확률(기본 3%)로 별 반짝임 추가
+      if (random(0, 100) < starChance)
+      {
+        index = XMAS_STAR;
+        bright = 255;
+      }
+
+      out.set(i, ColorFromPalette(*palette, index, bright, NOBLEND));
+    }
+  }
+};
+
+// 은은한 조명: 목표 밝기로 이동 + 이웃 확산, 색온도 색에 밝기를 곱함
+template <uint16_t Count, typename Sink>
+struct WarmLightKernel {
+  uint8_t *warmPixels;
+  uint8_t *targetPixels;
+  Sink out;
+  CRGB baseColor;  // 색온도에 따른 RGB 값
+  uint8_t changeChance;
+  uint8_t minBrightness;
+  uint8_t maxBrightness;
+  uint8_t smoothness;
+  bool diffuse;
+  PixelCount<Count> count;
+
+  void operator()() const { (*this)(0, count, 0, 0); }
+
+  void operator()(uint16_t lo, uint16_t hi, uint8_t left, uint8_t right) const
+  {
+    for (int i = lo; i < hi; i++)
+    {
+      uint8_t previous = warmPixels[i];
+
+      // 설정된 확률로 새로운 목표값 설정
+      if (random(0, 100) < changeChance)
+      {
+        targetPixels[i] = random(minBrightness, maxBrightness + 1);
+      }
+
+      // 현재 값을 목표값으로 부드럽게 이동
+      int diff = (int)targetPixels[i] - (int)warmPixels[i];
+      warmPixels[i] += diff / smoothness;
+
+      // 목표값이 낮을 때(50 이하)는 인근 영향 무시 (이웃은 단계 시작 값)
+      if (diffuse && targetPixels[i] > 50 && i > 0 && i < count - 1)
+      {
+        int neighborAvg = ((int)left + (int)(i + 1 < hi ? warmPixels[i+1] : right)) / 2;
+        warmPixels[i] = ((int)warmPixels[i] * 9 + neighborAvg) / 10;
+      }
+      left = previous;
+
+      // 밝기 조절
+      float intensity = warmPixels[i] / 255.0;
+
+      // 색온도 적용
+      int red = baseColor.r * intensity;
+      int green = baseColor.g * intensity;
+      int blue = baseColor.b * intensity;
+
+      out.set(i, CRGB(red, green, blue));
+    }
+  }
+};
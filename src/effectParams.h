@@ -0,0 +1,113 @@
+// 효과 설정 항목 표
+// 효과마다 조절할 수 있는 값을 설정 항목(ParamDesc) 한 줄로 선언한다: 이름, 표시 이름, 적용 모드,
+// 저장 크기, 범위, 기본값, 장면 레코드(SceneRecord) 안 위치.
+// 범위 검사, 장면 저장/불러오기, /params JSON 조회/변경, 웹 UI 슬라이더는 모두 이 표를 따라 동작하므로
+// 항목을 추가할 때는 표에 한 줄과 SceneRecord 필드 하나만 더하면 된다.
+// 현재 값은 paramValues[]에 있고 효과는 param(id)로 읽는다. 표 자체는 main.cpp에 있다.
+// 이름은 모드 안에서만 유일하면 되므로 (여러 모드의 "speed") 이름 조회는 항상 모드를 함께 받는다 (paramFind).
+
+#define PARAM_MAX 32  // 최대 항목 수 (변경 대기 비트마스크 크기)
+#define MODE_BIT(mode) (1 << (mode))
+
+enum ParamType {
+  PARAM_U8 = 0,
+  PARAM_U16
+};
+
+struct ParamDesc {
+  const char *name;   // 쿼리/JSON 키 (모드 안에서 유일)
+  const char *label;  // UI 표시 이름
+  uint8_t modes;      // 적용 모드 비트 (MODE_BIT)
+  uint8_t type;       // 저장 크기 (ParamType)
+  uint16_t min, max, def, step;
+  uint8_t offset;     // SceneRecord 안 위치
+};
+
+extern const ParamDesc paramTable[];
+extern const uint8_t paramCount;
+void paramChanged(uint8_t id);  // 값이 바뀐 뒤 호출 (파생 값 갱신, main.cpp)
+
+uint16_t paramValues[PARAM_MAX];
+
+inline uint16_t param(uint8_t id)
+{
+  return paramValues[id];
+}
+
+inline bool paramInMode(uint8_t id, uint8_t mode)
+{
+  return paramTable[id].modes & MODE_BIT(mode);
+}
+
+inline uint16_t paramClamp(uint8_t id, long value)
+{
+  const ParamDesc &desc = paramTable[id];
+  return value < desc.min ? desc.min : (value > desc.max ? desc.max : value);
+}
+
+// 표 검사 (컴파일 시간): 적용 모드가 겹치는 두 항목은 이름이 달라야 paramFind가 항목 하나를 찾음
+constexpr bool paramNameEqual(const char *a, const char *b)
+{
+  return *a == *b && (*a == 0 || paramNameEqual(a + 1, b + 1));
+}
+
+constexpr bool paramClashWith(const ParamDesc *table, uint8_t count, uint8_t i, uint8_t j)
+{
+  return j < count && (((table[i].modes & table[j].modes) && paramNameEqual(table[i].name, table[j].name)) ||
+                       paramClashWith(table, count, i, j + 1));
+}
+
+constexpr bool paramNamesClash(const ParamDesc *table, uint8_t count, uint8_t i = 0)
+{
+  return i < count && (paramClashWith(table, count, i, i + 1) || paramNamesClash(table, count, i + 1));
+}
+
+// 모드 안에서 이름으로 항목 찾기 (없으면 -1)
+int paramFind(uint8_t mode, const char *name)
+{
+  for (uint8_t id = 0; id < paramCount; id++)
+  {
+    if (paramInMode(id, mode) && strcmp(paramTable[id].name, name) == 0) return id;
+  }
+  return -1;
+}
+
+void paramSet(uint8_t id, long value)
+{
+  paramValues[id] = paramClamp(id, value);
+  paramChanged(id);
+}
+
+// 장면 레코드 <-> 현재 값 (저장 크기에 맞춰 바이트 단위로 복사)
+void paramStore(uint8_t *record)
+{
+  for (uint8_t id = 0; id < paramCount; id++)
+  {
+    const ParamDesc &desc = paramTable[id];
+    if (desc.type == PARAM_U16) memcpy(record + desc.offset, &paramValues[id], 2);
+    else record[desc.offset] = paramValues[id];
+  }
+}
+
+void paramLoad(const uint8_t *record)
+{
+  for (uint8_t id = 0; id < paramCount; id++)
+  {
+    const ParamDesc &desc = paramTable[id];
+    uint16_t value = record[desc.offset];
+    if (desc.type == PARAM_U16) memcpy(&value, record + desc.offset, 2);
+    paramSet(id, value);
+  }
+}
+
+// from 바이트 이후에 있는 항목을 기본값으로 채움 (이전 버전 레코드 변환, 기본 장면)
+void paramStoreDefaults(uint8_t *record, size_t from)
+{
+  for (uint8_t id = 0; id < paramCount; id++)
+  {
+    const ParamDesc &desc = paramTable[id];
+    if (desc.offset < from) continue;
+    if (desc.type == PARAM_U16) memcpy(record + desc.offset, &desc.def, 2);
+    else record[desc.offset] = desc.def;
+  }
+}
@@ -0,0 +1,85 @@
+// 시뮬레이션 단계 사이 프레임 보간
+// 모닥불(70ms), 크리스마스(250ms)처럼 느린 간격으로 계산하는 효과는 단계가 바뀔 때만 색이 변해 끊겨 보인다.
+// 효과가 새 단계를 그리면 그 결과를 다음 키프레임으로 저장하고, 출력 프레임마다
+// 이전 키프레임 -> 새 키프레임 사이를 경과 시간 비율(0~256)로 선형 보간해 leds[]에 쓴다.
+// 출력은 한 단계 늦지만 효과 계산은 그대로이고, 프레임당 비용은 픽셀당 채널 3개 보간 한 번이다.
+// 기본 모드는 interp를, 오버레이 레이어는 레이어마다 자기 InterpState를 쓴다 (compositor.h).
+// 키프레임 두 장(InterpFrames, 픽셀당 6바이트)은 보간하는 효과의 상태 구조체 안에 두므로
+// 효과 영역(effectArena.h)을 나눠 쓰고, 보간하지 않는 모드가 실행 중이면 그 자리는 그 모드의 상태가 쓴다.
+
+#define INTERP_FRAME_MS 16  // 보간 출력 간격 (약 60fps)
+
+struct InterpState {
+  bool valid;          // 키프레임이 하나라도 있음
+  bool pending;        // 새 키프레임 이후 아직 출력 안 함
+  uint16_t period;     // 단계 간격 (ms)
+  uint32_t keyAt;      // 새 키프레임의 단계 시작 시각 (공유 시계)
+  uint32_t lastFrame;  // 마지막 보간 출력 시각
+  uint16_t lastFrac;   // 마지막 보간 비율
+  uint32_t keyframes;  // 받은 키프레임 수
+  uint32_t frames;     // 보간해서 출력한 프레임 수
+};
+
+struct InterpFrames {
+  CRGB prev[MAX_LEDS];
+  CRGB next[MAX_LEDS];
+};
+
+InterpState interp;  // 기본 모드
+
+// 모드 전환 시 이전 모드의 키프레임 폐기
+void interpReset(InterpState &state)
+{
+  state.valid = false;
+  state.pending = false;
+}
+
+// 효과가 새 단계를 그린 직후 호출 (frame은 새 단계 결과)
+void interpKeyframe(InterpState &state, InterpFrames &frames, const CRGB *frame, uint16_t count, uint32_t keyAt,
+                    uint16_t period)
+{
+  if (state.valid) memcpy(frames.prev, frames.next, count * sizeof(CRGB));
+  else memcpy(frames.prev, frame, count * sizeof(CRGB));
+  memcpy(frames.next, frame, count * sizeof(CRGB));
+  state.valid = true;
+  state.pending = true;
+  state.period = period;
+  state.keyAt = keyAt;
+  state.keyframes++;
+}
+
+// 고정소수점 보간 (frac: 0~256)
+inline uint8_t interpLerp(uint8_t a, uint8_t b, uint16_t frac)
+{
+  return a + (((int16_t)(b - a) * (int16_t)frac) >> 8);
+}
+
+// 현재 시각의 보간 프레임을 out에 씀 (출력이 바뀌었으면 true)
+bool interpFrame(InterpState &state, const InterpFrames &frames, CRGB *out, uint16_t count, uint32_t now)
+{
+  if (!state.valid) return false;
+  if (!state.pending && now - state.lastFrame < INTERP_FRAME_MS) return false;
+
+  uint32_t elapsed = now - state.keyAt;
+  uint16_t frac = elapsed >= state.period ? 256 : (elapsed << 8) / state.period;
+  if (!state.pending && frac == state.lastFrac) return false;
+
+  if (frac == 256)
+  {
+    memcpy(out, frames.next, count * sizeof(CRGB));
+  }
+  else
+  {
+    for (uint16_t i = 0; i < count; i++)
+    {
+      out[i].r = interpLerp(frames.prev[i].r, frames.next[i].r, frac);
+      out[i].g = interpLerp(frames.prev[i].g, frames.next[i].g, frac);
+      out[i].b = interpLerp(frames.prev[i].b, frames.next[i].b, frac);
+    }
+  }
+  state.pending = false;
+  state.lastFrame = now;
+  state.lastFrac = frac;
+  state.frames++;
+  return true;
+}
@@ -0,0 +1,59 @@
+// 프레임 간격 타이머
+// Ticker(SDK 소프트웨어 타이머)가 FRAME_PERIOD_MS마다 틱을 올리고, loop()는 틱이 쌓였을 때만
+// 렌더링/출력한다. 네트워크/입력 처리는 매 loop 돌지만 프레임은 고정 간격으로 나간다.
+// loop가 늦어 틱이 여러 개 쌓였으면 한 프레임만 그리고 나머지는 놓친 프레임으로 센다.
+// 프레임을 가져갈 때마다 직전 프레임과의 간격을 재서 품질 조절(qualityGovernor.h)에 넘긴다.
+
+#include <Ticker.h>
+
+#ifndef FRAME_PERIOD_MS
+#define FRAME_PERIOD_MS 16  // 프레임 간격 (약 60fps)
+#endif
+
+struct FramePacerStats {
+  uint32_t frames;    // 그린 프레임 수
+  uint32_t missed;    // loop가 늦어 건너뛴 틱 수
+  uint32_t gapUs;     // 직전 프레임과 이번 프레임 사이 간격 (첫 프레임, 유휴 대기 뒤에는 0)
+  uint32_t maxGapUs;  // 가장 긴 프레임 간격
+};
+
+Ticker framePacerTicker;
+volatile uint16_t framePacerTicks = 0;
+FramePacerStats framePacerStats;
+unsigned long framePacerLastUs = 0;
+bool framePacerHasLast = false;
+
+void framePacerTick()
+{
+  framePacerTicks++;
+}
+
+void framePacerBegin()
+{
+  framePacerTicks = 1;  // 첫 loop에서 바로 한 프레임
+  framePacerTicker.attach_ms(FRAME_PERIOD_MS, framePacerTick);
+}
+
+// 이번 loop에 프레임을 그릴 차례인지 (쌓인 틱을 모두 소비)
+bool framePacerTake()
+{
+  uint16_t ticks = framePacerTicks;
+  if (ticks == 0) return false;
+  framePacerTicks = 0;
+  framePacerStats.frames++;
+  framePacerStats.missed += ticks - 1;
+
+  unsigned long now = micros();
+  framePacerStats.gapUs = framePacerHasLast ? now - framePacerLastUs : 0;
+  if (framePacerStats.gapUs > framePacerStats.maxGapUs) framePacerStats.maxGapUs = framePacerStats.gapUs;
+  framePacerLastUs = now;
+  framePacerHasLast = true;
+  return true;
+}
+
+// 의도적인 대기(유휴 절전) 뒤에 호출: 대기 중 쌓인 틱은 놓친 프레임으로, 대기 시간은 프레임 간격으로 세지 않음
+void framePacerSkip()
+{
+  if (framePacerTicks > 1) framePacerTicks = 1;
+  framePacerHasLast = false;
+}
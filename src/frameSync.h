@@ -0,0 +1,152 @@
+// 여러 조명 간 애니메이션 시계 동기화
+// 리더가 UDP 제어 포트로 시간 기준과 효과 시드를 브로드캐스트하고,
+// 팔로워는 자신의 애니메이션 시계(animMillis)를 리더 시간에 맞춘다.
+// 효과는 millis() 대신 animMillis()와 공유 시드로 상태를 결정하므로
+// 같은 네트워크의 조명들이 같은 프레임을 그리게 된다.
+//
+// 동기 패킷: CTRL_OP_SYNC, payload [0..3]=리더 animMillis, [4..7]=효과 시드 (리틀 엔디안)
+//
+// 브로드캐스트가 도착했을 때 리더 시계는 이미 한쪽 전송 지연만큼 앞서 있다. 팔로워는
+// SYNC_PROBE_INTERVAL마다 프로브(CTRL_OP_SYNC_PROBE, seq=번호)를 브로드캐스트하고, 리더는 같은 seq의
+// 동기 패킷을 팔로워에게 바로 돌려준다. 왕복 시간의 절반을 한쪽 지연으로 보고 받은 리더 시간에 더한다.
+// 남는 오차는 오가는 경로의 지연 차이(같은 AP 안에서 수 ms)와 loop 주기(패킷은 다음 loop에서 처리)다.
+
+#define SYNC_BROADCAST_INTERVAL 500  // 리더 브로드캐스트 간격 (ms)
+#define SYNC_STEP_THRESHOLD 1000     // 오차가 이보다 크면 즉시 맞춤, 작으면 점진 보정 (ms)
+#define SYNC_TIMEOUT 5000            // 이 시간 동안 동기 패킷이 없으면 동기 상실로 표시 (ms)
+#define SYNC_PROBE_INTERVAL 2000     // 팔로워 왕복 시간 측정 간격 (ms)
+#define SYNC_MAX_RTT 250             // 이보다 늦게 온 응답은 지연 추정에 쓰지 않음 (ms)
+
+enum SyncRole {
+  SYNC_OFF = 0,
+  SYNC_LEADER = 1,
+  SYNC_FOLLOWER = 2
+};
+
+SyncRole syncRole = SYNC_OFF;
+int32_t syncOffset = 0;          // animMillis() - millis()
+int32_t syncLastError = 0;       // 마지막 수신 시 오차 (ms)
+uint32_t effectSeed = 0;         // 효과 난수 시드 (리더에서 공유)
+unsigned long syncLastReceived = 0;
+unsigned long syncLastBroadcast = 0;
+uint16_t syncProbeSeq = 0;        // 마지막 프로브 번호 (0은 브로드캐스트용)
+unsigned long syncProbeSentAt = 0;
+bool syncProbePending = false;
+uint32_t syncLatency = 0;         // 추정한 한쪽 전송 지연 (ms)
+uint32_t syncRtt = 0;             // 마지막으로 잰 왕복 시간 (ms)
+
+// 공유 애니메이션 시계
+uint32_t animMillis()
+{
+  return millis() + syncOffset;
+}
+
+// FastLED beat 함수에 넘길 timebase (animMillis 기준으로 위상을 맞춤)
+uint32_t animTimebase()
+{
+  return (uint32_t)(-syncOffset);
+}
+
+// 시뮬레이션 단계마다 난수 시드를 공유 시간/시드로 재설정
+// randomSeed(0)은 무시되어 이전 난수열을 이어 쓰므로 0은 1로 바꿈 (청크를 다른 스레드에서 계산해도 같은 난수열)
+void seedEffectRandom(uint32_t step)
+{
+  uint32_t seed = effectSeed ^ (step * 2654435761UL);
+  randomSeed(seed != 0 ? seed : 1);
+}
+
+// 효과 상태 초기값용 시드 (시작한 단계와 공유 시드로 결정, 단계 계산 시드와 겹치지 않게 뒤집음)
+void seedEffectInit(uint32_t step)
+{
+  seedEffectRandom(~step);
+}
+
+bool isSyncLocked()
+{
+  return syncRole == SYNC_FOLLOWER && syncLastReceived != 0 &&
+         millis() - syncLastReceived < SYNC_TIMEOUT;
+}
+
+void frameSyncBegin(SyncRole role)
+{
+  syncRole = role;
+  effectSeed = ESP.getChipId() ^ micros();
+  syncProbePending = false;
+  syncLatency = 0;
+}
+
+// 팔로워: 리더 시간으로 시계 보정 (seq가 마지막 프로브 번호면 왕복 시간으로 지연 추정 갱신)
+void frameSyncReceive(uint32_t leaderTime, uint32_t seed, uint16_t seq)
+{
+  if (syncRole != SYNC_FOLLOWER) return;
+
+  if (syncProbePending && seq == syncProbeSeq)
+  {
+    syncProbePending = false;
+    syncRtt = millis() - syncProbeSentAt;
+    if (syncRtt <= SYNC_MAX_RTT)
+    {
+      // 첫 측정은 그대로, 이후는 지터를 줄이려고 1/4씩 반영
+      syncLatency = syncLatency == 0 ? syncRtt / 2 : (syncLatency * 3 + syncRtt / 2 + 2) / 4;
+    }
+  }
+
+  int32_t error = (int32_t)(leaderTime + syncLatency - animMillis());
+  if (error > SYNC_STEP_THRESHOLD || error < -SYNC_STEP_THRESHOLD)
+  {
+    syncOffset += error;  // 처음 맞추거나 크게 어긋난 경우
+  }
+  else
+  {
+    syncOffset += error / 2;  // 네트워크 지터를 줄이기 위해 절반씩 보정
+  }
+  syncLastError = error;
+  effectSeed = seed;
+  syncLastReceived = millis();
+}
+
+void sendSyncPacket(uint8_t opcode, uint16_t seq, IPAddress ip, uint16_t port)
+{
+  ControlPacket packet;
+  memset(&packet, 0, sizeof(packet));
+  packet.magic = CTRL_MAGIC;
+  packet.version = CTRL_VERSION;
+  packet.opcode = opcode;
+  packet.seq = seq;
+  if (opcode == CTRL_OP_SYNC)
+  {
+    uint32_t now = animMillis();
+    memcpy(packet.payload, &now, 4);
+    memcpy(packet.payload + 4, &effectSeed, 4);
+  }
+
+  controlUdp.beginPacket(ip, port);
+  controlUdp.write((const uint8_t *)&packet, sizeof(packet));
+  controlUdp.endPacket();
+}
+
+// 리더: 프로브를 보낸 팔로워에게 바로 현재 시간 회신
+void frameSyncAnswerProbe(const PendingControl &probe)
+{
+  if (syncRole != SYNC_LEADER) return;
+  sendSyncPacket(CTRL_OP_SYNC, probe.packet.seq, IPAddress(probe.remoteIP), probe.remotePort);
+}
+
+// 리더: 주기적으로 시간 기준 브로드캐스트, 팔로워: 주기적으로 왕복 시간 측정
+void frameSyncLoop()
+{
+  if (syncRole == SYNC_FOLLOWER)
+  {
+    if (millis() - syncProbeSentAt < SYNC_PROBE_INTERVAL) return;
+    syncProbeSentAt = millis();
+    if (++syncProbeSeq == 0) syncProbeSeq = 1;
+    syncProbePending = true;
+    sendSyncPacket(CTRL_OP_SYNC_PROBE, syncProbeSeq, IPAddress(255, 255, 255, 255), UDP_CONTROL_PORT);
+    return;
+  }
+
+  if (syncRole != SYNC_LEADER) return;
+  if (millis() - syncLastBroadcast < SYNC_BROADCAST_INTERVAL) return;
+  syncLastBroadcast = millis();
+  sendSyncPacket(CTRL_OP_SYNC, 0, IPAddress(255, 255, 255, 255), UDP_CONTROL_PORT);
+}
@@ -0,0 +1,85 @@
+// 유휴 절전
+// 출력이 일정 시간 바뀌지 않으면(정적 색상, 밝기 0 등) 유휴 상태로 들어가
+// FastLED.show()를 멈추고 loop 사이에 delay()로 CPU를 쉬게 한다.
+// 절전 효과는 대부분 이 IDLE_SLEEP_MS delay()에서 나온다 (CPU가 SDK 대기 작업에서 쉬고 출력도 멈춤).
+// WiFi 라이트 슬립은 STA가 공유기에 붙어 있을 때만 의미가 있다. AP가 켜져 있으면 무선을 끌 수 없어
+// 기본 구성(AP 전용)에서는 아무 효과가 없으므로 바꾸지 않는다. 바꾼 경우 깨어날 때 이전 설정으로 되돌린다.
+// 요청이 들어와 상태가 바뀌면 다음 프레임에서 바로 깨어난다.
+// 시간은 모두 인자로 받으므로 millis() 대신 가짜 시계로 동작을 확인할 수 있다.
+
+#define IDLE_ENTER_MS 2000  // 출력 변화가 없을 때 유휴 상태로 들어가기까지의 시간
+#define IDLE_SLEEP_MS 20    // 유휴 상태에서 loop마다 쉬는 시간 (요청 응답 지연의 상한)
+
+struct IdleTracker {
+  bool idle;
+  unsigned long lastChange;    // 마지막으로 출력이 바뀐 시각
+  unsigned long idleSince;     // 유휴 상태 진입 시각
+  unsigned long idleTotalMs;   // 누적 유휴 시간 (현재 유휴 구간 제외)
+  unsigned long sleepTotalMs;  // 누적 delay() 시간
+  uint32_t entries;            // 유휴 진입 횟수
+  bool lightSleep;             // 유휴 진입 때 라이트 슬립으로 바꿨는지
+  WiFiSleepType_t savedSleep;  // 바꾸기 전 절전 설정 (깨어날 때 복원)
+};
+
+IdleTracker idleTracker;
+
+void idleEnter(unsigned long now)
+{
+  idleTracker.idle = true;
+  idleTracker.idleSince = now;
+  idleTracker.entries++;
+
+  // STA로 공유기에 연결된 경우에만 라이트 슬립 (AP 전용/미연결이면 효과 없음)
+  idleTracker.lightSleep = (WiFi.getMode() & WIFI_STA) && WiFi.status() == WL_CONNECTED;
+  if (idleTracker.lightSleep)
+  {
+    idleTracker.savedSleep = WiFi.getSleepMode();
+    WiFi.setSleepMode(WIFI_LIGHT_SLEEP);
+  }
+}
+
+void idleExit(unsigned long now)
+{
+  idleTracker.idle = false;
+  idleTracker.idleTotalMs += now - idleTracker.idleSince;
+  if (idleTracker.lightSleep) WiFi.setSleepMode(idleTracker.savedSleep);
+  idleTracker.lightSleep = false;
+}
+
+// 프레임마다 호출: 출력이 바뀌었는지 알려줌
+void idleNoteFrame(bool changed, unsigned long now)
+{
+  if (changed)
+  {
+    idleTracker.lastChange = now;
+    if (idleTracker.idle) idleExit(now);
+  }
+  else if (!idleTracker.idle && now - idleTracker.lastChange >= IDLE_ENTER_MS)
+  {
+    idleEnter(now);
+  }
+}
+
+// 외부 활동(요청 처리 중 등)이 있으면 유휴에서 깨움
+void idleWake(unsigned long now)
+{
+  idleTracker.lastChange = now;
+  if (idleTracker.idle) idleExit(now);
+}
+
+// 누적 유휴 시간 (현재 유휴 구간 포함)
+unsigned long idleTimeMs(unsigned long now)
+{
+  unsigned long total = idleTracker.idleTotalMs;
+  if (idleTracker.idle) total += now - idleTracker.idleSince;
+  return total;
+}
+
+// 유휴 상태면 잠시 쉼
+void idleSleep()
+{
+  if (!idleTracker.idle) return;
+  unsigned long start = millis();
+  delay(IDLE_SLEEP_MS);
+  idleTracker.sleepTotalMs += millis() - start;
+}
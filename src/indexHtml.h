@@ -0,0 +1,133 @@
+// 메인 HTML 페이지 (PROGMEM에 저장하여 요청마다 String을 만들지 않음)
+const char INDEX_HTML[] PROGMEM = R"rawliteral(<!DOCTYPE html><html><head><meta charset='UTF-8'>
+<meta name='viewport' content='width=device-width, initial-scale=1.0'>
+<title>IoT Mood Light</title><style>
+body{font-family:Arial,sans-serif;max-width:600px;margin:20px auto;padding:20px;background:#f0f0f0}
+h1{text-align:center;color:#333}
+.panel{background:white;padding:20px;margin:15px 0;border-radius:8px;box-shadow:0 2px 4px rgba(0,0,0,0.1)}
+.mode-btn{display:inline-block;padding:12px 20px;margin:5px;background:#4CAF50;color:white;border:none;border-radius:5px;cursor:pointer;font-size:14px}
+.mode-btn:hover{background:#45a049}
+.mode-btn.active{background:#FF9800}
+.slider-container{margin:15px 0}
+.slider-label{display:flex;justify-content:space-between;margin-bottom:5px;color:#555}
+input[type=range],select{width:100%;height:8px;border-radius:5px;outline:none}
+select{height:35px;padding:5px;font-size:14px}
+.status{padding:10px;background:#e3f2fd;border-left:4px solid #2196F3;margin:15px 0;border-radius:4px}
+#colorPreview{width:100%;height:50px;border-radius:5px;margin-top:10px;border:2px solid #ddd}
+</style></head><body>
+<h1>IoT Mood Light</h1>
+<div class='panel'><h3>Status</h3><div class='status'>
+<div>Mode: <strong id='mode'>-</strong></div>
+<div>Brightness: <strong id='brightness'>-</strong></div>
+<div>RGB: (<span id='r'>-</span>, <span id='g'>-</span>, <span id='b'>-</span>)</div>
+</div></div>
+<div class='panel'><h3>Mode</h3>
+<button class='mode-btn' onclick='setMode(0)'>Normal</button>
+<button class='mode-btn' onclick='setMode(1)'>Campfire</button>
+<button class='mode-btn' onclick='setMode(2)'>Christmas</button>
+<button class='mode-btn' onclick='setMode(3)'>Warm Light</button>
+<button class='mode-btn' onclick='setMode(4)'>Beatsin</button>
+<button class='mode-btn' onclick='setMode(5)'>Aurora</button>
+<button class='mode-btn' onclick='setMode(6)'>Ocean</button>
+<button class='mode-btn' onclick='setMode(7)'>Lava</button>
+</div>
+<div class='panel'><h3>Brightness</h3>
+<div class='slider-container'><div class='slider-label'><span>Brightness</span><span id='bVal'>50</span></div>
+<input type='range' id='bSlider' min='0' max='255' value='50' oninput='setBright(this.value)'>
+</div></div>
+<div class='panel'><h3>Color (Normal Mode)</h3>
+<div class='slider-container'><div class='slider-label'><span>Red</span><span id='rVal'>255</span></div>
+<input type='range' id='rSlider' min='0' max='255' value='255' oninput='setColor()'></div>
+<div class='slider-container'><div class='slider-label'><span>Green</span><span id='gVal'>255</span></div>
+<input type='range' id='gSlider' min='0' max='255' value='255' oninput='setColor()'></div>
+<div class='slider-container'><div class='slider-label'><span>Blue</span><span id='bSlider2'>255</span></div>
+<input type='range' id='blSlider' min='0' max='255' value='255' oninput='setColor()'></div>
+<div id='preview'></div>
+<div class='slider-container'><div class='slider-label'><span><input type='checkbox' id='wpOn' onchange='setWhitePoint()'> White Point (K)</span><span id='wpVal'>6500</span></div>
+<input type='range' id='wpSlider' min='1500' max='10000' step='100' value='6500' oninput='setWhitePoint()'></div>
+</div>
+<div class='panel'><h3>Presets</h3>
+<div id='presetList'></div>
+<div class='slider-container'><select id='presetSlot'></select></div>
+<button class='mode-btn' onclick='savePreset()'>Save Current</button>
+</div>
+<div class='panel' id='paramPanel' style='display:none'><h3 id='paramTitle'>Settings</h3>
+<div id='paramList'></div>
+</div>
+<div class='panel' id='palettePanel' style='display:none'><h3>Palette</h3>
+<div class='slider-container'><select id='palSelect' onchange='setPalette()'></select></div>
+</div>
+<script>
+var modes=['Normal','Campfire','Christmas','Warm Light','Beatsin','Aurora','Ocean','Lava'];
+var pend={},busy={},paramMode=-1;
+function send(k,u){pend[k]=u;if(!busy[k])flush(k);}
+function flush(k){var u=pend[k];if(!u){busy[k]=0;return;}pend[k]=null;busy[k]=1;
+Promise.all([fetch(u).catch(()=>0),new Promise(r=>setTimeout(r,50))]).then(()=>flush(k));}
+function updateStatus(){fetch('/status').then(r=>r.json()).then(d=>{
+document.getElementById('mode').textContent=modes[d.mode];
+document.getElementById('brightness').textContent=d.brightness;
+document.getElementById('r').textContent=d.red;
+document.getElementById('g').textContent=d.green;
+document.getElementById('b').textContent=d.blue;
+document.getElementById('rSlider').value=d.red;
+document.getElementById('gSlider').value=d.green;
+document.getElementById('blSlider').value=d.blue;
+document.getElementById('bSlider').value=d.brightness;
+document.getElementById('rVal').textContent=d.red;
+document.getElementById('gVal').textContent=d.green;
+document.getElementById('bSlider2').textContent=d.blue;
+document.getElementById('bVal').textContent=d.brightness;
+document.getElementById('wpOn').checked=d.whitePoint>0;
+if(d.whitePoint>0){document.getElementById('wpSlider').value=d.whitePoint;document.getElementById('wpVal').textContent=d.whitePoint;}
+updatePreview();highlightMode(d.mode);
+}).catch(err=>console.error(err));}
+function highlightMode(m){var btns=document.querySelectorAll('.mode-btn');
+btns.forEach((btn,i)=>{btn.classList.toggle('active',i===m);});
+if(m!==paramMode)loadParams(m);
+var pal=m===1||m===2||m>=5;
+document.getElementById('palettePanel').style.display=pal?'block':'none';
+if(pal)loadPalette();}
+function loadPalette(){fetch('/palette').then(r=>r.json()).then(d=>{
+var sel=document.getElementById('palSelect');
+if(!sel.options.length)d.palettes.forEach((n,i)=>{sel.add(new Option(n,i));});
+sel.value=d.selected;
+}).catch(err=>console.error(err));}
+function setPalette(){send('pal','/palette?id='+document.getElementById('palSelect').value);}
+function loadParams(m){paramMode=m;fetch('/params?mode='+m).then(r=>r.json()).then(d=>{
+var html='';d.params.forEach(p=>{
+html+="<div class='slider-container'><div class='slider-label'><span>"+p.label+"</span><span id='pv_"+p.name+"'>"+p.value+"</span></div>"+
+"<input type='range' min='"+p.min+"' max='"+p.max+"' step='"+p.step+"' value='"+p.value+"' oninput='setParam("+m+",\""+p.name+"\",this.value)'></div>";});
+document.getElementById('paramTitle').textContent=modes[m]+' Settings';
+document.getElementById('paramList').innerHTML=html;
+document.getElementById('paramPanel').style.display=d.params.length?'block':'none';
+}).catch(err=>{paramMode=-1;console.error(err);});}
+function setParam(m,n,v){document.getElementById('pv_'+n).textContent=v;
+send('p'+n,'/params?mode='+m+'&'+n+'='+v);}
+function updatePreview(){var r=document.getElementById('rSlider').value;
+var g=document.getElementById('gSlider').value;
+var b=document.getElementById('blSlider').value;
+document.getElementById('preview').style.backgroundColor='rgb('+r+','+g+','+b+')';}
+function setWhitePoint(){var k=document.getElementById('wpSlider').value;
+document.getElementById('wpVal').textContent=k;
+send('wp','/setWhitePoint?k='+(document.getElementById('wpOn').checked?k:0));}
+function setMode(m){fetch('/setMode?mode='+m).then(()=>setTimeout(updateStatus,100));}
+function setColor(){var r=document.getElementById('rSlider').value;
+var g=document.getElementById('gSlider').value;
+var b=document.getElementById('blSlider').value;
+document.getElementById('rVal').textContent=r;
+document.getElementById('gVal').textContent=g;
+document.getElementById('bSlider2').textContent=b;
+updatePreview();send('color','/setColor?r='+r+'&g='+g+'&b='+b);}
+function setBright(v){document.getElementById('bVal').textContent=v;
+send('bright','/setBrightness?value='+v);}
+function loadPresets(){fetch('/presets').then(r=>r.json()).then(d=>{
+var list='',opts='';d.presets.forEach(p=>{
+if(p.used)list+="<button class='mode-btn' onclick='recallPreset("+p.slot+")'>"+(p.slot+1)+": "+modes[p.mode]+"</button>";
+opts+="<option value='"+p.slot+"'>Slot "+(p.slot+1)+(p.used?' (used)':'')+"</option>";});
+document.getElementById('presetList').innerHTML=list;
+var sel=document.getElementById('presetSlot'),v=sel.value;sel.innerHTML=opts;if(v)sel.value=v;
+}).catch(err=>console.error(err));}
+function savePreset(){fetch('/savePreset?slot='+document.getElementById('presetSlot').value).then(loadPresets);}
+function recallPreset(n){fetch('/recallPreset?slot='+n).then(()=>setTimeout(updateStatus,100));}
+updateStatus();loadPresets();setInterval(updateStatus,3000);
+</script></body></html>)rawliteral";
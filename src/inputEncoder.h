@@ -0,0 +1,135 @@
+// 로터리 엔코더 / 버튼 입력
+// 인터럽트에서 표 기반 쿼드러처 상태 머신으로 한 칸(디텐트) 회전을 판정하고,
+// 이벤트를 락프리 단일 생산자/단일 소비자 링 버퍼에 넣는다. loop()는 프레임 시작 전에 이를 비운다.
+// 상태 머신 자체가 채터링을 걸러내므로 시간 기반 디바운스가 필요 없고, 빠르게 돌려도 칸을 놓치지 않는다.
+// ISR에서는 millis()/digitalRead() 대신 GPIO 입력 레지스터와 CPU 사이클 카운터만 사용한다.
+
+#define ENCODER_CLK_PIN 12  // D6 (GPIO 12)
+#define ENCODER_DT_PIN 13   // D7 (GPIO 13)
+#define ENCODER_SW_PIN 0    // D3 (GPIO 0, 부팅 시 HIGH 필요 - 풀업 버튼이므로 문제 없음)
+
+#define INPUT_QUEUE_SIZE 16          // 2의 거듭제곱
+#define BUTTON_DEBOUNCE_US 20000     // 버튼 채터링 무시 시간
+
+enum InputEventType {
+  INPUT_ROTATE = 0,
+  INPUT_BUTTON_PRESS = 1
+};
+
+struct InputEvent {
+  uint8_t type;
+  int8_t delta;     // 회전 방향 (+1 시계방향, -1 반시계방향)
+  uint32_t cycles;  // 발생 시각 (CPU 사이클)
+};
+
+// 풀스텝 쿼드러처 상태 표 (상태 x 입력 [CLK,DT] -> 다음 상태, 상위 비트는 방향)
+#define QUAD_START 0x0
+#define QUAD_CW_FINAL 0x1
+#define QUAD_CW_BEGIN 0x2
+#define QUAD_CW_NEXT 0x3
+#define QUAD_CCW_BEGIN 0x4
+#define QUAD_CCW_FINAL 0x5
+#define QUAD_CCW_NEXT 0x6
+#define QUAD_DIR_CW 0x10
+#define QUAD_DIR_CCW 0x20
+
+const uint8_t quadratureTable[7][4] = {
+  // 00             01              10              11
+  {QUAD_START,    QUAD_CW_BEGIN,  QUAD_CCW_BEGIN, QUAD_START},                   // START
+  {QUAD_CW_NEXT,  QUAD_START,     QUAD_CW_FINAL,  QUAD_START | QUAD_DIR_CW},     // CW_FINAL
+  {QUAD_CW_NEXT,  QUAD_CW_BEGIN,  QUAD_START,     QUAD_START},                   // CW_BEGIN
+  {QUAD_CW_NEXT,  QUAD_CW_BEGIN,  QUAD_CW_FINAL,  QUAD_START},                   // CW_NEXT
+  {QUAD_CCW_NEXT, QUAD_START,     QUAD_CCW_BEGIN, QUAD_START},                   // CCW_BEGIN
+  {QUAD_CCW_NEXT, QUAD_CCW_FINAL, QUAD_START,     QUAD_START | QUAD_DIR_CCW},    // CCW_FINAL
+  {QUAD_CCW_NEXT, QUAD_CCW_FINAL, QUAD_CCW_BEGIN, QUAD_START},                   // CCW_NEXT
+};
+
+// 상태 머신 한 단계 (핀 값만으로 동작하므로 하드웨어 없이 확인 가능)
+// pins: bit1 = CLK, bit0 = DT. 반환: +1/-1 (한 칸 완료), 0 (진행 중)
+inline int8_t IRAM_ATTR quadratureStep(uint8_t &state, uint8_t pins)
+{
+  state = quadratureTable[state & 0x0F][pins & 0x03];
+  if (state & QUAD_DIR_CW) return 1;
+  if (state & QUAD_DIR_CCW) return -1;
+  return 0;
+}
+
+// ISR(생산자)와 loop(소비자) 사이의 링 버퍼
+volatile uint8_t inputHead = 0;  // ISR만 씀
+volatile uint8_t inputTail = 0;  // loop만 씀
+InputEvent inputQueue[INPUT_QUEUE_SIZE];
+volatile uint32_t inputDropped = 0;
+
+uint8_t quadratureState = QUAD_START;
+uint32_t lastButtonEdgeCycles = 0;
+
+inline bool IRAM_ATTR pushInputEvent(uint8_t type, int8_t delta, uint32_t cycles)
+{
+  uint8_t head = inputHead;
+  uint8_t next = (head + 1) & (INPUT_QUEUE_SIZE - 1);
+  if (next == inputTail)
+  {
+    inputDropped++;
+    return false;
+  }
+  inputQueue[head].type = type;
+  inputQueue[head].delta = delta;
+  inputQueue[head].cycles = cycles;
+  inputHead = next;  // 데이터를 쓴 뒤에 head를 넘김
+  return true;
+}
+
+bool popInputEvent(InputEvent &event)
+{
+  uint8_t tail = inputTail;
+  if (tail == inputHead) return false;
+  event = inputQueue[tail];
+  inputTail = (tail + 1) & (INPUT_QUEUE_SIZE - 1);
+  return true;
+}
+
+void IRAM_ATTR encoderISR()
+{
+  uint32_t gpio = GPI;
+  uint8_t pins = (((gpio >> ENCODER_CLK_PIN) & 1) << 1) | ((gpio >> ENCODER_DT_PIN) & 1);
+  int8_t delta = quadratureStep(quadratureState, pins);
+  if (delta != 0)
+  {
+    pushInputEvent(INPUT_ROTATE, delta, ESP.getCycleCount());
+  }
+}
+
+void IRAM_ATTR buttonISR()
+{
+  uint32_t now = ESP.getCycleCount();
+  bool pressed = ((GPI >> ENCODER_SW_PIN) & 1) == 0;
+  if (now - lastButtonEdgeCycles < (uint32_t)BUTTON_DEBOUNCE_US * (F_CPU / 1000000))
+  {
+    return;  // 채터링
+  }
+  lastButtonEdgeCycles = now;
+  if (pressed)
+  {
+    pushInputEvent(INPUT_BUTTON_PRESS, 0, now);
+  }
+}
+
+void inputEncoderBegin()
+{
+  pinMode(ENCODER_CLK_PIN, INPUT_PULLUP);
+  pinMode(ENCODER_DT_PIN, INPUT_PULLUP);
+  pinMode(ENCODER_SW_PIN, INPUT_PULLUP);
+
+  attachInterrupt(digitalPinToInterrupt(ENCODER_CLK_PIN), encoderISR, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(ENCODER_DT_PIN), encoderISR, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(ENCODER_SW_PIN), buttonISR, CHANGE);
+}
+
+// 회전 속도에 따른 밝기 변화량 (칸 사이 간격이 짧을수록 크게)
+uint8_t encoderAcceleration(uint32_t intervalUs)
+{
+  if (intervalUs < 15000) return 16;
+  if (intervalUs < 40000) return 8;
+  if (intervalUs < 100000) return 4;
+  return 2;
+}
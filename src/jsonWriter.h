@@ -0,0 +1,135 @@
+// 고정 버퍼 JSON 작성기 및 정수 파서
+// 응답을 String +=로 만들지 않고 미리 잡아둔 버퍼에 바로 써서 요청마다 힙을 쓰지 않는다.
+// 버퍼가 부족하면 overflow가 설정되고 이후 쓰기는 무시된다.
+
+#define JSON_BUFFER_SIZE 2048  // /metrics가 가장 큼 (카운터가 커져도 약 1.7KB)
+
+char jsonBuffer[JSON_BUFFER_SIZE];  // 모든 핸들러가 공유 (loop 단일 스레드)
+
+class JsonWriter
+{
+public:
+  JsonWriter(char *buffer, size_t capacity)
+    : buf(buffer), cap(capacity), len(0), overflow(false), needComma(false)
+  {
+    buf[0] = '\0';
+  }
+
+  void beginObject() { separator(); append('{'); needComma = false; }
+  void endObject() { append('}'); needComma = true; }
+  void beginArray() { separator(); append('['); needComma = false; }
+  void endArray() { append(']'); needComma = true; }
+
+  void key(const char *name)
+  {
+    separator();
+    append('"');
+    append(name);
+    append('"');
+    append(':');
+    needComma = false;
+  }
+
+  void value(long v)
+  {
+    separator();
+    char digits[21];
+    char *p = digits + sizeof(digits);
+    unsigned long u = v < 0 ? 0UL - (unsigned long)v : (unsigned long)v;
+    do { *--p = '0' + u % 10; u /= 10; } while (u > 0);
+    if (v < 0) *--p = '-';
+    append(p, digits + sizeof(digits) - p);
+    needComma = true;
+  }
+
+  void value(unsigned long v)
+  {
+    separator();
+    char digits[20];
+    char *p = digits + sizeof(digits);
+    do { *--p = '0' + v % 10; v /= 10; } while (v > 0);
+    append(p, digits + sizeof(digits) - p);
+    needComma = true;
+  }
+
+  void value(int v) { value((long)v); }
+  void value(unsigned int v) { value((unsigned long)v); }
+  void value(bool v) { separator(); append(v ? "true" : "false"); needComma = true; }
+
+  // 이스케이프가 필요 없는 문자열만 사용 (모드 이름, 엔드포인트 이름 등)
+  void value(const char *v)
+  {
+    separator();
+    append('"');
+    append(v);
+    append('"');
+    needComma = true;
+  }
+
+  template <typename T>
+  void field(const char *name, T v)
+  {
+    key(name);
+    value(v);
+  }
+
+  const char *c_str() const { return buf; }
+  size_t length() const { return len; }
+  bool overflowed() const { return overflow; }
+
+private:
+  char *buf;
+  size_t cap;
+  size_t len;
+  bool overflow;
+  bool needComma;
+
+  void separator()
+  {
+    if (needComma) append(',');
+    needComma = false;
+  }
+
+  void append(char c)
+  {
+    if (len + 1 >= cap) { overflow = true; return; }
+    buf[len++] = c;
+    buf[len] = '\0';
+  }
+
+  void append(const char *s) { append(s, strlen(s)); }
+
+  void append(const char *s, size_t n)
+  {
+    if (len + n >= cap) { overflow = true; return; }
+    memcpy(buf + len, s, n);
+    len += n;
+    buf[len] = '\0';
+  }
+};
+
+// 10진 정수 문자열을 그대로 파싱 (String 복사 없음)
+// toInt()와 달리 숫자가 아닌 문자가 섞이면 실패로 처리한다.
+bool parseIntStrict(const char *s, int &out)
+{
+  if (s == nullptr || *s == '\0') return false;
+
+  bool negative = false;
+  if (*s == '-')
+  {
+    negative = true;
+    s++;
+  }
+  if (*s == '\0') return false;
+
+  int32_t value = 0;
+  while (*s)
+  {
+    if (*s < '0' || *s > '9') return false;
+    value = value * 10 + (*s - '0');
+    if (value > 1000000) return false;  // 이 API에서 쓰는 범위를 넘는 값
+    s++;
+  }
+  out = negative ? -value : value;
+  return true;
+}
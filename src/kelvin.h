@@ -0,0 +1,50 @@
+// 색온도(K) -> RGB 변환
+// 1500K ~ 10000K를 500K 간격으로 PROGMEM 표에 저장하고 사이 값은 선형 보간한다.
+// 설정이 바뀔 때 한 번만 계산하며 프레임마다 호출하지 않는다.
+
+#define KELVIN_MIN 1500
+#define KELVIN_MAX 10000
+#define KELVIN_STEP 500
+
+const uint8_t kelvinTable[][3] PROGMEM = {
+  {255, 109,   0},  // 1500K
+  {255, 147,  41},  // 2000K 촛불
+  {255, 164,  79},  // 2500K
+  {255, 180, 107},  // 3000K 따뜻한 백열등
+  {255, 196, 137},  // 3500K
+  {255, 209, 163},  // 4000K 중성 백색
+  {255, 219, 186},  // 4500K
+  {255, 228, 206},  // 5000K 주광색
+  {255, 236, 224},  // 5500K
+  {255, 243, 239},  // 6000K 차가운 백색
+  {255, 249, 253},  // 6500K
+  {245, 243, 255},  // 7000K
+  {235, 238, 255},  // 7500K
+  {227, 233, 255},  // 8000K
+  {220, 229, 255},  // 8500K
+  {214, 225, 255},  // 9000K
+  {208, 222, 255},  // 9500K
+  {204, 219, 255},  // 10000K
+};
+
+bool isValidKelvin(int kelvin)
+{
+  return kelvin >= KELVIN_MIN && kelvin <= KELVIN_MAX;
+}
+
+CRGB kelvinToRGB(uint16_t kelvin)
+{
+  kelvin = constrain(kelvin, KELVIN_MIN, KELVIN_MAX);
+  uint16_t offset = kelvin - KELVIN_MIN;
+  uint8_t index = offset / KELVIN_STEP;
+  uint16_t frac = offset % KELVIN_STEP;
+
+  CRGB color;
+  for (uint8_t c = 0; c < 3; c++)
+  {
+    int lo = pgm_read_byte(&kelvinTable[index][c]);
+    int hi = frac ? pgm_read_byte(&kelvinTable[index + 1][c]) : lo;
+    color[c] = lo + (hi - lo) * frac / KELVIN_STEP;
+  }
+  return color;
+}
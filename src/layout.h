@@ -0,0 +1,192 @@
+// 픽셀 배치(레이아웃) 매핑
+// 스트립 인덱스를 2D 위치로 바꾸는 표를 설정 변경 시 한 번만 계산해 둔다.
+//   layoutCol/layoutRow: 픽셀의 격자 좌표 (열, 행)
+//   layoutX/layoutY:     픽셀의 정규화 위치 (0~LAYOUT_COORD_MAX)
+//   layoutGrid:          격자 좌표 -> 픽셀 인덱스 (layoutXY()로 조회)
+// 효과는 픽셀마다 표를 한 번 읽는 것만으로 2D/정규화 공간에서 그릴 수 있다.
+// 사용자 정의 배치의 픽셀별 좌표는 EEPROM에만 두고 RAM에는 계산된 표만 유지한다.
+
+#define LAYOUT_ADDR 256            // EEPROM 위치 (장면 설정 뒤)
+#define LAYOUT_MAGIC 0x594C        // 'LY'
+#define LAYOUT_GRID_MAX MAX_LEDS   // 격자 표 최대 칸 수 (넘으면 격자 조회 없이 픽셀별 표만 사용)
+#define LAYOUT_NONE 0xFFFF         // 격자 칸에 픽셀 없음
+
+typedef uint16_t LayoutIndex;
+
+// 정규화 위치의 폭: 256픽셀 이하면 8비트로 모든 열/행이 구분되고, 그보다 긴 빌드(호스트 벤치마크 등)는
+// 이웃한 열/행이 같은 값으로 뭉치지 않도록 16비트 (LAYOUT_COORD_SHIFT만큼 오른쪽으로 밀면 0~255)
+#if MAX_LEDS > 256
+typedef uint16_t LayoutCoord;
+#define LAYOUT_COORD_SHIFT 8
+#else
+typedef uint8_t LayoutCoord;
+#define LAYOUT_COORD_SHIFT 0
+#endif
+#define LAYOUT_COORD_MAX ((1UL << (8 + LAYOUT_COORD_SHIFT)) - 1)
+static_assert(MAX_LEDS <= LAYOUT_COORD_MAX + 1, "1줄 배치에서 이웃 픽셀의 정규화 위치가 겹치지 않아야 함");
+
+enum LayoutType {
+  LAYOUT_LINEAR = 0,      // 1줄 (기존 동작)
+  LAYOUT_MATRIX = 1,      // 행마다 같은 방향
+  LAYOUT_SERPENTINE = 2,  // 행마다 방향이 바뀌는 지그재그
+  LAYOUT_CUSTOM = 3,      // 픽셀별 x/y 좌표 (업로드)
+  LAYOUT_TYPE_COUNT
+};
+
+struct __attribute__((packed)) LayoutHeader {
+  uint16_t magic;
+  uint8_t type;
+  uint16_t width;   // 격자 열 수
+  uint16_t height;  // 격자 행 수
+};
+
+// 사용자 정의 좌표: 헤더 바로 뒤에 픽셀마다 (x, y) 2바이트
+#define LAYOUT_COORDS_ADDR (LAYOUT_ADDR + sizeof(LayoutHeader))
+#define LAYOUT_END_ADDR (LAYOUT_COORDS_ADDR + MAX_LEDS * 2)
+
+LayoutType layoutType = LAYOUT_LINEAR;
+uint16_t layoutWidth = 1;
+uint16_t layoutHeight = 1;
+bool layoutGridValid = false;
+
+uint16_t layoutCol[MAX_LEDS];
+uint16_t layoutRow[MAX_LEDS];
+LayoutCoord layoutX[MAX_LEDS];
+LayoutCoord layoutY[MAX_LEDS];
+LayoutIndex layoutGrid[LAYOUT_GRID_MAX];
+
+const char *const layoutTypeNames[LAYOUT_TYPE_COUNT] = {
+  "linear", "matrix", "serpentine", "custom"
+};
+
+// 격자 좌표 -> 픽셀 인덱스 (없으면 LAYOUT_NONE)
+inline LayoutIndex layoutXY(uint16_t x, uint16_t y)
+{
+  if (!layoutGridValid || x >= layoutWidth || y >= layoutHeight) return LAYOUT_NONE;
+  return layoutGrid[y * layoutWidth + x];
+}
+
+// 0~(n-1) 값을 0~LAYOUT_COORD_MAX로 정규화
+inline LayoutCoord layoutNormalize(uint16_t v, uint16_t n)
+{
+  return n > 1 ? (uint32_t)v * LAYOUT_COORD_MAX / (n - 1) : 0;
+}
+
+// 정규화 위치의 상위 8비트 (0~255 기준으로 계산하는 효과용)
+inline uint8_t layoutCoord8(LayoutCoord v)
+{
+  return v >> LAYOUT_COORD_SHIFT;
+}
+
+// 크기 검사: 격자형 배치는 모든 픽셀이 격자 안에 들어가야 함
+bool isValidLayout(int type, int width, int height, int count)
+{
+  if (type < 0 || type >= LAYOUT_TYPE_COUNT) return false;
+  if (type == LAYOUT_LINEAR) return true;
+  if (width < 1 || height < 1 || width > 255 || height > 255) return false;
+  if (type == LAYOUT_CUSTOM) return true;
+  return width * height >= count;
+}
+
+// layoutCol/layoutRow로부터 격자 표 생성 (같은 칸에 여러 픽셀이면 앞 번호 우선)
+void layoutBuildGrid(int count)
+{
+  uint32_t cells = (uint32_t)layoutWidth * layoutHeight;
+  layoutGridValid = cells <= LAYOUT_GRID_MAX;
+  if (!layoutGridValid) return;
+
+  for (uint32_t c = 0; c < cells; c++) layoutGrid[c] = LAYOUT_NONE;
+  for (int i = count - 1; i >= 0; i--)
+  {
+    layoutGrid[layoutRow[i] * layoutWidth + layoutCol[i]] = i;
+  }
+}
+
+// 규칙형 배치 (1줄, 행렬, 지그재그) 표 계산
+void layoutBuild(LayoutType type, uint16_t width, uint16_t height, int count)
+{
+  if (type == LAYOUT_LINEAR)
+  {
+    width = count;
+    height = 1;
+  }
+  layoutType = type;
+  layoutWidth = width;
+  layoutHeight = height;
+
+  for (int i = 0; i < count; i++)
+  {
+    uint16_t row = i / width;
+    uint16_t col = i % width;
+    if (type == LAYOUT_SERPENTINE && (row & 1)) col = width - 1 - col;
+    layoutCol[i] = col;
+    layoutRow[i] = row;
+    layoutX[i] = layoutNormalize(col, width);
+    layoutY[i] = layoutNormalize(row, height);
+  }
+  layoutBuildGrid(count);
+}
+
+// 사용자 정의 배치 표 계산 (좌표는 EEPROM에서 읽음, 격자 크기는 width x height)
+void layoutBuildCustom(uint16_t width, uint16_t height, int count)
+{
+  layoutType = LAYOUT_CUSTOM;
+  layoutWidth = width;
+  layoutHeight = height;
+
+  for (int i = 0; i < count; i++)
+  {
+    uint8_t x = EEPROM.read(LAYOUT_COORDS_ADDR + i * 2);
+    uint8_t y = EEPROM.read(LAYOUT_COORDS_ADDR + i * 2 + 1);
+    layoutX[i] = (LayoutCoord)x * (LAYOUT_COORD_MAX / 255);  // 업로드 좌표는 8비트, 255가 끝
+    layoutY[i] = (LayoutCoord)y * (LAYOUT_COORD_MAX / 255);
+    layoutCol[i] = (uint16_t)x * width / 256;
+    layoutRow[i] = (uint16_t)y * height / 256;
+  }
+  layoutBuildGrid(count);
+}
+
+// 헤더를 EEPROM 캐시에 씀 (좌표는 layoutWriteCoords()로 따로 씀)
+// 플래시 커밋은 하지 않는다. 바꾸는 쪽은 requestStore(STORE_LAYOUT)로 예약하고
+// 예약된 지연 저장(saveSettings)이 이 함수를 부른 뒤 설정과 함께 한 번 커밋한다.
+void saveLayout()
+{
+  LayoutHeader header;
+  header.magic = LAYOUT_MAGIC;
+  header.type = layoutType;
+  header.width = layoutWidth;
+  header.height = layoutHeight;
+  EEPROM.put(LAYOUT_ADDR, header);
+}
+
+// 사용자 정의 좌표 일부 쓰기 (요청 크기 제한 때문에 나누어 업로드)
+bool layoutWriteCoords(int offset, const uint8_t *pairs, int pairCount)
+{
+  if (offset < 0 || offset + pairCount > MAX_LEDS) return false;
+  for (int i = 0; i < pairCount * 2; i++)
+  {
+    EEPROM.write(LAYOUT_COORDS_ADDR + offset * 2 + i, pairs[i]);
+  }
+  return true;
+}
+
+// 저장된 배치 불러오기 (없거나 잘못되었으면 1줄)
+void loadLayout(int count)
+{
+  LayoutHeader header;
+  EEPROM.get(LAYOUT_ADDR, header);
+  if (header.magic != LAYOUT_MAGIC || !isValidLayout(header.type, header.width, header.height, count))
+  {
+    layoutBuild(LAYOUT_LINEAR, count, 1, count);
+    return;
+  }
+
+  if (header.type == LAYOUT_CUSTOM)
+  {
+    layoutBuildCustom(header.width, header.height, count);
+  }
+  else
+  {
+    layoutBuild((LayoutType)header.type, header.width, header.height, count);
+  }
+}
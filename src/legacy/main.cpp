@@ -1,5 +1,10 @@
+// AVR(Arduino Uno) NeoPixel 펌웨어: 엔코더로 밝기, 버튼으로 모닥불/크리스마스 전환
+// 효과 계산은 ESP8266 펌웨어와 같은 커널(../effectKernels.h)을 쓰고, FastLED는 색/팔레트 계산에만 쓴다.
+// 커널은 NeoPixel 버퍼에 전송 순서로 바로 쓴다 (색 순서와 건너뛸 픽셀 수는 빌드 상수, platformio.ini [env:uno_legacy]).
 #include <Arduino.h>
 #include <Adafruit_NeoPixel.h>
+#include <FastLED.h>
+#include "../effectKernels.h"
 
 // 함수 선언
 void encoderISR();
@@ -15,18 +20,40 @@ void christmasMode();
 #define ENCODER_DT    3    // 로터리 엔코더 DT 핀 (D3)
 #define ENCODER_SW    4    // 로터리 엔코더 버튼 핀 (D4)
 
-// NeoPixel 설정
+// NeoPixel 설정 (빌드 플래그로 바꿀 수 있음)
+#ifndef NUM_PIXELS
 #define NUM_PIXELS    146  // LED 개수 (146개 전체)
+#endif
+#ifndef SKIP_PIXELS
 #define SKIP_PIXELS   18   // 앞쪽 18개는 항상 꺼진 상태로 유지
-// 색상 순서 옵션들 (녹색이 보이면 GRB가 맞는 것 같음)
-#define PIXEL_TYPE    (NEO_GRB + NEO_KHZ800)  // GRB 순서로 다시 변경
-//#define PIXEL_TYPE    (NEO_RGB + NEO_KHZ800)  // RGB 순서
-//#define PIXEL_TYPE    (NEO_BRG + NEO_KHZ800)  // BRG 순서
-//#define PIXEL_TYPE    (NEO_BGR + NEO_KHZ800)  // BGR 순서
+#endif
+#ifndef LED_COLOR_ORDER
+#define LED_COLOR_ORDER GRB  // 색상 순서 (녹색이 보이면 GRB가 맞는 것 같음, RGB/BRG/BGR ...)
+#endif
+#define LIT_PIXELS    (NUM_PIXELS - SKIP_PIXELS)  // 효과를 그리는 픽셀 수
+static_assert(SKIP_PIXELS < NUM_PIXELS, "SKIP_PIXELS must leave pixels to draw");
+
+// FastLED 색 순서를 NeoPixel 형식으로 (W 자리는 R과 같게)
+constexpr neoPixelType neoPixelOrder(EOrder order) {
+  return (orderByte(order, 0) << 6) | (orderByte(order, 0) << 4) | (orderByte(order, 1) << 2) | orderByte(order, 2);
+}
+#define PIXEL_TYPE    (neoPixelOrder(LED_COLOR_ORDER) + NEO_KHZ800)
 
 // NeoPixel 객체 생성
 Adafruit_NeoPixel strip(NUM_PIXELS, LED_PIN, PIXEL_TYPE);
 
+// 커널 출력: NeoPixel 버퍼에 전송 순서로, 앞쪽 SKIP_PIXELS개는 건너뜀
+typedef PackedSink<LED_COLOR_ORDER, SKIP_PIXELS> StripSink;
+
+StripSink stripSink() {
+  // setPixelColor()와 같은 밝기 계산 (getBrightness() + 1, 255면 256 = 그대로)
+  return {strip.getPixels(), (uint16_t)(strip.getBrightness() + 1)};
+}
+
+// 효과 팔레트 (setup()에서 채움)
+CRGBPalette16 campfirePalette;   // 빨간색 위주, 약간의 주황색 (완전히 꺼지지 않게 바닥값)
+CRGBPalette16 christmasPalette;  // XMAS_COLOR_A 빨강, XMAS_COLOR_B 초록, XMAS_STAR 흰색 별
+
 // 변수들 (메모리 최적화)
 volatile bool encoderChanged = false;
 volatile int encoderPos = 0;
@@ -68,6 +95,13 @@ void setup() {
   attachInterrupt(digitalPinToInterrupt(ENCODER_CLK), encoderISR, CHANGE);
   attachInterrupt(digitalPinToInterrupt(ENCODER_DT), encoderISR, CHANGE);
   
+  // 효과 팔레트: 모닥불은 빨간색의 1/5만 초록, 파란색 없음
+  for (int i = 0; i < 16; i++) {
+    byte intensity = i * 17;
+    campfirePalette[i] = CRGB(max(intensity, (byte)25), max((byte)(intensity / 5), (byte)12), 0);
+    christmasPalette[i] = i < 8 ? CRGB(255, 0, 0) : i < 14 ? CRGB(0, 255, 0) : CRGB(255, 255, 200);
+  }
+
   // NeoPixel 초기화
   strip.begin();
   strip.show(); // 모든 픽셀 OFF로 초기화
@@ -192,19 +226,13 @@ void handleButton() {
 // 모닥불 모드 (메모리 극도 최적화)
 void campfireMode() {
   static unsigned long lastUpdate = 0;
-  static byte firePixels[NUM_PIXELS]; // 각 픽셀의 현재 불꽃 강도 (byte로 최적화: 1바이트)
-  static byte targetPixels[NUM_PIXELS]; // 각 픽셀의 목표 강도 (byte로 최적화: 1바이트)
+  static byte firePixels[LIT_PIXELS]; // 각 픽셀의 현재 불꽃 강도 (byte로 최적화: 1바이트, 앞쪽 18개 제외)
+  static byte targetPixels[LIT_PIXELS]; // 각 픽셀의 목표 강도 (byte로 최적화: 1바이트)
   static bool initialized = false;
   
-  // 초기화 (앞쪽 18개는 제외하고 나머지만)
+  // 초기화 (랜덤 값으로)
   if (!initialized) {
-    // 앞쪽 18개는 0으로 초기화
-    for (int i = 0; i < SKIP_PIXELS; i++) {
-      firePixels[i] = 0;
-      targetPixels[i] = 0;
-    }
-    // 나머지는 랜덤 값으로 초기화
-    for (int i = SKIP_PIXELS; i < NUM_PIXELS; i++) {
+    for (int i = 0; i < LIT_PIXELS; i++) {
       firePixels[i] = random(50, 200);
       targetPixels[i] = firePixels[i];
     }
@@ -212,45 +240,10 @@ void campfireMode() {
   }
   
   if (millis() - lastUpdate > 70) { // 70ms마다 업데이트 (메모리 최적화를 위해 속도 조정)
-    
-    // 앞쪽 18개는 건드리지 않고 나머지에만 모닥불 효과 적용
-    for (int i = SKIP_PIXELS; i < NUM_PIXELS; i++) {
-      
-      // 가끔씩 새로운 목표값 설정 (15% 확률)
-      if (random(0, 100) < 15) {
-        targetPixels[i] = random(40, 220);
-      }
-      
-      // 현재 값을 목표값으로 부드럽게 이동 (스무딩)
-      int diff = (int)targetPixels[i] - (int)firePixels[i];
-      firePixels[i] += diff / 10; // 1/10씩 천천히 변화
-      
-      // 인근 픽셀들의 영향 추가 (불꽃 확산 효과)
-      if (i > 0 && i < NUM_PIXELS - 1) {
-        int neighborAvg = ((int)firePixels[i-1] + (int)firePixels[i+1]) / 2;
-        firePixels[i] = ((int)firePixels[i] * 4 + neighborAvg) / 5; // 20% 인근 영향
-      }
-      
-      // 밝기 설정에 따른 전체 강도 조절
-      int scaledIntensity = map(firePixels[i], 0, 255, 0, brightness);
-      
-      // 모닥불 색상: 주로 빨간색, 약간의 주황색
-      int red = scaledIntensity;
-      int green = scaledIntensity / 5; // 빨간색의 1/5만 사용
-      int blue = 0; // 파란색은 완전히 제거
-      
-      // 가끔씩 더 밝은 불꽃 효과 (5% 확률로 줄임)
-      if (random(0, 100) < 5) {
-        red = min(255, red + random(20, 50));
-        green = min(60, green + random(5, 15)); // 녹색 더 제한
-      }
-      
-      // 최소 밝기 보장 (완전히 꺼지지 않게)
-      red = max(red, brightness / 10);
-      green = max(green, brightness / 20);
-      
-      strip.setPixelColor(i, strip.Color(red, green, blue));
-    }
+    // 15% 확률로 새 목표값, 5% 확률로 더 밝은 불꽃, 20% 인근 영향 (ESP8266 펌웨어와 같은 커널)
+    CampfireKernel<LIT_PIXELS, StripSink> kernel = {firePixels, targetPixels, stripSink(), &campfirePalette,
+                                                    nullptr, 15, 5, true};
+    kernel();
     
     strip.show();
     lastUpdate = millis();
@@ -260,83 +253,25 @@ void campfireMode() {
 // 크리스마스 모드
 void christmasMode() {
   static unsigned long lastUpdate = 0;
-  static unsigned long patternStart = 0;
-  static int phase = 0; // 0: 빨간색 켜짐, 1: 초록색 켜짐, 2: 둘 다 반짝임
-  static bool sparkleState = false;
+  static int loggedPhase = -1;
   
   if (millis() - lastUpdate > 250) { // 250ms마다 업데이트 (메모리 최적화)
     
-    // 3초마다 패턴 변경
-    if (millis() - patternStart > 3000) {
-      phase = (phase + 1) % 3;
-      patternStart = millis();
+    // 3초마다 패턴 변경 (0: 빨간색 켜짐, 1: 초록색 켜짐, 2: 둘 다 반짝임)
+    unsigned long now = millis();
+    int phase = (now / 3000) % 3;
+    if (phase != loggedPhase) {
+      loggedPhase = phase;
       Serial.print("크리스마스 패턴: ");
       if (phase == 0) Serial.println("빨간색");
       else if (phase == 1) Serial.println("초록색");
       else Serial.println("반짝임");
     }
     
-    // 앞쪽 18개는 항상 꺼진 상태로 유지
-    for (int i = 0; i < SKIP_PIXELS; i++) {
-      strip.setPixelColor(i, strip.Color(0, 0, 0));
-    }
-    
-    // 나머지 LED들에 크리스마스 패턴 적용
-    for (int i = SKIP_PIXELS; i < NUM_PIXELS; i++) {
-      int red = 0, green = 0, blue = 0;
-      
-      if (phase == 0) {
-        // 빨간색 위주, 가끔 초록색
-        if (i % 4 == 0 || i % 4 == 1) {
-          red = map(brightness, 0, 255, 0, 255);   // 빨간색
-          green = 0;
-        } else {
-          red = 0;
-          green = map(brightness, 0, 255, 0, 255); // 초록색
-        }
-      } 
-      else if (phase == 1) {
-        // 초록색 위주, 가끔 빨간색
-        if (i % 4 == 0 || i % 4 == 1) {
-          red = 0;
-          green = map(brightness, 0, 255, 0, 255); // 초록색
-        } else {
-          red = map(brightness, 0, 255, 0, 255);   // 빨간색
-          green = 0;
-        }
-      }
-      else {
-        // 둘 다 반짝임
-        sparkleState = !sparkleState;
-        if (sparkleState) {
-          if (i % 2 == 0) {
-            red = map(brightness, 0, 255, 0, 255);
-            green = 0;
-          } else {
-            red = 0;
-            green = map(brightness, 0, 255, 0, 255);
-          }
-        } else {
-          // 약간 어둡게
-          if (i % 2 == 0) {
-            red = map(brightness, 0, 255, 0, 100);
-            green = 0;
-          } else {
-            red = 0;
-            green = map(brightness, 0, 255, 0, 100);
-          }
-        }
-      }
-      
-      // 가끔씩 흰색 반짝임 추가 (별 효과)
-      if (random(0, 100) < 3) {
-        red = map(brightness, 0, 255, 0, 255);
-        green = map(brightness, 0, 255, 0, 255);
-        blue = map(brightness, 0, 255, 0, 200);
-      }
-      
-      strip.setPixelColor(i, strip.Color(red, green, blue));
-    }
+    // 앞쪽 18개는 건드리지 않음 (setAllPixels()에서 꺼 둠), 3% 확률로 흰색 별
+    ChristmasKernel<LIT_PIXELS, StripSink> kernel = {stripSink(), &christmasPalette, (uint32_t)(now / 250),
+                                                     (uint8_t)phase, 3};
+    kernel();
     
     strip.show();
     lastUpdate = millis();
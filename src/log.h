@@ -0,0 +1,103 @@
+// 비동기 로그
+// LOG_ERROR/LOG_WARN/LOG_INFO/LOG_DEBUG는 한 줄을 고정 크기 링 버퍼에 써 두기만 하고,
+// logFlush()가 loop마다 UART 송신 FIFO에 남은 만큼만 내보낸다. Serial.print처럼 FIFO가 찰 때 loop가 멈추지 않는다.
+// 버퍼가 가득 차면 줄 단위로 버리고 개수를 센다.
+// LOG_LEVEL보다 낮은 등급의 호출은 컴파일 시점에 인자 계산까지 모두 제거된다 (platformio.ini build_flags).
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_BUFFER_SIZE 1024  // 2의 거듭제곱
+#define LOG_LINE_SIZE 128     // 한 줄 최대 길이 (넘으면 잘림)
+
+struct LogStats {
+  uint32_t lines;         // 버퍼에 들어간 줄 수
+  uint32_t dropped;       // 버퍼가 가득 차 버린 줄 수
+  uint16_t highWater;     // 버퍼 최대 사용량 (바이트)
+};
+
+char logBuffer[LOG_BUFFER_SIZE];
+uint16_t logHead = 0;  // 다음에 쓸 위치
+uint16_t logTail = 0;  // 다음에 내보낼 위치
+LogStats logStats;
+
+inline uint16_t logUsed()
+{
+  return (logHead - logTail) & (LOG_BUFFER_SIZE - 1);
+}
+
+// 형식 문자열(PROGMEM)로 한 줄을 만들어 버퍼에 넣음
+void logWrite(PGM_P format, ...) __attribute__((format(printf, 1, 2)));
+void logWrite(PGM_P format, ...)
+{
+  char line[LOG_LINE_SIZE];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf_P(line, sizeof(line) - 1, format, args);
+  va_end(args);
+  if (length < 0) return;
+  if (length > (int)sizeof(line) - 2) length = sizeof(line) - 2;
+  line[length++] = '\n';
+
+  // 한 칸은 비워 둠 (head == tail은 빈 버퍼)
+  if (logUsed() + length > LOG_BUFFER_SIZE - 1)
+  {
+    logStats.dropped++;
+    return;
+  }
+  for (int i = 0; i < length; i++)
+  {
+    logBuffer[logHead] = line[i];
+    logHead = (logHead + 1) & (LOG_BUFFER_SIZE - 1);
+  }
+  logStats.lines++;
+  uint16_t used = logUsed();
+  if (used > logStats.highWater) logStats.highWater = used;
+}
+
+// 송신 FIFO에 들어갈 만큼만 내보냄 (기다리지 않음)
+void logFlush()
+{
+  while (logHead != logTail)
+  {
+    int room = Serial.availableForWrite();
+    if (room <= 0) return;
+
+    // 버퍼 끝에서 잘리지 않는 연속 구간만 한 번에 씀
+    uint16_t contiguous = (logHead > logTail ? logHead : LOG_BUFFER_SIZE) - logTail;
+    uint16_t n = min((uint16_t)room, contiguous);
+    Serial.write((const uint8_t *)logBuffer + logTail, n);
+    logTail = (logTail + n) & (LOG_BUFFER_SIZE - 1);
+  }
+}
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(format, ...) logWrite(PSTR(format), ##__VA_ARGS__)
+#else
+#define LOG_ERROR(format, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(format, ...) logWrite(PSTR(format), ##__VA_ARGS__)
+#else
+#define LOG_WARN(format, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(format, ...) logWrite(PSTR(format), ##__VA_ARGS__)
+#else
+#define LOG_INFO(format, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(format, ...) logWrite(PSTR(format), ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(format, ...) do {} while (0)
+#endif
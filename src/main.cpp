@@ -1,5 +1,4 @@
 // library import
-#include <ESP8266WebServer.h>  // For Web Server
 #include <ESP8266WiFi.h>       // For WiFi AP mode
 #include <SPI.h>               // For OLED
 #include <Wire.h>              // For OLED
@@ -9,414 +8,910 @@
 #include "externalFunc.h"
 #include <FastLED.h>
 #include <EEPROM.h>            // For saving mode to internal storage
+#include "log.h"               // 링 버퍼 비동기 로그
+#include "jsonWriter.h"        // 고정 버퍼 JSON 작성기
+#include "trace.h"             // 이벤트 추적 (비행 기록기)
+#include "indexHtml.h"         // 메인 페이지 HTML (PROGMEM)
+#include "webServer.h"         // 논블로킹 웹 서버
+#include "metrics.h"           // 요청 지연/힙 통계
+#include "udpControl.h"        // UDP 바이너리 제어
+#include "mqttClient.h"        // MQTT (Home Assistant)
+#include "frameSync.h"         // 조명 간 애니메이션 시계 동기화
+#include "idlePower.h"         // 유휴 절전
+#include "kelvin.h"            // 색온도 -> RGB 표
+#include "effectArena.h"       // 효과 공유 스크래치 영역
+#include "inputEncoder.h"      // 로터리 엔코더/버튼 입력
+#include "layout.h"            // 픽셀 배치(2D) 매핑
+#include "effectParams.h"      // 효과 설정 항목 표
+#include "commandIntake.h"     // 설정 변경 명령 병합
+#include "palettes.h"          // 팔레트 라이브러리 (PROGMEM, 전환, 업로드)
+#include "noiseField.h"        // 고정소수점 노이즈 (오로라/바다/용암)
+#include "bootStages.h"        // 단계별 부팅
+#include "frameInterp.h"       // 시뮬레이션 단계 사이 프레임 보간
+#include "renderChunks.h"      // 청크 단위 단계 계산
+#include "effectKernels.h"     // 효과 단계 커널 (ESP8266/AVR 펌웨어 공용)
+#include "compositor.h"        // 레이어 합성
+#include "outputSink.h"        // 프레임 출력 대상 (스트립, UDP 미리보기)
+#include "framePacer.h"        // 프레임 간격 타이머
+#include "qualityGovernor.h"   // 적응형 품질 조절
 
-ESP8266WebServer server(80);  // 웹 서버 (포트 80)
+LightWebServer server(80);  // 웹 서버 (포트 80)
+#define HTTP_IO_BUDGET_US 3000  // loop 한 번에 웹 서버 입출력에 쓰는 최대 시간
 
 CRGB leds[MAX_LEDS];  // 최대 크기로 배열 선언, 실제는 NUMPIXELS만큼 사용
+CRGB *frame = leds;   // 효과가 그리는 버퍼 (레이어 합성 중에는 레이어 버퍼)
 
 // EEPROM 설정
-#define EEPROM_SIZE 12
-#define EEPROM_MODE_ADDR 0
-#define EEPROM_RED_ADDR 1
-#define EEPROM_GREEN_ADDR 2
-#define EEPROM_BLUE_ADDR 3
-#define EEPROM_BRIGHTNESS_ADDR 4
-// Warm Light 설정 주소
-#define EEPROM_WARM_COLORTEMP_ADDR 5
-#define EEPROM_WARM_CHANCE_ADDR 6
-#define EEPROM_WARM_MIN_ADDR 7
-#define EEPROM_WARM_MAX_ADDR 8
-#define EEPROM_WARM_SPEED_ADDR 9
-#define EEPROM_WARM_SMOOTH_ADDR 10
-
-// 모드 정의
-enum Mode {
-  NORMAL_MODE = 0,
-  CAMPFIRE_MODE = 1,
-  CHRISTMAS_MODE = 2,
-  WARMLIGHT_MODE = 3,
-  BEATSIN_MODE = 4
+// 현재 장면과 프리셋 뱅크를 하나의 고정 크기 레코드(StoredSettings)로 저장한다.
+#define EEPROM_SIZE ((PALETTE_END_ADDR + 255) / 256 * 256)  // 장면 설정(0~) + 픽셀 배치(LAYOUT_ADDR~) + 팔레트, 기기는 768
+#define SETTINGS_ADDR 0
+#define SETTINGS_MAGIC 0x4D4C  // 'ML'
+#define SETTINGS_VERSION 5
+#define PRESET_COUNT 8
+
+// 장면: 모드, 색상, 밝기, 모든 효과 설정
+struct __attribute__((packed)) SceneRecord {
+  uint8_t mode;
+  uint8_t red;
+  uint8_t green;
+  uint8_t blue;
+  uint8_t brightness;
+  uint16_t warmColorTemp;
+  uint8_t warmChangeChance;
+  uint8_t warmMinBrightness;
+  uint8_t warmMaxBrightness;
+  uint8_t warmUpdateSpeed;
+  uint8_t warmSmoothness;
+  uint16_t whitePoint;  // 노말 모드 백색점 (K), 0이면 보정 안 함
+  uint8_t noiseScale;   // 노이즈 모드 공간 배율 (버전 3부터)
+  uint8_t noiseSpeed;   // 노이즈 모드 시간 속도
+  uint8_t palette;      // 팔레트 (0이면 모드별 기본), 모닥불/크리스마스/노이즈 모드
+  uint8_t fireSpeed;    // 모닥불 단계 간격 (ms, 버전 4부터)
+  uint8_t fireChange;   // 모닥불 목표 변경 확률 (%)
+  uint8_t fireSpark;    // 모닥불 불꽃 튐 확률 (%)
+  uint16_t xmasSpeed;   // 크리스마스 단계 간격 (ms)
+  uint8_t xmasStar;     // 크리스마스 별 반짝임 확률 (%)
+  uint8_t xmasHold;     // 크리스마스 패턴 유지 시간 (초)
+};
+
+// 이전 버전 장면 레코드 크기 (마이그레이션용)
+#define SCENE_RECORD_V2_SIZE offsetof(SceneRecord, noiseScale)  // 노이즈 설정 이전
+#define SCENE_RECORD_V3_SIZE offsetof(SceneRecord, fireSpeed)   // 모닥불/크리스마스 설정 이전
+#define SCENE_RECORD_V4_SIZE sizeof(SceneRecord)                 // 형식은 같고 빨강/초록만 바뀜
+
+struct __attribute__((packed)) StoredSettings {
+  uint16_t magic;
+  uint8_t version;
+  uint8_t syncRole;
+  SceneRecord current;
+  SceneRecord presets[PRESET_COUNT];
+  uint8_t presetUsed;  // 비트마스크 (bit n = 슬롯 n 저장됨)
+  uint8_t checksum;
 };
+
+// 이전 버전 바이트 단위 레이아웃 (마이그레이션용)
+#define LEGACY_MODE_ADDR 0
+#define LEGACY_RED_ADDR 1
+#define LEGACY_BRIGHTNESS_ADDR 4
+#define LEGACY_WARM_COLORTEMP_ADDR 5
+
+static_assert(SETTINGS_ADDR + sizeof(StoredSettings) <= LAYOUT_ADDR, "settings overlap layout");
+static_assert(PALETTE_END_ADDR <= EEPROM_SIZE, "palette exceeds EEPROM size");
+
+StoredSettings settings;
+
 Mode currentMode;  // EEPROM에서 불러온 값으로 초기화됨
 
-// Warm Light 모드 설정
-int warmColorTemp = 3000;  // 색온도 (2000, 3000, 4000, 5000, 6000)
-int warmChangeChance = 20;  // 밝기 변화 확률 (0-100%)
-int warmMinBrightness = 0;  // 최소 밝기 (0-255)
-int warmMaxBrightness = 255;  // 최대 밝기 (0-255)
-int warmUpdateSpeed = 50;  // 업데이트 속도 (ms)
-int warmSmoothness = 8;  // 전환 부드러움 (1-20, 낮을수록 빠름)
+// 효과 설정 항목 (effectParams.h), 순서는 paramTable과 같아야 함
+enum ParamId {
+  PARAM_WARM_TEMP = 0,
+  PARAM_WARM_CHANCE,
+  PARAM_WARM_MIN,
+  PARAM_WARM_MAX,
+  PARAM_WARM_SPEED,
+  PARAM_WARM_SMOOTH,
+  PARAM_NOISE_SCALE,
+  PARAM_NOISE_SPEED,
+  PARAM_FIRE_SPEED,
+  PARAM_FIRE_CHANGE,
+  PARAM_FIRE_SPARK,
+  PARAM_XMAS_SPEED,
+  PARAM_XMAS_STAR,
+  PARAM_XMAS_HOLD,
+  PARAM_COUNT
+};
+
+#define NOISE_MODES (MODE_BIT(AURORA_MODE) | MODE_BIT(OCEAN_MODE) | MODE_BIT(LAVA_MODE))
+#define SCENE_OFFSET(field) offsetof(SceneRecord, field)
+
+constexpr ParamDesc paramTable[PARAM_COUNT] = {
+  // 이름, 표시 이름, 모드, 저장 크기, 최소, 최대, 기본값, 간격, 레코드 위치
+  {"temp", "Color Temperature (K)", MODE_BIT(WARMLIGHT_MODE), PARAM_U16, KELVIN_MIN, KELVIN_MAX, 3000, 100, SCENE_OFFSET(warmColorTemp)},
+  {"chance", "Change Rate (%)", MODE_BIT(WARMLIGHT_MODE), PARAM_U8, 1, 100, 20, 1, SCENE_OFFSET(warmChangeChance)},
+  {"min", "Min Brightness", MODE_BIT(WARMLIGHT_MODE), PARAM_U8, 0, 255, 0, 1, SCENE_OFFSET(warmMinBrightness)},
+  {"max", "Max Brightness", MODE_BIT(WARMLIGHT_MODE), PARAM_U8, 0, 255, 255, 1, SCENE_OFFSET(warmMaxBrightness)},
+  {"speed", "Speed (ms)", MODE_BIT(WARMLIGHT_MODE), PARAM_U8, 20, 200, 50, 1, SCENE_OFFSET(warmUpdateSpeed)},
+  {"smooth", "Smoothness", MODE_BIT(WARMLIGHT_MODE), PARAM_U8, 1, 20, 8, 1, SCENE_OFFSET(warmSmoothness)},
+  {"scale", "Scale", NOISE_MODES, PARAM_U8, 1, 255, 40, 1, SCENE_OFFSET(noiseScale)},
+  {"speed", "Speed", NOISE_MODES, PARAM_U8, 1, 255, 30, 1, SCENE_OFFSET(noiseSpeed)},
+  {"speed", "Step (ms)", MODE_BIT(CAMPFIRE_MODE), PARAM_U8, 20, 250, 70, 5, SCENE_OFFSET(fireSpeed)},
+  {"change", "Change Rate (%)", MODE_BIT(CAMPFIRE_MODE), PARAM_U8, 1, 100, 15, 1, SCENE_OFFSET(fireChange)},
+  {"spark", "Spark Rate (%)", MODE_BIT(CAMPFIRE_MODE), PARAM_U8, 0, 50, 5, 1, SCENE_OFFSET(fireSpark)},
+  {"speed", "Step (ms)", MODE_BIT(CHRISTMAS_MODE), PARAM_U16, 50, 1000, 250, 10, SCENE_OFFSET(xmasSpeed)},
+  {"star", "Star Rate (%)", MODE_BIT(CHRISTMAS_MODE), PARAM_U8, 0, 30, 3, 1, SCENE_OFFSET(xmasStar)},
+  {"hold", "Pattern Hold (s)", MODE_BIT(CHRISTMAS_MODE), PARAM_U8, 1, 30, 3, 1, SCENE_OFFSET(xmasHold)}
+};
+const uint8_t paramCount = PARAM_COUNT;
+static_assert(PARAM_COUNT <= PARAM_MAX, "too many effect params");
+static_assert(!paramNamesClash(paramTable, PARAM_COUNT), "duplicate effect param name within a mode");
+
+// Warm Light 색온도에 해당하는 RGB (색온도가 바뀔 때만 계산)
+CRGB warmBaseColor = CRGB(255, 180, 107);
+
+// 노말 모드 백색점 (0이면 보정 안 함)
+uint16_t normalWhitePoint = 0;
+
+// 팔레트를 쓰는 모드의 팔레트 선택 (PALETTE_AUTO면 모드별 기본)
+uint8_t paletteSel = PALETTE_AUTO;
+
+// 효과 상태 (effectArena에 겹쳐서 배치, 모드 전환 시 0으로 초기화됨)
+struct NormalState {
+  bool drawn;
+  CRGB lastColor;
+};
+
+struct CampfireState {
+  bool initialized;
+  uint32_t lastStep;
+  ChunkJob job;
+  byte firePixels[MAX_LEDS];   // 각 픽셀의 현재 불꽃 강도
+  byte targetPixels[MAX_LEDS]; // 각 픽셀의 목표 강도
+  InterpFrames keyframes;      // 단계 사이 보간용 (frameInterp.h)
+};
+
+struct ChristmasState {
+  uint32_t lastStep;
+  ChunkJob job;
+  uint8_t loggedPhase;  // 마지막으로 출력한 패턴 + 1 (0이면 아직 없음)
+  InterpFrames keyframes;
+};
+
+struct WarmLightState {
+  bool initialized;
+  uint32_t lastStep;
+  ChunkJob job;
+  byte warmPixels[MAX_LEDS];   // 각 픽셀의 현재 밝기
+  byte targetPixels[MAX_LEDS]; // 각 픽셀의 목표 밝기
+};
+
+struct NoiseState {
+  uint32_t lastStep;
+};
+
+// 가장 큰 효과 상태만큼만 RAM을 잡음 (효과 추가 시 여기에 등록)
+constexpr size_t EFFECT_ARENA_SIZE = arenaMax(sizeof(NormalState),
+                                              sizeof(CampfireState),
+                                              sizeof(ChristmasState),
+                                              sizeof(WarmLightState),
+                                              sizeof(NoiseState));
+alignas(4) uint8_t effectArena[EFFECT_ARENA_SIZE];
+const size_t effectArenaSize = EFFECT_ARENA_SIZE;
+
+bool displayReady = false;     // OLED 초기화 완료 (부팅 단계에서 설정)
+bool displayDeferred = false;  // 품질 조절로 미룬 OLED 갱신이 있음
+bool redrawRequested = true;   // 모드 전환 등으로 전체를 다시 그려야 할 때
+Mode renderedMode;             // 마지막으로 그린 모드
+uint8_t shownBrightness = 0;   // 마지막 FastLED.show() 때의 밝기
 
 // 함수 선언
-void campfireMode();
-void christmasMode();
-void normalMode();
-void warmLightMode();
-void beatsinMode();
+bool renderAndOutput();
+bool renderFrame();
+bool renderCurrentMode();
+bool renderMode(Mode mode);
+bool renderBase();
+bool renderOverlays(bool baseChanged);
+bool interpolateStep(Mode mode, InterpState &state, bool stepped);
+uint16_t modeStepPeriod(Mode mode);
+InterpFrames *modeKeyframes(Mode mode);
+bool campfireMode();
+bool christmasMode();
+bool normalMode();
+bool warmLightMode();
+bool beatsinMode();
+bool noiseMode();
+void selectPalette();
 void updateDisplay();
 const char* getModeText();
-void saveModeToEEPROM(Mode mode);
-Mode loadModeFromEEPROM();
-void saveColorToEEPROM(uint8_t r, uint8_t g, uint8_t b, uint8_t brightness);
-void loadColorFromEEPROM();
-void saveWarmConfigToEEPROM();
-void loadWarmConfigFromEEPROM();
+const char* getModeName(Mode mode);
+void captureScene(SceneRecord &scene);
+bool applyScene(const SceneRecord &scene);
+void saveSettings();
+void loadSettings();
+void defaultSceneTail(SceneRecord &scene, size_t from);
+bool recallPreset(uint8_t slot);
+void applyWhitePoint();
+void applyInputEvents();
+void applyPendingCommands();
 void setupWebServer();
 void handleRoot();
 void handleStatus();
 void handleSetMode();
 void handleSetColor();
 void handleSetBrightness();
-void handleSetWarmConfig();
-void handleGetWarmConfig();
+void handleParams();
+void handleMetrics();
+void handleSync();
+void handlePresets();
+void handleSavePreset();
+void handleRecallPreset();
+void handleSetWhitePoint();
+void handleLayout();
+void handlePalette();
+void handleLayers();
+void handleTrace();
+void handleOutput();
+void bootStep();
+void applyQualityLevel();
 
 void setup()
 {
   Serial.begin(115200);
+  resetMetrics();
+  traceRecord(TRACE_MARK, TRACE_MARK_BOOT, 0);
 
   pinMode(LEDSPIN, OUTPUT);
   
-  // EEPROM 초기화 및 저장된 모드/색상 불러오기
+  // EEPROM 초기화 및 저장된 장면 불러오기
   EEPROM.begin(EEPROM_SIZE);
-  currentMode = loadModeFromEEPROM();
-  loadColorFromEEPROM();
-  loadWarmConfigFromEEPROM();
-  Serial.print("저장된 모드 불러오기: ");
-  Serial.print(currentMode);
-  Serial.print(" (");
-  Serial.print(getModeText());
-  Serial.println(")");
-  Serial.print("저장된 RGB: ");
-  Serial.print(mr); Serial.print(", ");
-  Serial.print(mg); Serial.print(", ");
-  Serial.println(mb);
-  Serial.print("저장된 밝기: ");
-  Serial.println(FastLED.getBrightness());
-
-  // AP 모드 설정
-  WiFi.mode(WIFI_AP);
-  WiFi.softAP(ssid_ap, password_ap);
-  
-  Serial.println("\nAP 모드 시작!");
-  Serial.print("SSID: ");
-  Serial.println(ssid_ap);
-  Serial.print("IP 주소: ");
-  Serial.println(WiFi.softAPIP());
-  
-  DisplaySetup();  // OLED 디스플레이 설정
-  delay(2000);  // IP 정보 표시 시간
-  
-  // 현재 상태 표시
-  updateDisplay();
-
-  // 웹 서버 설정
-  setupWebServer();
-  server.begin();
-  Serial.println("웹 서버 시작됨 (포트 80)");
+  loadCustomPalette();  // 장면의 팔레트 선택이 사용자 팔레트일 수 있으므로 먼저
+  loadSettings();
+  loadLayout(NUMPIXELS);
 
-  FastLED.addLeds<WS2812B, LEDSPIN, GRB>(leds, NUMPIXELS);
-  // FastLED.setBrightness()는 loadColorFromEEPROM()에서 이미 설정됨
+  // LED 출력을 가장 먼저 준비하고 저장된 장면을 바로 그림
+  FastLED.addLeds<WS2812B, LEDSPIN, LED_COLOR_ORDER>(leds, NUMPIXELS);
+  // FastLED.setBrightness()는 loadSettings()에서 이미 설정됨
   FastLED.setMaxPowerInVoltsAndMilliamps(5, 10000); // 170개 LED용: 5V, 10000mA (10A)
   FastLED.clear();
+
+  // 애니메이션 시계 동기화 역할 불러오기 (첫 프레임부터 같은 시계 사용)
+  frameSyncBegin(settings.syncRole <= SYNC_FOLLOWER ? (SyncRole)settings.syncRole : SYNC_OFF);
+
+  renderedMode = currentMode;
+  resetEffectArena();  // 화이트 포인트와 팔레트는 loadSettings()에서 이미 적용됨
+  if (FastLED.getBrightness() > 0) renderFrame();
+  outputFrame(leds, NUMPIXELS, FastLED.getBrightness());
+  shownBrightness = FastLED.getBrightness();
+  bootTimes.firstLightUs = micros();
+  framePacerBegin();
+
+  // 엔코더/버튼 인터럽트 시작 (네트워크 없이도 바로 조작 가능)
+  inputEncoderBegin();
+
+  LOG_INFO("첫 프레임 출력: %luus", (unsigned long)bootTimes.firstLightUs);
+  LOG_INFO("저장된 모드 불러오기: %d (%s)", currentMode, getModeText());
+  LOG_INFO("저장된 RGB: %d, %d, %d", mr, mg, mb);
+  LOG_INFO("저장된 밝기: %d", FastLED.getBrightness());
+  LOG_INFO("픽셀 배치: %s %ux%u", layoutTypeNames[layoutType], layoutWidth, layoutHeight);
+
+  // WiFi, OLED, 웹 서버 등은 loop()에서 한 단계씩 시작 (bootStep)
+}
+
+// 부팅 단계 하나 진행 (loop마다 한 번, 모두 끝나면 아무것도 안 함)
+void bootStep()
+{
+  switch (bootStage)
+  {
+    case BOOT_WIFI:
+      // AP 모드 설정
+      WiFi.mode(WIFI_AP);
+      WiFi.softAP(ssid_ap, password_ap);
+      LOG_INFO("AP 모드 시작! SSID: %s", ssid_ap);
+      LOG_INFO("IP 주소: %s", WiFi.softAPIP().toString().c_str());
+      bootAdvance(bootTimes.wifiMs);
+      break;
+
+    case BOOT_DISPLAY:
+      DisplaySetup();  // OLED 디스플레이 설정 (IP 정보 표시)
+      displayReady = true;
+      bootAdvance(bootTimes.displayMs);
+      break;
+
+    case BOOT_HTTP:
+      // 웹 서버 설정
+      setupWebServer();
+      server.begin();
+      LOG_INFO("웹 서버 시작됨 (포트 80)");
+      bootAdvance(bootTimes.httpMs);
+      break;
+
+    case BOOT_SERVICES:
+      // UDP 제어 포트 시작
+      udpControlBegin();
+      LOG_INFO("UDP 제어 포트: %d", UDP_CONTROL_PORT);
+
+      // MQTT (설정된 경우에만 동작)
+      mqttBegin();
+      bootAdvance(bootTimes.servicesMs);
+      break;
+
+    case BOOT_IP_SCREEN:
+      // IP 정보를 잠시 보여준 뒤 현재 상태 표시
+      if (millis() - bootTimes.displayMs < BOOT_IP_SCREEN_MS) break;
+      updateDisplay();
+      bootAdvance(bootTimes.doneMs);
+      LOG_INFO("부팅 완료: %lums", (unsigned long)bootTimes.doneMs);
+      break;
+
+    case BOOT_DONE:
+      break;
+  }
 }
 
 void loop()
 {
-  // 웹 서버 요청 처리
-  server.handleClient();
+  recordLoopGap();  // loop 간격 통계 (/metrics)
+
+  // 남은 부팅 단계 진행 (LED는 이미 켜져 있음)
+  bootStep();
+
+  if (networkReady())
+  {
+    // 웹 서버 요청 처리 (시간 제한 안에서만 진행, 응답은 프레임 사이에 나누어 전송)
+    server.poll(HTTP_IO_BUDGET_US);
+
+    // UDP 명령 수신 후 프레임 시작 전에 적용
+    pollUdpControl();
+    applyUdpControl();
+  }
+
+  // 엔코더/버튼 이벤트 적용 (인터럽트에서 쌓인 것을 모두 비움)
+  applyInputEvents();
+
+  // 병합된 설정 변경을 프레임 시작 전에 한 번에 적용, 조용해지면 저장
+  applyPendingCommands();
+  if (saveDue(millis())) saveSettings();
+
+  // 리더인 경우 시간 기준 브로드캐스트
+  if (networkReady()) frameSyncLoop();
+
+  // 프레임 간격 타이머가 정한 시점에만 렌더링, 출력이 바뀐 경우에만 전송
+  // 프레임 간격을 품질 조절에 알려 이번 프레임부터 바뀐 단계로 그림 (부팅 단계는 원래 느리므로 제외)
+  bool frameDue = framePacerTake();
+  if (frameDue && bootDone() && qualityNote(framePacerStats.gapUs, millis())) applyQualityLevel();
+  bool changed = frameDue && renderAndOutput();
+
+  // MQTT 연결 유지 및 상태 발행 (한 단계씩 시분할, 접속 대기가 있어도 프레임을 낸 뒤에)
+  if (networkReady()) mqttLoop();
+
+  // 쌓인 로그를 송신 FIFO 여유만큼만 내보냄, 미룬 OLED 갱신 처리 (부하가 높으면 미룸)
+  if (!qualityDefersIO())
+  {
+    logFlush();
+    if (displayDeferred) updateDisplay();
+  }
+
+  // 출력 변화가 없으면 유휴 상태로 쉼 (요청 처리 중에는 쉬지 않음)
+  unsigned long now = millis();
+  if (server.activeClients() > 0 || !bootDone()) idleWake(now);
+  idleNoteFrame(changed, now);
+  if (idleTracker.idle)
+  {
+    idleSleep();
+    skipLoopGap();  // 유휴 대기는 프레임 정지로 기록하지 않음
+    framePacerSkip();
+  }
+}
+
+// 현재 모드를 렌더링하고 바뀌었으면 켜진 출력 대상으로 전송 (출력했으면 true)
+bool renderAndOutput()
+{
+  if (currentMode != renderedMode)
+  {
+    renderedMode = currentMode;
+    redrawRequested = true;
+    resetEffectArena();
+    interpReset(interp);
+    applyWhitePoint();
+    selectPalette();
+  }
+  paletteBlendStep(millis());
+
+  uint8_t brightness = FastLED.getBrightness();
+  bool changed = brightness > 0 && renderFrame();  // 밝기 0이면 그릴 필요 없음
+  if (!changed && brightness == shownBrightness) return false;
+  outputFrame(leds, NUMPIXELS, brightness);
+  shownBrightness = brightness;
+  return true;
+}
+
+// 품질 단계가 바뀐 직후 호출 (단계 간격/확산/미루기는 해당 코드가 매번 읽음)
+void applyQualityLevel()
+{
+  FastLED.setDither(qualityLevel() >= QUALITY_NO_DITHER ? DISABLE_DITHER : BINARY_DITHER);
+  traceRecord(TRACE_MARK, TRACE_MARK_QUALITY, qualityLevel());
+  LOG_INFO("품질 단계: %d (누적 초과 %lu)", qualityLevel(), (unsigned long)quality.overruns);
+}
+
+// 한 프레임 렌더링 (출력할 픽셀이 바뀌었으면 true)
+// 보이는 오버레이 레이어가 없으면 기본 모드가 leds[]에 바로 그리고, 있으면 baseLayer에 그린 뒤 합성
+// (baseLayer는 합성하는 동안만 할당, 할당에 실패하면 오버레이 없이 기본 모드만)
+bool renderFrame()
+{
+  bool layered = overlaysActive() && (compositing || baseLayerAlloc(NUMPIXELS));
+  bool switched = layered != compositing;
+  if (switched)
+  {
+    // 전환 순간에도 화면이 끊기지 않도록 지금까지의 기본 모드 출력을 옮김
+    if (layered) memcpy(baseLayer, leds, NUMPIXELS * sizeof(CRGB));
+    else
+    {
+      memcpy(leds, baseLayer, NUMPIXELS * sizeof(CRGB));
+      baseLayerFree(NUMPIXELS);
+    }
+    compositing = layered;
+    frame = layered ? baseLayer : leds;
+  }
+
+  bool baseChanged = renderBase() || switched;
+  if (!compositing) return baseChanged;
+  return renderOverlays(baseChanged);
+}
+
+// 기본 모드 렌더링 (frame에 그림)
+// 느린 간격으로 계산하는 모드는 새 단계를 키프레임으로 넘기고 단계 사이를 보간해서 출력
+bool renderBase()
+{
+  unsigned long renderStart = micros();
+  bool stepped = renderCurrentMode();
+  if (stepped)
+  {
+    uint32_t renderUs = micros() - renderStart;
+    recordLatency(renderStats, renderUs);
+    if (renderUs > TRACE_SLOW_US) traceRecord(TRACE_RENDER, currentMode, traceDuration(renderUs));
+  }
+  return interpolateStep(currentMode, interp, stepped);
+}
+
+// 느린 간격으로 계산하는 모드면 방금 그린 단계(stepped)를 키프레임으로 넘기고 보간 프레임을 frame에 씀
+// (보간하지 않는 모드는 stepped 그대로, 출력이 바뀌었으면 true)
+bool interpolateStep(Mode mode, InterpState &state, bool stepped)
+{
+  uint16_t period = modeStepPeriod(mode);
+  InterpFrames *keyframes = modeKeyframes(mode);
+  if (period == 0 || keyframes == nullptr) return stepped;
+
+  uint32_t now = animMillis();
+  if (stepped) interpKeyframe(state, *keyframes, frame, NUMPIXELS, now - now % period, period);
+  unsigned long blendStart = micros();
+  bool changed = interpFrame(state, *keyframes, frame, NUMPIXELS, now);
+  if (changed) recordLatency(interpStats, micros() - blendStart);
+  return changed;
+}
+
+// 오버레이 레이어를 각자의 버퍼/상태/팔레트로 그리고, 바뀐 구간만 leds[]에 다시 합성
+bool renderOverlays(bool baseChanged)
+{
+  // 방금 끈 레이어는 덮고 있던 구간만 다시 합성
+  uint16_t lo = baseChanged ? 0 : overlayClearLo;
+  uint16_t hi = baseChanged ? NUMPIXELS : overlayClearHi;
+  overlayClearLo = MAX_LEDS;
+  overlayClearHi = 0;
+  unsigned long start = micros();
+
+  CRGBPalette16 basePalette = activePalette;  // 효과는 activePalette를 읽으므로 레이어마다 바꿔 끼움
+  for (uint8_t l = 0; l < OVERLAY_COUNT; l++)
+  {
+    if (overlays[l] == nullptr) continue;
+    OverlayLayer &layer = *overlays[l];
+
+    currentArena = layer.arena;
+    frame = layer.pixels;
+    activePalette = layer.palette;
+    redrawRequested = layer.redraw;
+    bool changed = layer.opacity > 0 && interpolateStep((Mode)layer.mode, layer.interp, renderMode((Mode)layer.mode));
+    if (changed) layer.redraw = false;
+    if (!changed && !layer.dirty) continue;
+
+    // 이전 구간과 새 구간을 모두 다시 합성
+    lo = min(lo, layer.lo);
+    hi = max(hi, layer.hi);
+    layerUpdateSpan(layer, NUMPIXELS);
+    if (layer.lo < layer.hi)
+    {
+      lo = min(lo, layer.lo);
+      hi = max(hi, layer.hi);
+    }
+    layer.dirty = false;
+  }
+  currentArena = effectArena;
+  frame = baseLayer;
+  activePalette = basePalette;
+  redrawRequested = false;
+
+  if (lo >= hi)
+  {
+    compositorStats.skipped++;
+    return false;
+  }
+  compositeRange(leds, baseLayer, lo, hi);
+  recordLatency(compositeStats, micros() - start);
+  return true;
+}
+
+// 모드별 시뮬레이션 단계 간격 (ms, 0이면 보간 안 함)
+uint16_t modeStepPeriod(Mode mode)
+{
+  switch (mode)
+  {
+    case CAMPFIRE_MODE: return qualityPeriod(param(PARAM_FIRE_SPEED));
+    case CHRISTMAS_MODE: return qualityPeriod(param(PARAM_XMAS_SPEED));
+    default: return 0;
+  }
+}
+
+// 보간하는 모드의 키프레임 (지금 그리는 효과 영역 안, 보간하지 않으면 nullptr)
+InterpFrames *modeKeyframes(Mode mode)
+{
+  switch (mode)
+  {
+    case CAMPFIRE_MODE: return &effectState<CampfireState>().keyframes;
+    case CHRISTMAS_MODE: return &effectState<ChristmasState>().keyframes;
+    default: return nullptr;
+  }
+}
+
+// 현재 모드에 따른 동작 (픽셀이 바뀌었으면 true)
+bool renderCurrentMode()
+{
+  return renderMode(currentMode);
+}
 
-  // 현재 모드에 따른 동작
-  switch (currentMode)
+// 주어진 모드의 효과를 frame에 그림 (효과 상태는 currentArena)
+bool renderMode(Mode mode)
+{
+  bool changed = false;
+  switch (mode)
   {
     case NORMAL_MODE:
-      normalMode();
+      changed = normalMode();
       break;
     case CAMPFIRE_MODE:
-      campfireMode();
+      changed = campfireMode();
       break;
     case CHRISTMAS_MODE:
-      christmasMode();
+      changed = christmasMode();
       break;
     case WARMLIGHT_MODE:
-      warmLightMode();
+      changed = warmLightMode();
       break;
     case BEATSIN_MODE:
-      beatsinMode();
+      changed = beatsinMode();
+      break;
+    case AURORA_MODE:
+      changed = noiseMode();
+      break;
+    case OCEAN_MODE:
+      changed = noiseMode();
+      break;
+    case LAVA_MODE:
+      changed = noiseMode();
       break;
   }
+  redrawRequested = false;
+  return changed;
+}
+
+// 사용자가 고른 색 (채널 순서는 addLeds의 LED_COLOR_ORDER가 처리하므로 여기서 바꾸지 않음,
+// 빨강/초록을 바꿔 그리던 버전 4 이전 저장값은 loadSettings()에서 변환)
+inline CRGB userColor()
+{
+  return CRGB(mr, mg, mb);
 }
 
-// 노말 모드 (단순 LED 켜짐)
-void normalMode()
+// 노말 모드 (단순 LED 켜짐), 색상이 바뀔 때만 다시 그림
+bool normalMode()
 {
+  NormalState &state = effectState<NormalState>();
+  CRGB color = userColor();
+  if (!redrawRequested && state.drawn && color == state.lastColor) return false;
+
   for (int i = 0; i < NUMPIXELS; i++)
   {
-    leds[i] = CRGB(mg, mr, mb);
+    frame[i] = color;
   }
-  FastLED.show();
+  state.lastColor = color;
+  state.drawn = true;
+  return true;
 }
 
 // Beatsin 모드 (흐르는 효과)
-void beatsinMode()
+// 혜성이 배치의 가로 방향으로 움직임 (1줄 배치에서는 픽셀 하나, 2D에서는 한 열 전체)
+bool beatsinMode()
 {
-  uint16_t sinBeat = beatsin16(20, 0, NUMPIXELS - 1, 0, 0);
-  leds[sinBeat] = CRGB(mg, mr, mb);
-  fadeLightBy(leds, NUMPIXELS, 10);
-  FastLED.show();
+  uint16_t sinBeat = beatsin16(20, 0, layoutWidth - 1, animTimebase(), 0);
+  for (int i = 0; i < NUMPIXELS; i++)
+  {
+    if (layoutCol[i] == sinBeat) frame[i] = userColor();
+  }
+  fadeLightBy(frame, NUMPIXELS, 10);
+  return true;
 }
 
+// 효과 단계의 청크 계산 (effectKernels.h의 커널, 픽셀 수는 NUMPIXELS 상수이고 CrgbSink로 frame에 씀)
+// 상태/출력 버퍼와 이번 단계 설정을 모두 받아 두므로 전역 상태를 읽지 않고, 청크끼리 [lo, hi)만 쓴다.
+// 그래서 청크를 어떤 순서로, 어느 스레드에서 계산해도 결과가 같다 (host/renderPool.h, 여러 스트립 벤치마크).
+
 // 모닥불 모드
-void campfireMode()
+bool campfireMode()
 {
-  static unsigned long lastUpdate = 0;
-  static byte firePixels[MAX_LEDS];   // 각 픽셀의 현재 불꽃 강도
-  static byte targetPixels[MAX_LEDS]; // 각 픽셀의 목표 강도
-  static bool initialized = false;
+  CampfireState &state = effectState<CampfireState>();
+  byte *firePixels = state.firePixels;
+  byte *targetPixels = state.targetPixels;
   
-  // 초기화
-  if (!initialized)
+  // 설정 간격(기본 70ms) 단위 시뮬레이션 단계 (공유 시계 기준, 단계 사이는 보간)
+  uint32_t step = animMillis() / modeStepPeriod(CAMPFIRE_MODE);
+
+  // 초기화 (공유 시드로 정해서 같은 단계에 시작한 조명끼리 같은 불꽃)
+  if (!state.initialized)
   {
+    seedEffectInit(step);
     for (int i = 0; i < NUMPIXELS; i++)
     {
       firePixels[i] = random(50, 200);
       targetPixels[i] = firePixels[i];
     }
-    initialized = true;
+    state.initialized = true;
   }
   
-  if (millis() - lastUpdate > 70)
+  uint8_t changeChance = param(PARAM_FIRE_CHANGE);
+  uint8_t sparkChance = param(PARAM_FIRE_SPARK);
+  bool diffuse = qualityDiffusion();
+  if (step == state.lastStep) return false;
+  state.lastStep = step;
+  chunkJobStart(state.job, step, firePixels, NUMPIXELS);
+
+  // 보간할 키프레임이 완성되어야 하므로 한 번에 모든 청크 계산
+  CampfireKernel<NUMPIXELS, CrgbSink> kernel = {firePixels, targetPixels, {frame}, &activePalette,
+                                                layoutHeight > 1 ? layoutY : nullptr, changeChance, sparkChance, diffuse};
+  return chunkJobRun(state.job, 0, kernel);
+}
+
+bool christmasMode()
+{
+  ChristmasState &state = effectState<ChristmasState>();
+  
+  // 설정 간격(기본 250ms) 단위 단계, 패턴은 설정 시간(기본 3초)마다 변경 (공유 시계 기준, 단계 사이는 보간)
+  uint32_t now = animMillis();
+  uint32_t step = now / modeStepPeriod(CHRISTMAS_MODE);
+  uint8_t starChance = param(PARAM_XMAS_STAR);
+  if (step == state.lastStep) return false;
+  state.lastStep = step;
+  chunkJobStart(state.job, step, nullptr, NUMPIXELS);
+
+  int phase = (now / (param(PARAM_XMAS_HOLD) * 1000UL)) % 3; // 0: 빨간색 켜짐, 1: 초록색 켜짐, 2: 둘 다 반짝임
+  if (phase + 1 != state.loggedPhase)
   {
+    state.loggedPhase = phase + 1;
+    LOG_DEBUG("크리스마스 패턴: %d (0: 빨간색, 1: 초록색, 2: 반짝임)", phase);
+  }
+  
+  // 보간할 키프레임이 완성되어야 하므로 한 번에 모든 청크 계산
+  ChristmasKernel<NUMPIXELS, CrgbSink> kernel = {{frame}, &activePalette, step, (uint8_t)phase, starChance};
+  return chunkJobRun(state.job, 0, kernel);
+}
+
+// 웜라이트 모드
+bool warmLightMode()
+{
+  WarmLightState &state = effectState<WarmLightState>();
+  byte *warmPixels = state.warmPixels;
+  byte *targetPixels = state.targetPixels;
+  
+  // 색온도에 따른 RGB 값은 paramChanged()에서 미리 계산됨 (warmBaseColor)
+
+  // 초기화 (공유 시드로 정해서 같은 단계에 시작한 조명끼리 같은 밝기)
+  uint32_t step = animMillis() / qualityPeriod(param(PARAM_WARM_SPEED));
+  if (!state.initialized)
+  {
+    seedEffectInit(step);
     for (int i = 0; i < NUMPIXELS; i++)
     {
-      // 15% 확률로 새로운 목표값 설정
-      if (random(0, 100) < 15)
-      {
-        targetPixels[i] = random(40, 220);
-      }
-      
-      // 현재 값을 목표값으로 부드럽게 이동
-      int diff = (int)targetPixels[i] - (int)firePixels[i];
-      firePixels[i] += diff / 10;
-      
-      // 인근 픽셀들의 영향 추가 (불꽃 확산 효과)
-      if (i > 0 && i < NUMPIXELS - 1)
-      {
-        int neighborAvg = ((int)firePixels[i-1] + (int)firePixels[i+1]) / 2;
-        firePixels[i] = ((int)firePixels[i] * 4 + neighborAvg) / 5;
-      }
-      
-      // 밝기 조절
-      int intensity = firePixels[i];
-      
-      // 모닥불 색상: 주로 빨간색, 약간의 주황색
-      int red = intensity;
-      int green = intensity / 5;
-      int blue = 0;
-      
-      // 5% 확률로 더 밝은 불꽃 효과
-      if (random(0, 100) < 5)
-      {
-        red = min(255, red + (int)random(20, 50));
-        green = min(60, green + (int)random(5, 15));
-      }
-      
-      // 최소 밝기 보장
-      red = max(red, 10);
-      green = max(green, 5);
-      
-      leds[i] = CRGB(red, green, blue);
+      warmPixels[i] = random(50, 200);
+      targetPixels[i] = warmPixels[i];
     }
-    
-    FastLED.show();
-    lastUpdate = millis();
+    state.initialized = true;
   }
+  
+  uint8_t changeChance = param(PARAM_WARM_CHANCE);
+  uint8_t minBrightness = param(PARAM_WARM_MIN);
+  uint8_t maxBrightness = param(PARAM_WARM_MAX);
+  uint8_t smoothness = param(PARAM_WARM_SMOOTH);
+  bool diffuse = qualityDiffusion();
+  WarmLightKernel<NUMPIXELS, CrgbSink> stepChunk = {warmPixels, targetPixels, {frame}, warmBaseColor,
+                                                    changeChance, minBrightness, maxBrightness, smoothness, diffuse};
+
+  // 보간하지 않는 효과이므로 긴 스트립은 여러 프레임에 나눠 계산 (늦은 청크는 한두 프레임 늦게 바뀜)
+  if (step != state.lastStep)
+  {
+    chunkJobRun(state.job, 0, stepChunk);  // 끝나지 않은 이전 단계를 마저 계산
+    state.lastStep = step;
+    chunkJobStart(state.job, step, warmPixels, NUMPIXELS);
+  }
+  return chunkJobRun(state.job, RENDER_SLICE_US, stepChunk);
 }
 
-// 크리스마스 모드
-void christmasMode()
+// 노이즈 모드 (오로라/바다/용암): 노이즈 장을 공간(x, y)과 시간(z)으로 훑어 팔레트로 색칠
+// 픽셀은 배치 순서대로 계산하므로 이웃 픽셀끼리 격자 모서리 값을 재사용한다.
+bool noiseMode()
 {
-  static unsigned long lastUpdate = 0;
-  static unsigned long patternStart = 0;
-  static int phase = 0; // 0: 빨간색 켜짐, 1: 초록색 켜짐, 2: 둘 다 반짝임
-  static bool sparkleState = false;
-  
-  if (millis() - lastUpdate > 250)
+  NoiseState &state = effectState<NoiseState>();
+
+  // 20ms 단위 단계 (공유 시계 기준, 부하가 높으면 40ms)
+  uint32_t now = animMillis();
+  uint32_t step = now / qualityPeriod(20);
+  if (step == state.lastStep) return false;
+  state.lastStep = step;
+
+  NoiseCursor cursor = {};
+  uint32_t z = (uint64_t)now * param(PARAM_NOISE_SPEED) / 256;
+  uint8_t noiseScale = param(PARAM_NOISE_SCALE);
+  for (int i = 0; i < NUMPIXELS; i++)
   {
-    // 3초마다 패턴 변경
-    if (millis() - patternStart > 3000)
+    uint32_t x = (uint32_t)layoutX[i] * noiseScale / (4 << LAYOUT_COORD_SHIFT);
+    uint32_t y = (uint32_t)layoutY[i] * noiseScale / (4 << LAYOUT_COORD_SHIFT);
+    frame[i] = ColorFromPalette(activePalette, noiseToIndex(noiseAt(cursor, x, y, z)));
+  }
+  return true;
+}
+
+// UDP 제어 명령 적용 (프레임 시작 시점에 호출됨)
+bool applyControlPacket(const ControlPacket &packet)
+{
+  const uint8_t *p = packet.payload;
+  bool persist = packet.flags & CTRL_FLAG_PERSIST;
+  traceRecord(TRACE_UDP, packet.opcode, 0);
+
+  switch (packet.opcode)
+  {
+    case CTRL_OP_PING:
+      return true;
+
+    case CTRL_OP_SET_MODE:
+      if (p[0] >= MODE_COUNT) return false;
+      intakeMode(p[0], persist);
+      return true;
+
+    case CTRL_OP_SET_COLOR:
+      intakeColor(p[0], p[1], p[2], persist);
+      return true;
+
+    case CTRL_OP_SET_BRIGHTNESS:
+      intakeBrightness(p[0], persist);
+      return true;
+
+    case CTRL_OP_SET_WARM:
+      if (isValidKelvin(p[0] * 100)) intakeParam(PARAM_WARM_TEMP, p[0] * 100, persist);
+      for (uint8_t i = 1; i < 6; i++) intakeParam(PARAM_WARM_TEMP + i, p[i], persist);
+      return true;
+
+    case CTRL_OP_SYNC:
     {
-      phase = (phase + 1) % 3;
-      patternStart = millis();
-      Serial.print("크리스마스 패턴: ");
-      if (phase == 0) Serial.println("빨간색");
-      else if (phase == 1) Serial.println("초록색");
-      else Serial.println("반짝임");
+      uint32_t leaderTime, seed;
+      memcpy(&leaderTime, p, 4);
+      memcpy(&seed, p + 4, 4);
+      frameSyncReceive(leaderTime, seed, packet.seq);
+      return true;
     }
-    
-    for (int i = 0; i < NUMPIXELS; i++)
+
+    case CTRL_OP_RECALL_PRESET:
+      return recallPreset(p[0]);
+
+    default:
+      return false;
+  }
+}
+
+// 엔코더/버튼 이벤트 처리 (loop에서 프레임 시작 전에 호출됨)
+// 회전: 밝기 조절 (빠르게 돌릴수록 크게), 버튼: 다음 모드.
+// 밝기는 돌리는 동안 바로 반영하고 플래시 저장은 멈춘 뒤 한 번만 한다.
+uint32_t lastRotateCycles = 0;
+
+void applyInputEvents()
+{
+  InputEvent event;
+  while (popInputEvent(event))
+  {
+    if (event.type == INPUT_ROTATE)
     {
-      int red = 0, green = 0, blue = 0;
-      
-      if (phase == 0)
-      {
-        // 빨간색 위주, 가끔 초록색
-        if (i % 4 == 0 || i % 4 == 1)
-        {
-          red = 255;
-          green = 0;
-        }
-        else
-        {
-          red = 0;
-          green = 255;
-        }
-      }
-      else if (phase == 1)
-      {
-        // 초록색 위주, 가끔 빨간색
-        if (i % 4 == 0 || i % 4 == 1)
-        {
-          red = 0;
-          green = 255;
-        }
-        else
-        {
-          red = 255;
-          green = 0;
-        }
-      }
-      else
-      {
-        // 둘 다 반짝임
-        sparkleState = !sparkleState;
-        if (sparkleState)
-        {
-          if (i % 2 == 0)
-          {
-            red = 255;
-            green = 0;
-          }
-          else
-          {
-            red = 0;
-            green = 255;
-          }
-        }
-        else
-        {
-          // 약간 어둡게
-          if (i % 2 == 0)
-          {
-            red = 100;
-            green = 0;
-          }
-          else
-          {
-            red = 0;
-            green = 100;
-          }
-        }
-      }
-      
-      // 3% 확률로 흰색 반짝임 추가 (별 효과)
-      if (random(0, 100) < 3)
-      {
-        red = 255;
-        green = 255;
-        blue = 200;
-      }
-      
-      leds[i] = CRGB(red, green, blue);
+      uint32_t intervalUs = (event.cycles - lastRotateCycles) / (F_CPU / 1000000);
+      lastRotateCycles = event.cycles;
+      int step = encoderAcceleration(intervalUs) * event.delta;
+      FastLED.setBrightness(constrain(FastLED.getBrightness() + step, 0, 255));
+      requestSave(millis());
+    }
+    else if (event.type == INPUT_BUTTON_PRESS)
+    {
+      intakeMode((currentMode + 1) % MODE_COUNT, true);
     }
-    
-    FastLED.show();
-    lastUpdate = millis();
   }
 }
 
-// 웜라이트 모드
-void warmLightMode()
+// 병합된 설정 변경 적용 (loop에서 프레임 시작 전에 호출됨)
+// 마지막으로 받은 값만 적용하고 로그도 프레임당 한 번만 남긴다.
+void applyPendingCommands()
 {
-  static unsigned long lastUpdate = 0;
-  static byte warmPixels[MAX_LEDS];   // 각 픽셀의 현재 밝기
-  static byte targetPixels[MAX_LEDS]; // 각 픽셀의 목표 밝기
-  static bool initialized = false;
-  
-  // 색온도에 따른 RGB 값 (근사값)
-  int baseRed, baseGreen, baseBlue;
-  
-  switch(warmColorTemp) {
-    case 2000:  // 촛불 색
-      baseRed = 255; baseGreen = 147; baseBlue = 41;
-      break;
-    case 3000:  // 따뜻한 백열등
-      baseRed = 255; baseGreen = 180; baseBlue = 107;
-      break;
-    case 4000:  // 중성 백색
-      baseRed = 255; baseGreen = 209; baseBlue = 163;
-      break;
-    case 5000:  // 주광색
-      baseRed = 255; baseGreen = 228; baseBlue = 206;
-      break;
-    case 6000:  // 차가운 백색
-      baseRed = 255; baseGreen = 243; baseBlue = 239;
-      break;
-    default:  // 기본값 3000K
-      baseRed = 255; baseGreen = 180; baseBlue = 107;
+  uint8_t dirty = pendingCommands.dirty;
+  if (dirty == 0) return;
+  const PendingCommands &p = pendingCommands;
+  pendingCommands.dirty = 0;
+  intakeStats.applied++;
+
+  if ((dirty & PENDING_MODE) && p.mode != currentMode)
+  {
+    currentMode = (Mode)p.mode;
+    traceRecord(TRACE_PARAM, 0, currentMode);
+    updateDisplay();
+    LOG_INFO("설정 변경 적용: 모드=%s", getModeText());
   }
-  
-  // 초기화
-  if (!initialized)
+  if (dirty & PENDING_COLOR)
   {
-    for (int i = 0; i < NUMPIXELS; i++)
-    {
-      warmPixels[i] = random(50, 200);
-      targetPixels[i] = warmPixels[i];
-    }
-    initialized = true;
+    mr = p.red;
+    mg = p.green;
+    mb = p.blue;
+    traceRecord(TRACE_PARAM, 1, (mr >> 3) << 11 | (mg >> 2) << 5 | mb >> 3);  // RGB565
+    LOG_INFO("설정 변경 적용: RGB=%d,%d,%d", mr, mg, mb);
   }
-  
-  if (millis() - lastUpdate > warmUpdateSpeed)
+  if (dirty & PENDING_BRIGHTNESS)
   {
-    for (int i = 0; i < NUMPIXELS; i++)
+    FastLED.setBrightness(p.brightness);
+    traceRecord(TRACE_PARAM, 2, p.brightness);
+    LOG_INFO("설정 변경 적용: 밝기=%d", p.brightness);
+  }
+  if (dirty & PENDING_PARAMS)
+  {
+    uint32_t changed = p.paramDirty;
+    pendingCommands.paramDirty = 0;
+    for (uint8_t id = 0; id < PARAM_COUNT; id++)
     {
-      // 설정된 확률로 새로운 목표값 설정
-      if (random(0, 100) < warmChangeChance)
-      {
-        targetPixels[i] = random(warmMinBrightness, warmMaxBrightness + 1);
-      }
-      
-      // 현재 값을 목표값으로 부드럽게 이동
-      int diff = (int)targetPixels[i] - (int)warmPixels[i];
-      warmPixels[i] += diff / warmSmoothness;
-      
-      // 목표값이 낮을 때(50 이하)는 인근 영향 무시
-      if (targetPixels[i] > 50 && i > 0 && i < NUMPIXELS - 1)
-      {
-        int neighborAvg = ((int)warmPixels[i-1] + (int)warmPixels[i+1]) / 2;
-        warmPixels[i] = ((int)warmPixels[i] * 9 + neighborAvg) / 10;
-      }
-      
-      // 밝기 조절
-      float intensity = warmPixels[i] / 255.0;
-      
-      // 색온도 적용
-      int red = baseRed * intensity;
-      int green = baseGreen * intensity;
-      int blue = baseBlue * intensity;
-      
-      leds[i] = CRGB(red, green, blue);
+      if (!(changed & (1UL << id))) continue;
+      paramSet(id, p.params[id]);
+      traceRecord(TRACE_PARAM, TRACE_PARAM_TABLE + id, param(id));
+      LOG_INFO("설정 변경 적용: 항목 %d(%s)=%u", id, paramTable[id].name, param(id));
     }
-    
-    FastLED.show();
-    lastUpdate = millis();
+  }
+  if (dirty & PENDING_PALETTE)
+  {
+    paletteSel = p.palette;
+    traceRecord(TRACE_PARAM, 5, paletteSel);
+    selectPalette();
+    LOG_INFO("설정 변경 적용: 팔레트 %s", paletteNames[paletteSel]);
+  }
+  if (dirty & PENDING_WHITE_POINT)
+  {
+    normalWhitePoint = p.whitePoint;
+    traceRecord(TRACE_PARAM, 4, normalWhitePoint);
+    applyWhitePoint();
+    LOG_INFO("설정 변경 적용: 백색점=%u", normalWhitePoint);
+  }
+
+  redrawRequested = true;
+  if (p.persist)
+  {
+    pendingCommands.persist = false;
+    requestSave(millis());
   }
 }
 
 // 현재 모드 텍스트 반환
 const char* getModeText()
 {
-  switch (currentMode)
+  return getModeName(currentMode);
+}
+
+// 모드 이름 반환
+const char* getModeName(Mode mode)
+{
+  switch (mode)
   {
     case NORMAL_MODE:
       return "Normal";
@@ -428,6 +923,12 @@ const char* getModeText()
       return "Warm Light";
     case BEATSIN_MODE:
       return "Beatsin";
+    case AURORA_MODE:
+      return "Aurora";
+    case OCEAN_MODE:
+      return "Ocean";
+    case LAVA_MODE:
+      return "Lava";
     default:
       return "Unknown";
   }
@@ -436,6 +937,9 @@ const char* getModeText()
 // OLED 디스플레이 업데이트
 void updateDisplay()
 {
+  if (!displayReady) return;  // 부팅 중 OLED 초기화 전
+  displayDeferred = qualityDefersIO();  // 부하가 높으면 여유가 생길 때 loop()에서 다시 호출
+  if (displayDeferred) return;
   display.stopscroll();
   display.clearDisplay();
   
@@ -465,294 +969,341 @@ void updateDisplay()
   display.display();
 }
 
-// EEPROM에 모드 저장
-void saveModeToEEPROM(Mode mode)
+// 현재 상태를 장면 레코드로 저장
+void captureScene(SceneRecord &scene)
 {
-  EEPROM.write(EEPROM_MODE_ADDR, (uint8_t)mode);
-  EEPROM.commit();
-  Serial.print("EEPROM에 모드 저장: ");
-  Serial.println(mode);
+  scene.mode = currentMode;
+  scene.red = mr;
+  scene.green = mg;
+  scene.blue = mb;
+  scene.brightness = FastLED.getBrightness();
+  scene.whitePoint = normalWhitePoint;
+  scene.palette = paletteSel;
+  paramStore((uint8_t *)&scene);  // 효과 설정 항목
 }
 
-// EEPROM에서 모드 불러오기
-Mode loadModeFromEEPROM()
+// 장면 레코드를 현재 상태로 한 번에 적용 (범위 검증 포함), 모드가 바뀌면 true
+bool applyScene(const SceneRecord &scene)
 {
-  uint8_t savedMode = EEPROM.read(EEPROM_MODE_ADDR);
-  
-  // 유효한 모드 값인지 확인 (0-4)
-  if (savedMode <= 4)
+  Mode mode = scene.mode < MODE_COUNT ? (Mode)scene.mode : CAMPFIRE_MODE;
+  bool modeChanged = mode != currentMode;
+  discardPendingCommands();  // 장면 전체를 바꾸므로 그 전에 들어온 변경은 버림
+  currentMode = mode;
+  mr = scene.red;
+  mg = scene.green;
+  mb = scene.blue;
+  FastLED.setBrightness(scene.brightness);
+
+  paramLoad((const uint8_t *)&scene);  // 효과 설정 항목 (표의 범위로 제한)
+  normalWhitePoint = isValidKelvin(scene.whitePoint) ? scene.whitePoint : 0;
+  paletteSel = scene.palette < PALETTE_COUNT ? scene.palette : PALETTE_AUTO;
+  applyWhitePoint();
+  selectPalette();
+  redrawRequested = true;
+
+  return modeChanged;
+}
+
+uint8_t settingsChecksum(const StoredSettings &stored)
+{
+  const uint8_t *bytes = (const uint8_t *)&stored;
+  uint8_t sum = 0;
+  for (size_t i = 0; i < offsetof(StoredSettings, checksum); i++)
   {
-    return (Mode)savedMode;
+    sum = (sum << 1 | sum >> 7) ^ bytes[i];
   }
-  else
+  return sum;
+}
+
+// 현재 장면을 포함한 전체 레코드를 한 번에 저장
+void saveSettings()
+{
+  captureScene(settings.current);
+  settings.magic = SETTINGS_MAGIC;
+  settings.version = SETTINGS_VERSION;
+  settings.syncRole = syncRole;
+  settings.checksum = settingsChecksum(settings);
+
+  EEPROM.put(SETTINGS_ADDR, settings);
+
+  // 표시된 다른 블록도 캐시에 쓰고 같은 커밋으로 (트레이스에는 저장을 일으킨 블록으로 기록)
+  uint8_t store = TRACE_STORE_SETTINGS;
+  if (storeDirty & STORE_LAYOUT)
+  {
+    saveLayout();
+    store = TRACE_STORE_LAYOUT;
+  }
+  if (storeDirty & STORE_PALETTE)
   {
-    // 유효하지 않으면 기본값(모닥불 모드) 반환
-    Serial.println("유효하지 않은 EEPROM 값, 기본 모드 사용");
-    return CAMPFIRE_MODE;
+    saveCustomPalette();
+    store = TRACE_STORE_PALETTE;
   }
+  storeDirty = 0;
+
+  timedCommit(store);  // 내용이 바뀌지 않았으면 플래시에 쓰지 않음
+  settingsSaveAt = 0;  // 예약된 저장은 이미 반영됨
+  LOG_INFO("EEPROM에 설정 저장");
 }
 
-// EEPROM에 RGB 색상 및 밝기 저장
-void saveColorToEEPROM(uint8_t r, uint8_t g, uint8_t b, uint8_t brightness)
+// 기본 장면 (모닥불, 흰색, 밝기 50)
+void defaultScene(SceneRecord &scene)
 {
-  EEPROM.write(EEPROM_RED_ADDR, r);
-  EEPROM.write(EEPROM_GREEN_ADDR, g);
-  EEPROM.write(EEPROM_BLUE_ADDR, b);
-  EEPROM.write(EEPROM_BRIGHTNESS_ADDR, brightness);
-  EEPROM.commit();
-  Serial.print("EEPROM에 색상 저장: R=");
-  Serial.print(r); Serial.print(", G=");
-  Serial.print(g); Serial.print(", B=");
-  Serial.print(b); Serial.print(", Brightness=");
-  Serial.println(brightness);
+  captureScene(scene);
+  scene.mode = CAMPFIRE_MODE;
+  scene.red = 255;
+  scene.green = 255;
+  scene.blue = 255;
+  scene.brightness = 50;
+  scene.whitePoint = 0;
+  defaultSceneTail(scene, 0);
 }
 
-// EEPROM에서 RGB 색상 및 밝기 불러오기
-void loadColorFromEEPROM()
+// from 바이트 이후 필드를 기본값으로 (이전 버전 레코드에 없던 필드)
+void defaultSceneTail(SceneRecord &scene, size_t from)
 {
-  uint8_t r = EEPROM.read(EEPROM_RED_ADDR);
-  uint8_t g = EEPROM.read(EEPROM_GREEN_ADDR);
-  uint8_t b = EEPROM.read(EEPROM_BLUE_ADDR);
-  uint8_t brightness = EEPROM.read(EEPROM_BRIGHTNESS_ADDR);
-  
+  paramStoreDefaults((uint8_t *)&scene, from);
+  if (from <= offsetof(SceneRecord, palette)) scene.palette = PALETTE_AUTO;
+}
+
+// 버전 4까지는 노말/비트 모드가 CRGB(green, red, blue)로 그렸으므로 (userColor() 이전)
+// 같은 색으로 보이도록 저장된 빨강/초록을 바꿔 줌
+void swapLegacyRedGreen(SceneRecord &scene)
+{
+  uint8_t red = scene.red;
+  scene.red = scene.green;
+  scene.green = red;
+}
+
+// 이전 바이트 레이아웃에서 장면 불러오기 (최초 1회 마이그레이션)
+void loadLegacyScene(SceneRecord &scene)
+{
+  uint8_t savedMode = EEPROM.read(LEGACY_MODE_ADDR);
+  uint8_t r = EEPROM.read(LEGACY_RED_ADDR);
+  uint8_t g = EEPROM.read(LEGACY_RED_ADDR + 1);
+  uint8_t b = EEPROM.read(LEGACY_RED_ADDR + 2);
+  uint8_t brightness = EEPROM.read(LEGACY_BRIGHTNESS_ADDR);
+
   // 0xFF는 초기화되지 않은 EEPROM 값
+  scene.mode = savedMode < MODE_COUNT ? savedMode : CAMPFIRE_MODE;
   if (r == 0xFF || g == 0xFF || b == 0xFF || brightness == 0xFF)
   {
-    // 기본값 설정
-    mr = 255;
-    mg = 255;
-    mb = 255;
-    FastLED.setBrightness(50);
-    Serial.println("기본 색상 사용: 흰색, 밝기 50");
+    scene.red = 255;
+    scene.green = 255;
+    scene.blue = 255;
+    scene.brightness = 50;
+    LOG_WARN("기본 색상 사용: 흰색, 밝기 50");
   }
   else
   {
-    mr = r;
-    mg = g;
-    mb = b;
-    FastLED.setBrightness(brightness);
+    scene.red = r;
+    scene.green = g;
+    scene.blue = b;
+    scene.brightness = brightness;
+    swapLegacyRedGreen(scene);
   }
+
+  uint8_t warm[6];
+  for (int i = 0; i < 6; i++) warm[i] = EEPROM.read(LEGACY_WARM_COLORTEMP_ADDR + i);
+  scene.warmColorTemp = (warm[0] >= 20 && warm[0] <= 60) ? warm[0] * 100 : paramTable[PARAM_WARM_TEMP].def;
+  scene.warmChangeChance = warm[1] != 0xFF ? warm[1] : paramTable[PARAM_WARM_CHANCE].def;
+  scene.warmMinBrightness = warm[2] != 0xFF ? warm[2] : paramTable[PARAM_WARM_MIN].def;
+  scene.warmMaxBrightness = warm[3] != 0xFF ? warm[3] : paramTable[PARAM_WARM_MAX].def;
+  scene.warmUpdateSpeed = warm[4] != 0xFF ? warm[4] : paramTable[PARAM_WARM_SPEED].def;
+  scene.warmSmoothness = warm[5] != 0xFF ? warm[5] : paramTable[PARAM_WARM_SMOOTH].def;
+  scene.whitePoint = 0;
+  defaultSceneTail(scene, SCENE_RECORD_V2_SIZE);
 }
 
-// Warm 설정 EEPROM에 저장
-void saveWarmConfigToEEPROM()
+// 이전 버전 레코드 변환: 장면 뒤에 새로 붙은 필드만 기본값으로 채우고 프리셋은 유지 (빨강/초록은 바꿈)
+bool loadSettingsOld(size_t recordSize)
 {
-  // 색온도 저장 (2바이트: 2000~6000)
-  EEPROM.write(EEPROM_WARM_COLORTEMP_ADDR, (uint8_t)(warmColorTemp / 100));
-  
-  EEPROM.write(EEPROM_WARM_CHANCE_ADDR, (uint8_t)warmChangeChance);
-  EEPROM.write(EEPROM_WARM_MIN_ADDR, (uint8_t)warmMinBrightness);
-  EEPROM.write(EEPROM_WARM_MAX_ADDR, (uint8_t)warmMaxBrightness);
-  EEPROM.write(EEPROM_WARM_SPEED_ADDR, (uint8_t)warmUpdateSpeed);
-  EEPROM.write(EEPROM_WARM_SMOOTH_ADDR, (uint8_t)warmSmoothness);
-  
-  EEPROM.commit();
-  Serial.println("Warm Light 설정 EEPROM 저장 완료");
+  const int sceneCount = PRESET_COUNT + 1;
+  const int scenesAddr = SETTINGS_ADDR + offsetof(StoredSettings, current);
+  const int checksumAddr = scenesAddr + sceneCount * recordSize + 1;
+
+  uint8_t sum = 0;
+  for (int addr = SETTINGS_ADDR; addr < checksumAddr; addr++)
+  {
+    sum = (sum << 1 | sum >> 7) ^ EEPROM.read(addr);
+  }
+  if (sum != EEPROM.read(checksumAddr)) return false;
+
+  int addr = scenesAddr;
+  for (int s = 0; s < sceneCount; s++)
+  {
+    SceneRecord &scene = s == 0 ? settings.current : settings.presets[s - 1];
+    uint8_t *bytes = (uint8_t *)&scene;
+    for (size_t i = 0; i < recordSize; i++) bytes[i] = EEPROM.read(addr++);
+    defaultSceneTail(scene, recordSize);
+    swapLegacyRedGreen(scene);
+  }
+  settings.presetUsed = EEPROM.read(addr);
+  return true;
 }
 
-// Warm 설정 EEPROM에서 불러오기
-void loadWarmConfigFromEEPROM()
+// 저장된 레코드 불러오기 (없거나 손상되면 이전 레이아웃에서 변환)
+void loadSettings()
 {
-  // 색온도 로드
-  uint8_t temp = EEPROM.read(EEPROM_WARM_COLORTEMP_ADDR);
-  if (temp != 0xFF && temp >= 20 && temp <= 60) {
-    warmColorTemp = temp * 100;
+  EEPROM.get(SETTINGS_ADDR, settings);
+
+  size_t oldSize = settings.version == 2 ? SCENE_RECORD_V2_SIZE
+                  : settings.version == 3 ? SCENE_RECORD_V3_SIZE
+                  : settings.version == 4 ? SCENE_RECORD_V4_SIZE : 0;
+  if (settings.magic == SETTINGS_MAGIC && oldSize && loadSettingsOld(oldSize))
+  {
+    LOG_INFO("설정 레코드 버전 %d에서 변환", settings.version);
+    applyScene(settings.current);
+    saveSettings();
+    return;
+  }
+
+  if (settings.magic != SETTINGS_MAGIC || settings.version != SETTINGS_VERSION ||
+      settings.checksum != settingsChecksum(settings))
+  {
+    SceneRecord scene;
+    if (settings.magic == SETTINGS_MAGIC)
+    {
+      // 레코드 형식이 바뀐 경우: 이전 레코드는 해석할 수 없으므로 기본값 사용
+      LOG_WARN("설정 레코드 형식 변경, 기본값 사용");
+      defaultScene(scene);
+    }
+    else
+    {
+      LOG_WARN("저장된 설정 레코드 없음, 이전 형식에서 변환");
+      loadLegacyScene(scene);
+    }
+    memset(&settings, 0, sizeof(settings));
+    settings.syncRole = SYNC_OFF;
+    applyScene(scene);
+    saveSettings();
+    return;
+  }
+
+  applyScene(settings.current);
+  LOG_INFO("EEPROM 설정 로드 완료");
+}
+
+// 효과 설정 항목이 바뀐 뒤 파생 값 갱신 (웜라이트 기준 RGB는 여기서 한 번만 계산)
+void paramChanged(uint8_t id)
+{
+  if (id == PARAM_WARM_TEMP) warmBaseColor = kelvinToRGB(param(PARAM_WARM_TEMP));
+}
+
+// 노말 모드 백색점 적용: FastLED 색온도 보정은 show() 때 밝기와 함께 적용되므로 추가 비용 없음
+void applyWhitePoint()
+{
+  if (currentMode == NORMAL_MODE && normalWhitePoint != 0)
+  {
+    FastLED.setTemperature(kelvinToRGB(normalWhitePoint));
+  }
+  else
+  {
+    FastLED.setTemperature(CRGB(UncorrectedTemperature));
+  }
+}
+
+// 모드별 기본 팔레트
+uint8_t modeDefaultPalette(Mode mode)
+{
+  switch (mode)
+  {
+    case CAMPFIRE_MODE: return PALETTE_CAMPFIRE;
+    case CHRISTMAS_MODE: return PALETTE_CHRISTMAS;
+    case OCEAN_MODE: return PALETTE_OCEAN;
+    case LAVA_MODE: return PALETTE_LAVA;
+    default: return PALETTE_AURORA;
   }
-  
-  uint8_t chance = EEPROM.read(EEPROM_WARM_CHANCE_ADDR);
-  uint8_t minBr = EEPROM.read(EEPROM_WARM_MIN_ADDR);
-  uint8_t maxBr = EEPROM.read(EEPROM_WARM_MAX_ADDR);
-  uint8_t speed = EEPROM.read(EEPROM_WARM_SPEED_ADDR);
-  uint8_t smooth = EEPROM.read(EEPROM_WARM_SMOOTH_ADDR);
-  
-  if (chance != 0xFF) warmChangeChance = chance;
-  if (minBr != 0xFF) warmMinBrightness = minBr;
-  if (maxBr != 0xFF) warmMaxBrightness = maxBr;
-  if (speed != 0xFF) warmUpdateSpeed = speed;
-  if (smooth != 0xFF) warmSmoothness = smooth;
-  
-  Serial.println("Warm Light 설정 EEPROM 로드 완료");
+}
+
+// 현재 모드와 선택에 맞는 팔레트로 전환 시작
+void selectPalette()
+{
+  setTargetPalette(paletteSel != PALETTE_AUTO ? paletteSel : modeDefaultPalette(currentMode));
+}
+
+// 프리셋 불러오기: 플래시 쓰기 없이 전체 상태를 한 번에 교체
+bool recallPreset(uint8_t slot)
+{
+  if (slot >= PRESET_COUNT || !(settings.presetUsed & (1 << slot))) return false;
+  if (applyScene(settings.presets[slot])) updateDisplay();
+  LOG_INFO("프리셋 불러오기: %d", slot);
+  return true;
 }
 
 // 웹 서버 설정
 void setupWebServer()
 {
-  server.on("/", handleRoot);
-  server.on("/status", handleStatus);
-  server.on("/setMode", handleSetMode);
-  server.on("/setColor", handleSetColor);
-  server.on("/setBrightness", handleSetBrightness);
-  server.on("/setWarmConfig", handleSetWarmConfig);
-  server.on("/getWarmConfig", handleGetWarmConfig);
+  // 각 핸들러는 timedRequest()로 감싸 지연/힙 통계를 기록
+  server.on("/", []() { timedRequest(EP_ROOT, handleRoot); });
+  server.on("/status", []() { timedRequest(EP_STATUS, handleStatus); });
+  server.on("/setMode", []() { timedRequest(EP_SET_MODE, handleSetMode); });
+  server.on("/setColor", []() { timedRequest(EP_SET_COLOR, handleSetColor); });
+  server.on("/setBrightness", []() { timedRequest(EP_SET_BRIGHTNESS, handleSetBrightness); });
+  server.on("/params", []() { timedRequest(EP_PARAMS, handleParams); });
+  server.on("/metrics", handleMetrics);
+  server.on("/sync", handleSync);
+  server.on("/presets", handlePresets);
+  server.on("/savePreset", handleSavePreset);
+  server.on("/recallPreset", handleRecallPreset);
+  server.on("/setWhitePoint", handleSetWhitePoint);
+  server.on("/layout", handleLayout);
+  server.on("/palette", handlePalette);
+  server.on("/layers", handleLayers);
+  server.on("/trace", handleTrace);
+  server.on("/output", handleOutput);
 }
 
 // 메인 HTML 페이지
 void handleRoot()
 {
-  String html = "<!DOCTYPE html><html><head><meta charset='UTF-8'>";
-  html += "<meta name='viewport' content='width=device-width, initial-scale=1.0'>";
-  html += "<title>IoT Mood Light</title><style>";
-  html += "body{font-family:Arial,sans-serif;max-width:600px;margin:20px auto;padding:20px;background:#f0f0f0}";
-  html += "h1{text-align:center;color:#333}";
-  html += ".panel{background:white;padding:20px;margin:15px 0;border-radius:8px;box-shadow:0 2px 4px rgba(0,0,0,0.1)}";
-  html += ".mode-btn{display:inline-block;padding:12px 20px;margin:5px;background:#4CAF50;color:white;border:none;border-radius:5px;cursor:pointer;font-size:14px}";
-  html += ".mode-btn:hover{background:#45a049}";
-  html += ".mode-btn.active{background:#FF9800}";
-  html += ".slider-container{margin:15px 0}";
-  html += ".slider-label{display:flex;justify-content:space-between;margin-bottom:5px;color:#555}";
-  html += "input[type=range],select{width:100%;height:8px;border-radius:5px;outline:none}";
-  html += "select{height:35px;padding:5px;font-size:14px}";
-  html += ".status{padding:10px;background:#e3f2fd;border-left:4px solid #2196F3;margin:15px 0;border-radius:4px}";
-  html += "#colorPreview{width:100%;height:50px;border-radius:5px;margin-top:10px;border:2px solid #ddd}";
-  html += "</style></head><body>";
-  html += "<h1>IoT Mood Light</h1>";
-  
-  html += "<div class='panel'><h3>Status</h3><div class='status'>";
-  html += "<div>Mode: <strong id='mode'>-</strong></div>";
-  html += "<div>Brightness: <strong id='brightness'>-</strong></div>";
-  html += "<div>RGB: (<span id='r'>-</span>, <span id='g'>-</span>, <span id='b'>-</span>)</div>";
-  html += "</div></div>";
-  
-  html += "<div class='panel'><h3>Mode</h3>";
-  html += "<button class='mode-btn' onclick='setMode(0)'>Normal</button>";
-  html += "<button class='mode-btn' onclick='setMode(1)'>Campfire</button>";
-  html += "<button class='mode-btn' onclick='setMode(2)'>Christmas</button>";
-  html += "<button class='mode-btn' onclick='setMode(3)'>Warm Light</button>";
-  html += "<button class='mode-btn' onclick='setMode(4)'>Beatsin</button>";
-  html += "</div>";
-  
-  html += "<div class='panel'><h3>Brightness</h3>";
-  html += "<div class='slider-container'><div class='slider-label'><span>Brightness</span><span id='bVal'>50</span></div>";
-  html += "<input type='range' id='bSlider' min='0' max='255' value='50' oninput='setBright(this.value)'>";
-  html += "</div></div>";
-  
-  html += "<div class='panel'><h3>Color (Normal Mode)</h3>";
-  html += "<div class='slider-container'><div class='slider-label'><span>Red</span><span id='rVal'>255</span></div>";
-  html += "<input type='range' id='rSlider' min='0' max='255' value='255' oninput='setColor()'></div>";
-  html += "<div class='slider-container'><div class='slider-label'><span>Green</span><span id='gVal'>255</span></div>";
-  html += "<input type='range' id='gSlider' min='0' max='255' value='255' oninput='setColor()'></div>";
-  html += "<div class='slider-container'><div class='slider-label'><span>Blue</span><span id='bSlider2'>255</span></div>";
-  html += "<input type='range' id='blSlider' min='0' max='255' value='255' oninput='setColor()'></div>";
-  html += "<div id='preview'></div></div>";
-  
-  html += "<div class='panel' id='warmPanel' style='display:none'><h3>Warm Light Settings</h3>";
-  html += "<div class='slider-container'><div class='slider-label'><span>Color Temperature</span></div>";
-  html += "<select id='wtempSelect' onchange='setWarmConfig()'>";
-  html += "<option value='2000'>2000K (Candlelight)</option>";
-  html += "<option value='3000' selected>3000K (Warm)</option>";
-  html += "<option value='4000'>4000K (Neutral)</option>";
-  html += "<option value='5000'>5000K (Daylight)</option>";
-  html += "<option value='6000'>6000K (Cool)</option>";
-  html += "</select></div>";
-  html += "<div class='slider-container'><div class='slider-label'><span>Change Rate (%)</span><span id='wcVal'>20</span></div>";
-  html += "<input type='range' id='wcSlider' min='1' max='100' value='20' oninput='setWarmConfig()'></div>";
-  html += "<div class='slider-container'><div class='slider-label'><span>Min Brightness</span><span id='wminVal'>0</span></div>";
-  html += "<input type='range' id='wminSlider' min='0' max='255' value='0' oninput='setWarmConfig()'></div>";
-  html += "<div class='slider-container'><div class='slider-label'><span>Max Brightness</span><span id='wmaxVal'>255</span></div>";
-  html += "<input type='range' id='wmaxSlider' min='0' max='255' value='255' oninput='setWarmConfig()'></div>";
-  html += "<div class='slider-container'><div class='slider-label'><span>Speed (ms)</span><span id='wsVal'>50</span></div>";
-  html += "<input type='range' id='wsSlider' min='20' max='200' value='50' oninput='setWarmConfig()'></div>";
-  html += "<div class='slider-container'><div class='slider-label'><span>Smoothness</span><span id='wsmVal'>8</span></div>";
-  html += "<input type='range' id='wsmSlider' min='1' max='20' value='8' oninput='setWarmConfig()'></div>";
-  html += "</div>";
-  
-  html += "<script>";
-  html += "var modes=['Normal','Campfire','Christmas','Warm Light','Beatsin'];";
-  html += "function updateStatus(){fetch('/status').then(r=>r.json()).then(d=>{";
-  html += "document.getElementById('mode').textContent=modes[d.mode];";
-  html += "document.getElementById('brightness').textContent=d.brightness;";
-  html += "document.getElementById('r').textContent=d.red;";
-  html += "document.getElementById('g').textContent=d.green;";
-  html += "document.getElementById('b').textContent=d.blue;";
-  html += "document.getElementById('rSlider').value=d.red;";
-  html += "document.getElementById('gSlider').value=d.green;";
-  html += "document.getElementById('blSlider').value=d.blue;";
-  html += "document.getElementById('bSlider').value=d.brightness;";
-  html += "document.getElementById('rVal').textContent=d.red;";
-  html += "document.getElementById('gVal').textContent=d.green;";
-  html += "document.getElementById('bSlider2').textContent=d.blue;";
-  html += "document.getElementById('bVal').textContent=d.brightness;";
-  html += "updatePreview();highlightMode(d.mode);";
-  html += "}).catch(err=>console.error(err));}";
-  html += "function highlightMode(m){var btns=document.querySelectorAll('.mode-btn');";
-  html += "btns.forEach((btn,i)=>{btn.classList.toggle('active',i===m);});";
-  html += "document.getElementById('warmPanel').style.display=m===3?'block':'none';";
-  html += "if(m===3)loadWarmConfig();}";
-  html += "function loadWarmConfig(){fetch('/getWarmConfig').then(r=>r.json()).then(d=>{";
-  html += "document.getElementById('wtempSelect').value=d.temp;";
-  html += "document.getElementById('wcSlider').value=d.chance;";
-  html += "document.getElementById('wminSlider').value=d.minBright;";
-  html += "document.getElementById('wmaxSlider').value=d.maxBright;";
-  html += "document.getElementById('wsSlider').value=d.speed;";
-  html += "document.getElementById('wsmSlider').value=d.smooth;";
-  html += "document.getElementById('wcVal').textContent=d.chance;";
-  html += "document.getElementById('wminVal').textContent=d.minBright;";
-  html += "document.getElementById('wmaxVal').textContent=d.maxBright;";
-  html += "document.getElementById('wsVal').textContent=d.speed;";
-  html += "document.getElementById('wsmVal').textContent=d.smooth;";
-  html += "}).catch(err=>console.error(err));}";
-  html += "function setWarmConfig(){var temp=document.getElementById('wtempSelect').value;";
-  html += "var c=document.getElementById('wcSlider').value;";
-  html += "var min=document.getElementById('wminSlider').value;";
-  html += "var max=document.getElementById('wmaxSlider').value;";
-  html += "var s=document.getElementById('wsSlider').value;";
-  html += "var sm=document.getElementById('wsmSlider').value;";
-  html += "document.getElementById('wcVal').textContent=c;";
-  html += "document.getElementById('wminVal').textContent=min;";
-  html += "document.getElementById('wmaxVal').textContent=max;";
-  html += "document.getElementById('wsVal').textContent=s;";
-  html += "document.getElementById('wsmVal').textContent=sm;";
-  html += "fetch('/setWarmConfig?temp='+temp+'&c='+c+'&min='+min+'&max='+max+'&s='+s+'&sm='+sm);}";
-  html += "function updatePreview(){var r=document.getElementById('rSlider').value;";
-  html += "var g=document.getElementById('gSlider').value;";
-  html += "var b=document.getElementById('blSlider').value;";
-  html += "document.getElementById('preview').style.backgroundColor='rgb('+r+','+g+','+b+')';}";
-  html += "function setMode(m){fetch('/setMode?mode='+m).then(()=>setTimeout(updateStatus,100));}";
-  html += "function setColor(){var r=document.getElementById('rSlider').value;";
-  html += "var g=document.getElementById('gSlider').value;";
-  html += "var b=document.getElementById('blSlider').value;";
-  html += "document.getElementById('rVal').textContent=r;";
-  html += "document.getElementById('gVal').textContent=g;";
-  html += "document.getElementById('bSlider2').textContent=b;";
-  html += "updatePreview();fetch('/setColor?r='+r+'&g='+g+'&b='+b);}";
-  html += "function setBright(v){document.getElementById('bVal').textContent=v;";
-  html += "fetch('/setBrightness?value='+v);}";
-  html += "updateStatus();setInterval(updateStatus,3000);";
-  html += "</script></body></html>";
-  
-  server.send(200, "text/html", html);
+  server.send_P(200, "text/html", INDEX_HTML);
+}
+
+// 요청 인자를 정수로 읽기 (없거나 숫자가 아니면 false)
+bool argInt(const char *name, int &out)
+{
+  if (!server.hasArg(name)) return false;
+  return parseIntStrict(server.arg(name), out);
+}
+
+// JSON 응답 전송 (버퍼 초과 시 500)
+void sendJson(const JsonWriter &json)
+{
+  if (json.overflowed())
+  {
+    server.send(500, "text/plain", "Response too large");
+    return;
+  }
+  server.send(200, "application/json", json.c_str(), json.length());
 }
 
 // 현재 상태 반환 (JSON)
 void handleStatus()
 {
-  String json = "{";
-  json += "\"mode\":" + String((int)currentMode) + ",";
-  json += "\"red\":" + String(mr) + ",";
-  json += "\"green\":" + String(mg) + ",";
-  json += "\"blue\":" + String(mb) + ",";
-  json += "\"brightness\":" + String(FastLED.getBrightness());
-  json += "}";
-  
-  server.send(200, "application/json", json);
+  JsonWriter json(jsonBuffer, sizeof(jsonBuffer));
+  json.beginObject();
+  json.field("mode", (int)currentMode);
+  json.field("red", mr);
+  json.field("green", mg);
+  json.field("blue", mb);
+  json.field("brightness", FastLED.getBrightness());
+  json.field("whitePoint", normalWhitePoint);
+  json.field("quality", qualityLevel());
+  json.field("overruns", quality.overruns);
+  json.endObject();
+
+  sendJson(json);
 }
 
 // 모드 변경
 void handleSetMode()
 {
-  if (server.hasArg("mode"))
+  int modeValue;
+  if (argInt("mode", modeValue) && modeValue >= 0 && modeValue < MODE_COUNT)
   {
-    int modeValue = server.arg("mode").toInt();
-    if (modeValue >= 0 && modeValue <= 4)
-    {
-      currentMode = (Mode)modeValue;
-      saveModeToEEPROM(currentMode);
-      updateDisplay();
-      Serial.print("웹에서 모드 변경: ");
-      Serial.println(modeValue);
-      server.send(200, "text/plain", "OK");
-      return;
-    }
+    intakeMode(modeValue, true);
+    server.send(200, "text/plain", "OK");
+    return;
   }
   server.send(400, "text/plain", "Invalid mode");
 }
@@ -760,19 +1311,11 @@ void handleSetMode()
 // 색상 변경
 void handleSetColor()
 {
-  if (server.hasArg("r") && server.hasArg("g") && server.hasArg("b"))
-  {
-    mr = server.arg("r").toInt();
-    mg = server.arg("g").toInt();
-    mb = server.arg("b").toInt();
-    
-    saveColorToEEPROM(mr, mg, mb, FastLED.getBrightness());
-    
-    Serial.print("웹에서 색상 변경: R=");
-    Serial.print(mr); Serial.print(" G=");
-    Serial.print(mg); Serial.print(" B=");
-    Serial.println(mb);
-    
+  int r, g, b;
+  if (argInt("r", r) && argInt("g", g) && argInt("b", b) &&
+      r >= 0 && r <= 255 && g >= 0 && g <= 255 && b >= 0 && b <= 255)
+  {
+    intakeColor(r, g, b, true);
     server.send(200, "text/plain", "OK");
     return;
   }
@@ -782,69 +1325,576 @@ void handleSetColor()
 // 밝기 변경
 void handleSetBrightness()
 {
-  if (server.hasArg("value"))
+  int brightness;
+  if (argInt("value", brightness) && brightness >= 0 && brightness <= 255)
+  {
+    intakeBrightness(brightness, true);
+    server.send(200, "text/plain", "OK");
+    return;
+  }
+  server.send(400, "text/plain", "Invalid brightness");
+}
+
+// 효과 설정 항목 조회/변경 (mode: 대상 모드, 생략하면 현재 모드)
+// 항목 이름=값 인자가 있으면 모두 검사한 뒤 한꺼번에 변경, 응답은 모드의 항목 목록
+void handleParams()
+{
+  int mode = currentMode;
+  if (server.hasArg("mode") && (!argInt("mode", mode) || mode < 0 || mode >= MODE_COUNT))
+  {
+    server.send(400, "text/plain", "Invalid mode");
+    return;
+  }
+
+  // 그 모드에 없는 이름이나 범위 밖 값이 하나라도 있으면 아무것도 바꾸지 않음
+  // (이름은 모드 안에서만 유일하므로 "speed"는 모드마다 다른 항목)
+  for (uint8_t i = 0; i < server.args(); i++)
   {
-    int brightness = server.arg("value").toInt();
-    if (brightness >= 0 && brightness <= 255)
+    const char *name = server.argName(i);
+    if (strcmp(name, "mode") == 0) continue;
+    int id = paramFind(mode, name);
+    if (id < 0)
+    {
+      server.send(400, "text/plain", "Unknown parameter");
+      return;
+    }
+    int value;
+    if (!argInt(name, value) || value < paramTable[id].min || value > paramTable[id].max)
     {
-      FastLED.setBrightness(brightness);
-      saveColorToEEPROM(mr, mg, mb, brightness);
-      
-      Serial.print("웹에서 밝기 변경: ");
-      Serial.println(brightness);
-      
-      server.send(200, "text/plain", "OK");
+      server.send(400, "text/plain", "Invalid value");
       return;
     }
   }
-  server.send(400, "text/plain", "Invalid brightness");
+  for (uint8_t i = 0; i < server.args(); i++)
+  {
+    int id = paramFind(mode, server.argName(i));
+    int value;
+    if (id >= 0 && argInt(server.argName(i), value)) intakeParam(id, value, true);
+  }
+
+  JsonWriter json(jsonBuffer, sizeof(jsonBuffer));
+  json.beginObject();
+  json.field("mode", mode);
+  json.key("params");
+  json.beginArray();
+  for (uint8_t id = 0; id < paramCount; id++)
+  {
+    if (!paramInMode(id, mode)) continue;
+    const ParamDesc &desc = paramTable[id];
+    // 방금 받은 변경은 다음 loop에서 적용되므로 대기 중인 값을 보여줌
+    bool pending = pendingCommands.paramDirty & (1UL << id);
+    json.beginObject();
+    json.field("name", desc.name);
+    json.field("label", desc.label);
+    json.field("value", pending ? pendingCommands.params[id] : param(id));
+    json.field("min", desc.min);
+    json.field("max", desc.max);
+    json.field("def", desc.def);
+    json.field("step", desc.step);
+    json.endObject();
+  }
+  json.endArray();
+  json.endObject();
+
+  sendJson(json);
 }
 
-// Warm Light 설정 가져오기
-void handleGetWarmConfig()
+// 지연 통계를 JSON 객체 필드로 추가
+void writeLatencyJson(JsonWriter &json, const LatencyStats &stats)
 {
-  String json = "{";
-  json += "\"temp\":" + String(warmColorTemp) + ",";
-  json += "\"chance\":" + String(warmChangeChance) + ",";
-  json += "\"minBright\":" + String(warmMinBrightness) + ",";
-  json += "\"maxBright\":" + String(warmMaxBrightness) + ",";
-  json += "\"speed\":" + String(warmUpdateSpeed) + ",";
-  json += "\"smooth\":" + String(warmSmoothness);
-  json += "}";
-  
-  server.send(200, "application/json", json);
+  uint32_t avg = stats.count ? stats.totalUs / stats.count : 0;
+  json.field("count", stats.count);
+  json.field("avgUs", avg);
+  json.field("p50Us", latencyPercentile(stats, 50));
+  json.field("p99Us", latencyPercentile(stats, 99));
+  json.field("maxUs", stats.maxUs);
 }
 
-// Warm Light 설정 변경
-void handleSetWarmConfig()
+// 요청 지연/처리량/힙 통계 반환 (JSON), ?reset=1 이면 초기화
+void handleMetrics()
 {
-  if (server.hasArg("temp") && server.hasArg("c") && server.hasArg("min") && 
-      server.hasArg("max") && server.hasArg("s") && server.hasArg("sm"))
+  unsigned long elapsed = millis() - metricsStartMillis;
+  if (elapsed == 0) elapsed = 1;
+
+  JsonWriter json(jsonBuffer, sizeof(jsonBuffer));
+  json.beginObject();
+  json.field("uptimeMs", millis());
+  json.key("boot");
+  json.beginObject();
+  json.field("firstLightUs", bootTimes.firstLightUs);
+  json.field("wifiMs", bootTimes.wifiMs);
+  json.field("displayMs", bootTimes.displayMs);
+  json.field("httpMs", bootTimes.httpMs);
+  json.field("servicesMs", bootTimes.servicesMs);
+  json.field("doneMs", bootTimes.doneMs);
+  json.endObject();
+  json.field("windowMs", elapsed);
+  json.field("freeHeap", ESP.getFreeHeap());
+  json.field("maxFreeBlock", ESP.getMaxFreeBlockSize());
+  json.field("heapFrag", ESP.getHeapFragmentation());
+  json.field("udpDropped", controlDropped);
+  json.field("inputDropped", (uint32_t)inputDropped);
+  json.key("log");
+  json.beginObject();
+  json.field("lines", logStats.lines);
+  json.field("dropped", logStats.dropped);
+  json.field("highWater", logStats.highWater);
+  json.field("pending", logUsed());
+  json.endObject();
+  json.key("commands");
+  json.beginObject();
+  json.field("received", intakeStats.received);
+  json.field("coalesced", intakeStats.coalesced);
+  json.field("applied", intakeStats.applied);
+  json.field("saves", intakeStats.saves);
+  json.endObject();
+  json.field("httpClients", server.activeClients());
+  json.field("effectArenaBytes", effectArenaSize);
+  json.field("idle", idleTracker.idle);
+  json.field("idleMs", idleTimeMs(millis()));
+  json.field("idleSleepMs", idleTracker.sleepTotalMs);
+  json.field("idleEntries", idleTracker.entries);
+  json.key("render");
+  json.beginObject();
+  writeLatencyJson(json, renderStats);
+  json.endObject();
+  json.key("interp");
+  json.beginObject();
+  writeLatencyJson(json, interpStats);
+  json.field("keyframes", interp.keyframes);
+  json.field("frames", interp.frames);
+  json.endObject();
+  json.key("compositor");
+  json.beginObject();
+  writeLatencyJson(json, compositeStats);
+  json.field("frames", compositorStats.frames);
+  json.field("pixels", compositorStats.pixels);
+  json.field("skipped", compositorStats.skipped);
+  json.field("allocFailures", compositorStats.allocFailures);
+  json.field("ramBytes", overlayBytes);
+  json.endObject();
+  json.key("loopGap");
+  json.beginObject();
+  writeLatencyJson(json, loopGapStats);
+  json.endObject();
+  json.key("chunks");
+  json.beginObject();
+  json.field("jobs", chunkStats.jobs);
+  json.field("chunks", chunkStats.chunks);
+  json.field("sliced", chunkStats.sliced);
+  json.endObject();
+  json.key("quality");
+  json.beginObject();
+  json.field("level", qualityLevel());
+  json.field("overruns", quality.overruns);
+  json.field("down", quality.stepsDown);
+  json.field("up", quality.stepsUp);
+  json.endObject();
+  json.key("pacer");
+  json.beginObject();
+  json.field("frames", framePacerStats.frames);
+  json.field("missed", framePacerStats.missed);
+  json.field("maxGapUs", framePacerStats.maxGapUs);
+  json.endObject();
+  json.key("endpoints");
+  json.beginObject();
+  for (int i = 0; i < EP_COUNT; i++)
+  {
+    const EndpointStats &stats = endpointStats[i];
+    json.key(endpointNames[i]);
+    json.beginObject();
+    writeLatencyJson(json, stats.latency);
+    json.field("perMin", (uint32_t)((uint64_t)stats.latency.count * 60000 / elapsed));
+    json.field("heapDropMax", stats.heapDropMax);
+    json.field("heapDropSum", stats.heapDropSum);
+    json.endObject();
+  }
+  json.endObject();
+  json.endObject();
+
+  sendJson(json);
+
+  int reset;
+  if (argInt("reset", reset) && reset == 1)
   {
-    int temp = server.arg("temp").toInt();
-    if (temp == 2000 || temp == 3000 || temp == 4000 || temp == 5000 || temp == 6000)
+    resetMetrics();
+    memset(&intakeStats, 0, sizeof(intakeStats));
+  }
+}
+
+// 시계 동기화 상태 반환/역할 변경 (?role=0 끔, 1 리더, 2 팔로워)
+void handleSync()
+{
+  if (server.hasArg("role"))
+  {
+    int role;
+    if (!argInt("role", role) || role < SYNC_OFF || role > SYNC_FOLLOWER)
     {
-      warmColorTemp = temp;
+      server.send(400, "text/plain", "Invalid role");
+      return;
     }
-    
-    warmChangeChance = constrain(server.arg("c").toInt(), 1, 100);
-    warmMinBrightness = constrain(server.arg("min").toInt(), 0, 255);
-    warmMaxBrightness = constrain(server.arg("max").toInt(), 0, 255);
-    warmUpdateSpeed = constrain(server.arg("s").toInt(), 20, 200);
-    warmSmoothness = constrain(server.arg("sm").toInt(), 1, 20);
-    
-    saveWarmConfigToEEPROM();  // EEPROM에 저장
-    
-    Serial.println("Warm Light 설정 변경:");
-    Serial.print("  색온도: "); Serial.print(warmColorTemp); Serial.println("K");
-    Serial.print("  변화 확률: "); Serial.println(warmChangeChance);
-    Serial.print("  밝기 범위: "); Serial.print(warmMinBrightness); 
-    Serial.print(" - "); Serial.println(warmMaxBrightness);
-    Serial.print("  속도: "); Serial.println(warmUpdateSpeed);
-    Serial.print("  부드러움: "); Serial.println(warmSmoothness);
-    
+    frameSyncBegin((SyncRole)role);
+    requestSave(millis());  // 다른 설정 변경처럼 조용해진 뒤 한 번에 저장 (플래시 쓰기로 프레임이 멈추지 않게)
+    LOG_INFO("동기화 역할 변경: %d", role);
+  }
+
+  JsonWriter json(jsonBuffer, sizeof(jsonBuffer));
+  json.beginObject();
+  json.field("role", (int)syncRole);
+  json.field("locked", isSyncLocked());
+  json.field("offsetMs", (long)syncOffset);
+  json.field("lastErrorMs", (long)syncLastError);
+  json.field("latencyMs", syncLatency);
+  json.field("rttMs", syncRtt);
+  json.field("seed", (unsigned long)effectSeed);
+  json.endObject();
+
+  sendJson(json);
+}
+
+// 프리셋 목록 반환 (JSON)
+void handlePresets()
+{
+  JsonWriter json(jsonBuffer, sizeof(jsonBuffer));
+  json.beginObject();
+  json.key("presets");
+  json.beginArray();
+  for (uint8_t i = 0; i < PRESET_COUNT; i++)
+  {
+    const SceneRecord &scene = settings.presets[i];
+    bool used = settings.presetUsed & (1 << i);
+    json.beginObject();
+    json.field("slot", i);
+    json.field("used", used);
+    if (used)
+    {
+      json.field("mode", scene.mode);
+      json.field("red", scene.red);
+      json.field("green", scene.green);
+      json.field("blue", scene.blue);
+      json.field("brightness", scene.brightness);
+    }
+    json.endObject();
+  }
+  json.endArray();
+  json.endObject();
+
+  sendJson(json);
+}
+
+// 현재 상태를 프리셋 슬롯에 저장 (?slot=N)
+void handleSavePreset()
+{
+  int slot;
+  if (argInt("slot", slot) && slot >= 0 && slot < PRESET_COUNT)
+  {
+    captureScene(settings.presets[slot]);
+    settings.presetUsed |= (1 << slot);
+    requestSave(millis());
+    LOG_INFO("프리셋 저장: %d", slot);
+    server.send(200, "text/plain", "OK");
+    return;
+  }
+  server.send(400, "text/plain", "Invalid slot");
+}
+
+// 프리셋 불러오기 (?slot=N), 플래시에는 쓰지 않음
+void handleRecallPreset()
+{
+  int slot;
+  if (argInt("slot", slot) && slot >= 0 && recallPreset(slot))
+  {
     server.send(200, "text/plain", "OK");
     return;
   }
-  server.send(400, "text/plain", "Invalid config");
+  server.send(400, "text/plain", "Invalid slot");
+}
+
+// 노말 모드 백색점 변경 (?k=1500~10000, 0이면 보정 끔)
+void handleSetWhitePoint()
+{
+  int kelvin;
+  if (argInt("k", kelvin) && (kelvin == 0 || isValidKelvin(kelvin)))
+  {
+    intakeWhitePoint(kelvin, true);
+    server.send(200, "text/plain", "OK");
+    return;
+  }
+  server.send(400, "text/plain", "Invalid white point");
+}
+
+// 픽셀 배치 조회/변경
+// GET  /layout                          현재 배치 반환
+// GET  /layout?type=N&w=W&h=H           규칙형 배치로 변경 (0: 1줄, 1: 행렬, 2: 지그재그)
+// POST /layout?type=3&w=W&h=H&offset=N  사용자 정의 좌표 (본문: 픽셀마다 x, y 바이트, 나누어 업로드 가능)
+void handleLayout()
+{
+  if (server.hasArg("type"))
+  {
+    int type, width = 1, height = 1;
+    if (!argInt("type", type) ||
+        (server.hasArg("w") && !argInt("w", width)) ||
+        (server.hasArg("h") && !argInt("h", height)) ||
+        !isValidLayout(type, width, height, NUMPIXELS))
+    {
+      server.send(400, "text/plain", "Invalid layout");
+      return;
+    }
+
+    if (type == LAYOUT_CUSTOM)
+    {
+      int offset = 0;
+      int length = server.bodyLength();
+      if ((server.hasArg("offset") && !argInt("offset", offset)) || (length & 1) ||
+          !layoutWriteCoords(offset, (const uint8_t *)server.body(), length / 2))
+      {
+        server.send(400, "text/plain", "Invalid coordinates");
+        return;
+      }
+      layoutBuildCustom(width, height, NUMPIXELS);
+    }
+    else
+    {
+      layoutBuild((LayoutType)type, width, height, NUMPIXELS);
+    }
+    requestStore(STORE_LAYOUT, millis());  // 플래시 쓰기는 조용해진 뒤 설정 저장과 함께
+    redrawRequested = true;
+    resetEffectArena();
+    LOG_INFO("픽셀 배치 변경: %s %ux%u", layoutTypeNames[layoutType], layoutWidth, layoutHeight);
+  }
+
+  JsonWriter json(jsonBuffer, sizeof(jsonBuffer));
+  json.beginObject();
+  json.field("type", layoutTypeNames[layoutType]);
+  json.field("width", layoutWidth);
+  json.field("height", layoutHeight);
+  json.field("count", NUMPIXELS);
+  json.field("grid", layoutGridValid);
+  json.endObject();
+
+  sendJson(json);
+}
+
+// 팔레트 조회/선택/업로드
+// GET  /palette         현재 선택과 팔레트 목록 반환
+// GET  /palette?id=N    팔레트 선택 (0: 모드별 기본)
+// POST /palette         사용자 팔레트 업로드 (본문: 칸마다 번호, R, G, B 바이트, 2~16칸) 후 선택
+void handlePalette()
+{
+  if (server.bodyLength() > 0)
+  {
+    if (!uploadCustomPalette((const uint8_t *)server.body(), server.bodyLength()))
+    {
+      server.send(400, "text/plain", "Invalid palette");
+      return;
+    }
+    intakePalette(PALETTE_CUSTOM, true);
+    LOG_INFO("사용자 팔레트 업로드: %d칸", customGradientLength / 4);
+  }
+  else if (server.hasArg("id"))
+  {
+    int id;
+    if (!argInt("id", id) || id < 0 || id >= PALETTE_COUNT)
+    {
+      server.send(400, "text/plain", "Invalid palette");
+      return;
+    }
+    intakePalette(id, true);
+  }
+
+  JsonWriter json(jsonBuffer, sizeof(jsonBuffer));
+  json.beginObject();
+  json.field("selected", paletteSel);
+  json.field("active", paletteNames[targetPaletteId < PALETTE_COUNT ? targetPaletteId : PALETTE_AUTO]);
+  json.field("blending", paletteBlending);
+  json.field("customEntries", customGradientLength / 4);
+  json.key("palettes");
+  json.beginArray();
+  for (uint8_t i = 0; i < PALETTE_COUNT; i++) json.value(paletteNames[i]);
+  json.endArray();
+  json.endObject();
+
+  sendJson(json);
+}
+
+// 합성 레이어 조회/설정
+// GET /layers : 레이어 목록
+// GET /layers?slot=0&mode=4&opacity=200&blend=add : 레이어 설정 (mode=-1이면 끔, 빠진 항목은 유지)
+void handleLayers()
+{
+  if (server.hasArg("slot"))
+  {
+    int slot, mode, opacity;
+    int blendMode = -1;
+    if (!argInt("slot", slot) || slot < 0 || slot >= OVERLAY_COUNT)
+    {
+      server.send(400, "text/plain", "Invalid slot");
+      return;
+    }
+    OverlayLayer *layer = overlays[slot];
+    mode = layer != nullptr ? layer->mode : -1;
+    opacity = layer != nullptr ? layer->opacity : 255;
+    if ((server.hasArg("mode") && (!argInt("mode", mode) || mode < -1 || mode >= MODE_COUNT)) ||
+        (server.hasArg("opacity") && (!argInt("opacity", opacity) || opacity < 0 || opacity > 255)))
+    {
+      server.send(400, "text/plain", "Invalid layer");
+      return;
+    }
+    if (server.hasArg("blend"))
+    {
+      for (uint8_t i = 0; i < BLEND_COUNT; i++)
+      {
+        if (strcmp(server.arg("blend"), blendModeNames[i]) == 0) blendMode = i;
+      }
+      if (blendMode < 0 && (!argInt("blend", blendMode) || blendMode < 0 || blendMode >= BLEND_COUNT))
+      {
+        server.send(400, "text/plain", "Invalid blend");
+        return;
+      }
+    }
+
+    if (mode < 0)
+    {
+      // 끄면 버퍼를 바로 돌려줌
+      overlayFree(slot, EFFECT_ARENA_SIZE);
+      LOG_INFO("레이어 %d: off", slot);
+    }
+    else
+    {
+      // 처음 켤 때 할당하고, 효과가 바뀌면 레이어 상태를 처음부터 다시 시작
+      bool fresh = layer == nullptr;
+      if (fresh) layer = overlayAlloc(slot, EFFECT_ARENA_SIZE);
+      if (layer == nullptr)
+      {
+        LOG_WARN("레이어 %d: 메모리 부족 (%u바이트)", slot, (unsigned)(sizeof(OverlayLayer) + EFFECT_ARENA_SIZE));
+        server.send(503, "text/plain", "Out of memory");
+        return;
+      }
+      if (fresh || mode != layer->mode)
+      {
+        memset(layer->arena, 0, EFFECT_ARENA_SIZE);
+        fill_solid(layer->pixels, MAX_LEDS, CRGB(0, 0, 0));
+        loadPalette(modeDefaultPalette((Mode)mode), layer->palette);
+        interpReset(layer->interp);
+        layer->mode = mode;
+        layer->redraw = true;
+      }
+      layer->opacity = opacity;
+      if (blendMode >= 0) layer->blend = blendMode;
+      layer->dirty = true;
+      LOG_INFO("레이어 %d: %s, 불투명도 %d, %s", slot, getModeName((Mode)mode), opacity,
+               blendModeNames[layer->blend]);
+    }
+  }
+
+  JsonWriter json(jsonBuffer, sizeof(jsonBuffer));
+  json.beginObject();
+  json.field("base", (int)currentMode);
+  json.field("ramBytes", overlayBytes);
+  json.key("layers");
+  json.beginArray();
+  for (uint8_t i = 0; i < OVERLAY_COUNT; i++)
+  {
+    const OverlayLayer *layer = overlays[i];
+    json.beginObject();
+    json.field("slot", i);
+    json.field("enabled", layer != nullptr);
+    json.field("mode", layer != nullptr ? (int)layer->mode : -1);
+    json.field("opacity", layer != nullptr ? layer->opacity : 0);
+    json.field("blend", blendModeNames[layer != nullptr ? layer->blend : BLEND_NORMAL]);
+    json.endObject();
+  }
+  json.endArray();
+  json.key("blendModes");
+  json.beginArray();
+  for (uint8_t i = 0; i < BLEND_COUNT; i++) json.value(blendModeNames[i]);
+  json.endArray();
+  json.endObject();
+
+  sendJson(json);
+}
+
+// 이벤트 추적 내려받기 (이진: TraceHeader + TraceRecord[], ?clear=1이면 내려받은 뒤 비움)
+void handleTrace()
+{
+  size_t length = traceSnapshot((uint8_t *)jsonBuffer);
+  if (length == 0)
+  {
+    server.send(404, "text/plain", "Trace disabled");
+    return;
+  }
+  int clear;
+  if (argInt("clear", clear) && clear == 1) traceClear();
+  server.send(200, "application/octet-stream", jsonBuffer, length);
+}
+
+// 출력 대상 조회/변경
+// strip=0|1: 스트립 출력 끄기/켜기, viewer=<IP>[&port=]: UDP 미리보기 켜기, viewer=off: 끄기
+// (호스트 빌드) spi=0|1, shm=0|1, socket=0|1: 데몬 옵션으로 경로를 정한 대상 끄기/켜기
+void handleOutput()
+{
+  int strip;
+  if (server.hasArg("strip"))
+  {
+    if (!argInt("strip", strip) || strip < 0 || strip > 1)
+    {
+      server.send(400, "text/plain", "Invalid strip");
+      return;
+    }
+    sinkEnable(SINK_STRIP, strip);
+  }
+  // 그 밖의 대상 (호스트 빌드의 spi/shm/socket)은 이름=0/1로 켜고 끔
+  for (uint8_t id = SINK_VIEWER + 1; id < SINK_COUNT; id++)
+  {
+    int on;
+    if (!server.hasArg(outputSinks[id].name)) continue;
+    if (!argInt(outputSinks[id].name, on) || on < 0 || on > 1)
+    {
+      server.send(400, "text/plain", "Invalid sink");
+      return;
+    }
+    sinkEnable(id, on);
+  }
+  if (server.hasArg("viewer"))
+  {
+    int port = VIEWER_DEFAULT_PORT;
+    if (strcmp(server.arg("viewer"), "off") == 0)
+    {
+      sinkEnable(SINK_VIEWER, false);
+    }
+    else if (viewerIP.fromString(server.arg("viewer")) &&
+             (!server.hasArg("port") || argInt("port", port)) && port > 0 && port <= 65535)
+    {
+      viewerPort = port;
+      sinkEnable(SINK_VIEWER, true);
+      LOG_INFO("미리보기 출력: %s:%d", server.arg("viewer"), port);
+    }
+    else
+    {
+      server.send(400, "text/plain", "Invalid viewer");
+      return;
+    }
+  }
+
+  JsonWriter json(jsonBuffer, sizeof(jsonBuffer));
+  json.beginObject();
+  json.field("periodMs", FRAME_PERIOD_MS);
+  json.field("frames", framePacerStats.frames);
+  json.field("missed", framePacerStats.missed);
+  json.field("viewerPort", viewerPort);
+  json.key("sinks");
+  json.beginArray();
+  for (uint8_t id = 0; id < SINK_COUNT; id++)
+  {
+    json.beginObject();
+    json.field("name", outputSinks[id].name);
+    json.field("enabled", sinkEnabled(id));
+    writeLatencyJson(json, sinkStats[id].latency);
+    json.field("errors", sinkStats[id].errors);
+    json.endObject();
+  }
+  json.endArray();
+  json.endObject();
+
+  sendJson(json);
 }
@@ -0,0 +1,134 @@
+// 요청 처리 지연 및 힙 통계 (/metrics)
+// 각 엔드포인트 핸들러를 감싸서 처리 시간(us), 힙 변화, 단편화를 기록한다.
+// 지연 분포는 2의 거듭제곱 구간 히스토그램으로 저장해 p50/p99를 근사한다.
+
+#define LATENCY_BUCKETS 20  // 1us ~ 2^19us(약 0.5초) 이상
+
+enum Endpoint {
+  EP_ROOT = 0,
+  EP_STATUS,
+  EP_SET_MODE,
+  EP_SET_COLOR,
+  EP_SET_BRIGHTNESS,
+  EP_PARAMS,
+  EP_COUNT
+};
+
+const char *const endpointNames[EP_COUNT] = {
+  "root", "status", "setMode", "setColor", "setBrightness", "params"
+};
+
+struct LatencyStats {
+  uint32_t count;
+  uint32_t totalUs;
+  uint32_t maxUs;
+  uint16_t hist[LATENCY_BUCKETS];
+};
+
+struct EndpointStats {
+  LatencyStats latency;
+  uint32_t heapDropMax;  // 요청 전후 가용 힙 감소량의 최대값
+  uint32_t heapDropSum;  // 누적 힙 감소량 (누수/단편화 추적용)
+};
+
+EndpointStats endpointStats[EP_COUNT];
+LatencyStats loopGapStats;           // loop() 호출 간격 (프레임 간 정지 시간)
+LatencyStats renderStats;            // 효과 계산 시간 (렌더링한 프레임만)
+LatencyStats interpStats;            // 단계 사이 보간 시간 (보간 출력한 프레임만)
+LatencyStats compositeStats;         // 오버레이 렌더링 + 합성 시간 (합성한 프레임만)
+unsigned long metricsStartMillis = 0;
+unsigned long lastLoopMicros = 0;
+
+// 지연 시간을 히스토그램 구간 번호로 변환 (floor(log2(us)))
+uint8_t latencyBucket(uint32_t us)
+{
+  uint8_t bucket = 0;
+  while (us > 1 && bucket < LATENCY_BUCKETS - 1)
+  {
+    us >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+void recordLatency(LatencyStats &stats, uint32_t us)
+{
+  stats.count++;
+  stats.totalUs += us;
+  if (us > stats.maxUs) stats.maxUs = us;
+  uint16_t &slot = stats.hist[latencyBucket(us)];
+  if (slot < 0xFFFF) slot++;
+}
+
+// 히스토그램에서 백분위 근사 (해당 구간의 상한값 반환, us)
+uint32_t latencyPercentile(const LatencyStats &stats, uint8_t percent)
+{
+  uint32_t total = 0;
+  for (int i = 0; i < LATENCY_BUCKETS; i++) total += stats.hist[i];
+  if (total == 0) return 0;
+
+  uint32_t target = (total * percent + 99) / 100;
+  uint32_t seen = 0;
+  for (int i = 0; i < LATENCY_BUCKETS; i++)
+  {
+    seen += stats.hist[i];
+    if (seen >= target)
+    {
+      uint32_t upper = (2UL << i) - 1;
+      return min(upper, stats.maxUs);
+    }
+  }
+  return stats.maxUs;
+}
+
+// 핸들러 실행 시간과 힙 변화를 측정
+void timedRequest(Endpoint ep, void (*handler)())
+{
+  uint32_t heapBefore = ESP.getFreeHeap();
+  unsigned long start = micros();
+
+  handler();
+
+  uint32_t elapsed = micros() - start;
+  uint32_t heapAfter = ESP.getFreeHeap();
+
+  EndpointStats &stats = endpointStats[ep];
+  recordLatency(stats.latency, elapsed);
+  if (heapAfter < heapBefore)
+  {
+    uint32_t drop = heapBefore - heapAfter;
+    stats.heapDropSum += drop;
+    if (drop > stats.heapDropMax) stats.heapDropMax = drop;
+  }
+}
+
+// loop() 시작마다 호출: 이전 loop() 이후 경과 시간 기록 (첫 호출은 0 반환)
+uint32_t recordLoopGap()
+{
+  unsigned long now = micros();
+  uint32_t gap = 0;
+  if (lastLoopMicros != 0)
+  {
+    gap = now - lastLoopMicros;
+    recordLatency(loopGapStats, gap);
+    if (gap > TRACE_STALL_US) traceRecord(TRACE_STALL, 0, traceDuration(gap));
+  }
+  lastLoopMicros = now;
+  return gap;
+}
+
+// 의도적인 대기(유휴 절전) 뒤에 호출: 대기 시간을 간격에 포함하지 않음
+void skipLoopGap()
+{
+  lastLoopMicros = micros();
+}
+
+void resetMetrics()
+{
+  memset(endpointStats, 0, sizeof(endpointStats));
+  memset(&loopGapStats, 0, sizeof(loopGapStats));
+  memset(&renderStats, 0, sizeof(renderStats));
+  memset(&interpStats, 0, sizeof(interpStats));
+  memset(&compositeStats, 0, sizeof(compositeStats));
+  metricsStartMillis = millis();
+}
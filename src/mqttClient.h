@@ -0,0 +1,583 @@
+// MQTT 클라이언트 (Home Assistant 연동)
+// credential.h 또는 build_flags에 아래 값이 정의된 경우에만 활성화된다.
+//   MQTT_HOST, MQTT_PORT(기본 1883), MQTT_USER/MQTT_PASSWORD(선택)
+//   WIFI_STA_SSID, WIFI_STA_PASSWORD (브로커가 있는 공유기 접속용, AP 모드와 동시 사용)
+//
+// Home Assistant MQTT light(JSON 스키마)를 사용한다.
+//   명령: moodlight/<id>/set    {"state":"ON","brightness":128,"color":{"r":..,"g":..,"b":..},"effect":"Campfire"}
+//   상태: moodlight/<id>/state  (retained, 변경이 있을 때만 한 번에 묶어서 발행)
+//   탐색: homeassistant/light/moodlight_<id>/config (retained, 접속 시 1회)
+// 수신한 명령은 UDP 제어 큐(queueControl)로 넘겨 다음 프레임 시작 시점에 적용된다.
+// 접속/탐색/상태 발행은 loop마다 한 단계씩만 진행하여 한 프레임이 길어지지 않게 한다.
+//
+// 접속은 TCP 연결, CONNECT 전송, CONNACK 확인을 서로 다른 loop에서 한다. ESP8266 WiFiClient에는
+// 기다리지 않는 connect()가 없으므로 TCP 연결은 MQTT_CONNECT_TIMEOUT까지만 기다리게 하고, 실패하면
+// 다음 시도를 5초에서 MQTT_RECONNECT_MAX까지 두 배씩 늦춘다. 브로커가 꺼져 있어도 프레임 정지는
+// 최대 MQTT_CONNECT_TIMEOUT이고 그마저 점점 드물어진다. CONNACK은 기다리지 않고 loop마다 받은 것만
+// 확인하며 MQTT_CONNACK_TIMEOUT이 지나도록 오지 않으면 같은 방식으로 다음 시도를 늦춘다.
+// PubSubClient의 connect()는 CONNACK이 올 때까지 loop를 멈추므로 쓰지 않고, 펌웨어가 쓰는
+// MQTT 3.1.1 패킷(CONNECT, PUBLISH QoS 0, SUBSCRIBE, PINGREQ)만 직접 만들어 보낸다.
+// mqttLoop()는 프레임을 출력한 직후에 불리므로 남은 대기(TCP 연결)도 다음 프레임 예산을 먼저 쓴다.
+
+#ifdef MQTT_HOST
+
+#ifndef MQTT_PORT
+#define MQTT_PORT 1883
+#endif
+#ifndef MQTT_USER
+#define MQTT_USER nullptr
+#define MQTT_PASSWORD nullptr
+#endif
+
+#define MQTT_RECONNECT_INTERVAL 5000  // 첫 재접속 시도 간격 (ms), 실패할 때마다 두 배
+#define MQTT_RECONNECT_MAX 300000     // 재접속 간격 상한 (5분)
+#define MQTT_CONNECT_TIMEOUT 200      // TCP 연결을 기다리는 최대 시간 (ms)
+#define MQTT_CONNACK_TIMEOUT 2000     // CONNECT를 보낸 뒤 CONNACK을 받아야 하는 기한 (ms)
+#define MQTT_KEEPALIVE 15             // keep alive (초), 그동안 주고받은 것이 없으면 PINGREQ
+#define MQTT_PUBLISH_INTERVAL 250     // 상태 발행 최소 간격 (ms), 그 사이 변경은 한 번에 묶음
+#define MQTT_BUFFER_SIZE 640          // 송신 패킷 최대 크기 (탐색 설정이 가장 큼)
+#define MQTT_RX_SIZE 256              // 수신 패킷 최대 크기 (명령 토픽), 더 큰 패킷은 버림
+#define MQTT_HEADER_MAX 5             // 고정 헤더 최대 길이 (종류 1 + 남은 길이 4)
+
+// 패킷 종류 (고정 헤더 첫 바이트)
+#define MQTT_PACKET_CONNECT 0x10
+#define MQTT_PACKET_CONNACK 0x20
+#define MQTT_PACKET_PUBLISH 0x30
+#define MQTT_PACKET_SUBSCRIBE 0x82
+#define MQTT_PACKET_PINGREQ 0xC0
+#define MQTT_PACKET_PINGRESP 0xD0
+
+extern Mode currentMode;
+const char* getModeName(Mode mode);
+
+// 발행된 상태 (변경 감지용)
+struct MqttLightState {
+  uint8_t mode;
+  uint8_t r, g, b;
+  uint8_t brightness;
+};
+
+enum MqttStage {
+  MQTT_STAGE_DISCONNECTED = 0,
+  MQTT_STAGE_TCP,      // TCP 연결됨, 다음 loop에서 MQTT CONNECT
+  MQTT_STAGE_CONNACK,  // CONNECT 보냄, loop마다 CONNACK 확인
+  MQTT_STAGE_SUBSCRIBE,
+  MQTT_STAGE_DISCOVERY,
+  MQTT_STAGE_READY
+};
+
+WiFiClient mqttNet;
+MqttStage mqttStage = MQTT_STAGE_DISCONNECTED;
+MqttLightState mqttPublished;
+bool mqttHasPublished = false;
+unsigned long mqttLastAttempt = 0;
+unsigned long mqttConnectSentAt = 0;  // CONNECT를 보낸 시각 (CONNACK 기한 기준)
+uint32_t mqttRetryDelay = 0;        // 다음 시도까지 간격 (ms), 0이면 바로 시도
+uint32_t mqttConnectFailures = 0;   // 연속 실패 횟수
+IPAddress mqttBrokerIP;             // 한 번 찾은 브로커 주소
+unsigned long mqttLastPublish = 0;
+unsigned long mqttLastIn = 0;       // 마지막으로 받은 시각 (keep alive)
+unsigned long mqttLastOut = 0;      // 마지막으로 보낸 시각 (keep alive)
+bool mqttPingPending = false;       // PINGREQ를 보내고 응답을 기다리는 중
+uint8_t mqttLastOnBrightness = 50;  // OFF 이후 ON 명령 시 복원할 밝기
+char mqttBaseTopic[32];
+char mqttObjectId[24];
+
+uint8_t mqttTx[MQTT_BUFFER_SIZE];  // 송신 패킷 (본문은 MQTT_HEADER_MAX부터, 고정 헤더는 보낼 때 바로 앞에)
+size_t mqttTxLength = 0;
+bool mqttTxOverflow = false;
+uint8_t mqttRx[MQTT_RX_SIZE];  // 아직 처리하지 않은 수신 바이트
+size_t mqttRxLength = 0;
+size_t mqttRxSkip = 0;  // 버퍼보다 커서 버리는 중인 패킷의 남은 바이트
+
+// 간단한 JSON 정수 필드 검색 ("key":123)
+bool mqttJsonInt(const char *json, const char *key, int &out)
+{
+  char pattern[16];
+  snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+  const char *p = strstr(json, pattern);
+  if (p == nullptr) return false;
+  p += strlen(pattern);
+  while (*p == ' ') p++;
+  if (*p < '0' || *p > '9') return false;
+  out = atoi(p);
+  return true;
+}
+
+// 간단한 JSON 문자열 필드 검색 ("key":"value")
+bool mqttJsonString(const char *json, const char *key, char *out, size_t outSize)
+{
+  char pattern[16];
+  snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+  const char *p = strstr(json, pattern);
+  if (p == nullptr) return false;
+  p += strlen(pattern);
+  while (*p == ' ') p++;
+  if (*p != '"') return false;
+  p++;
+  size_t n = 0;
+  while (*p && *p != '"' && n + 1 < outSize) out[n++] = *p++;
+  out[n] = '\0';
+  return true;
+}
+
+// 명령 토픽 수신: 필드별로 제어 큐에 추가
+void mqttCallback(char *topic, uint8_t *payload, unsigned int length)
+{
+  char json[192];
+  if (length >= sizeof(json)) return;
+  memcpy(json, payload, length);
+  json[length] = '\0';
+
+  char text[16];
+  int value;
+  uint8_t data[3];
+
+  if (mqttJsonString(json, "state", text, sizeof(text)) && strcmp(text, "OFF") == 0)
+  {
+    data[0] = 0;
+    queueControl(CTRL_OP_SET_BRIGHTNESS, data, 1, CTRL_FLAG_PERSIST);
+    return;
+  }
+
+  if (mqttJsonInt(json, "brightness", value))
+  {
+    data[0] = constrain(value, 0, 255);
+    queueControl(CTRL_OP_SET_BRIGHTNESS, data, 1, CTRL_FLAG_PERSIST);
+  }
+  else if (FastLED.getBrightness() == 0)
+  {
+    // 밝기 없이 ON만 온 경우 마지막 밝기로 복원
+    data[0] = mqttLastOnBrightness;
+    queueControl(CTRL_OP_SET_BRIGHTNESS, data, 1, CTRL_FLAG_PERSIST);
+  }
+
+  int r, g, b;
+  if (mqttJsonInt(json, "r", r) && mqttJsonInt(json, "g", g) && mqttJsonInt(json, "b", b))
+  {
+    data[0] = constrain(r, 0, 255);
+    data[1] = constrain(g, 0, 255);
+    data[2] = constrain(b, 0, 255);
+    queueControl(CTRL_OP_SET_COLOR, data, 3, CTRL_FLAG_PERSIST);
+  }
+
+  char effect[24];
+  if (mqttJsonString(json, "effect", effect, sizeof(effect)))
+  {
+    for (uint8_t m = 0; m < MODE_COUNT; m++)
+    {
+      if (strcmp(effect, getModeName((Mode)m)) == 0)
+      {
+        data[0] = m;
+        queueControl(CTRL_OP_SET_MODE, data, 1, CTRL_FLAG_PERSIST);
+        break;
+      }
+    }
+  }
+}
+
+void mqttBegin()
+{
+  snprintf(mqttObjectId, sizeof(mqttObjectId), "moodlight_%06x", ESP.getChipId());
+  snprintf(mqttBaseTopic, sizeof(mqttBaseTopic), "moodlight/%06x", ESP.getChipId());
+
+  WiFi.mode(WIFI_AP_STA);
+  WiFi.begin(WIFI_STA_SSID, WIFI_STA_PASSWORD);
+
+  mqttNet.setTimeout(MQTT_CONNECT_TIMEOUT);
+  mqttNet.setNoDelay(true);  // 작은 패킷을 모아 두지 않고 바로 보냄
+}
+
+// 송신 패킷 조립 시작 (본문은 mqttPut*으로 채우고 mqttPacketSend로 보냄)
+void mqttPacketStart()
+{
+  mqttTxLength = MQTT_HEADER_MAX;
+  mqttTxOverflow = false;
+}
+
+void mqttPut(const void *data, size_t length)
+{
+  if (mqttTxLength + length > sizeof(mqttTx))
+  {
+    mqttTxOverflow = true;  // 버퍼보다 큰 패킷은 보내지 않음
+    return;
+  }
+  memcpy(mqttTx + mqttTxLength, data, length);
+  mqttTxLength += length;
+}
+
+void mqttPutByte(uint8_t value)
+{
+  mqttPut(&value, 1);
+}
+
+// 길이(2바이트) + 문자열
+void mqttPutString(const char *text)
+{
+  size_t length = strlen(text);
+  mqttPutByte(length >> 8);
+  mqttPutByte(length & 0xFF);
+  mqttPut(text, length);
+}
+
+// 본문 바로 앞에 고정 헤더를 붙여 한 번에 보냄 (넘쳤거나 다 쓰지 못하면 false)
+bool mqttPacketSend(uint8_t type)
+{
+  if (mqttTxOverflow) return false;
+
+  uint8_t header[MQTT_HEADER_MAX];
+  size_t headerLength = 0;
+  size_t remaining = mqttTxLength - MQTT_HEADER_MAX;
+  header[headerLength++] = type;
+  do
+  {
+    uint8_t digit = remaining % 128;
+    remaining /= 128;
+    header[headerLength++] = digit | (remaining > 0 ? 0x80 : 0);
+  } while (remaining > 0);
+
+  uint8_t *packet = mqttTx + MQTT_HEADER_MAX - headerLength;
+  memcpy(packet, header, headerLength);
+  size_t length = mqttTxLength - MQTT_HEADER_MAX + headerLength;
+  if (mqttNet.write(packet, length) != length) return false;
+  mqttLastOut = millis();
+  return true;
+}
+
+bool mqttPublish(const char *topic, const char *payload, bool retained)
+{
+  mqttPacketStart();
+  mqttPutString(topic);
+  mqttPut(payload, strlen(payload));
+  return mqttPacketSend(MQTT_PACKET_PUBLISH | (retained ? 1 : 0));
+}
+
+// 명령 토픽 구독 (QoS 0, 세션마다 하나뿐이라 메시지 ID는 1로 고정)
+bool mqttSubscribe(const char *topic)
+{
+  mqttPacketStart();
+  mqttPutByte(0);
+  mqttPutByte(1);
+  mqttPutString(topic);
+  mqttPutByte(0);
+  return mqttPacketSend(MQTT_PACKET_SUBSCRIBE);
+}
+
+// CONNECT: clean session, 유언(willTopic에 "offline", retained), 계정은 정의된 경우에만
+bool mqttSendConnect(const char *willTopic)
+{
+  const char *user = MQTT_USER;
+  const char *password = MQTT_PASSWORD;
+  uint8_t flags = 0x02 | 0x04 | 0x20;
+  if (user != nullptr) flags |= 0x80;
+  if (password != nullptr) flags |= 0x40;
+
+  mqttPacketStart();
+  mqttPutString("MQTT");
+  mqttPutByte(4);  // 프로토콜 레벨 3.1.1
+  mqttPutByte(flags);
+  mqttPutByte(0);
+  mqttPutByte(MQTT_KEEPALIVE);
+  mqttPutString(mqttObjectId);
+  mqttPutString(willTopic);
+  mqttPutString("offline");
+  if (user != nullptr) mqttPutString(user);
+  if (password != nullptr) mqttPutString(password);
+  return mqttPacketSend(MQTT_PACKET_CONNECT);
+}
+
+// 연결을 닫고 처음 단계로 (다음 시도 간격은 그대로)
+void mqttDisconnect()
+{
+  mqttNet.stop();
+  mqttStage = MQTT_STAGE_DISCONNECTED;
+  mqttRxLength = 0;
+  mqttRxSkip = 0;
+}
+
+// 접속 실패: 다음 시도를 두 배 늦춤 (상한 MQTT_RECONNECT_MAX)
+void mqttBackOff()
+{
+  mqttDisconnect();
+  mqttConnectFailures++;
+  mqttRetryDelay = mqttRetryDelay == 0 ? MQTT_RECONNECT_INTERVAL : min(mqttRetryDelay * 2, (uint32_t)MQTT_RECONNECT_MAX);
+}
+
+// CONNACK 수락: 접속 완료를 알리고 구독 단계로
+void mqttSessionStart()
+{
+  char willTopic[48];
+  snprintf(willTopic, sizeof(willTopic), "%s/available", mqttBaseTopic);
+  mqttPublish(willTopic, "online", true);
+  mqttStage = MQTT_STAGE_SUBSCRIBE;
+  mqttHasPublished = false;
+  mqttPingPending = false;
+  mqttConnectFailures = 0;
+  mqttRetryDelay = MQTT_RECONNECT_INTERVAL;
+}
+
+// 완전히 받은 패킷 하나 처리
+void mqttHandlePacket(uint8_t type, uint8_t *body, size_t length)
+{
+  switch (type & 0xF0)
+  {
+    case MQTT_PACKET_CONNACK:
+      if (mqttStage != MQTT_STAGE_CONNACK) break;
+      if (length >= 2 && body[1] == 0) mqttSessionStart();
+      else mqttBackOff();  // 거절 (계정, 클라이언트 ID 등)
+      break;
+    case MQTT_PACKET_PUBLISH:
+    {
+      if (length < 2) break;
+      size_t topicLength = (body[0] << 8) | body[1];
+      size_t offset = 2 + topicLength + ((type & 0x06) != 0 ? 2 : 0);  // QoS 1/2면 메시지 ID가 붙음
+      char topic[48];
+      if (offset > length || topicLength >= sizeof(topic)) break;
+      memcpy(topic, body + 2, topicLength);
+      topic[topicLength] = '\0';
+      mqttCallback(topic, body + offset, length - offset);
+      break;
+    }
+    case MQTT_PACKET_PINGRESP:
+      mqttPingPending = false;
+      break;
+    default:
+      break;  // SUBACK 등은 확인하지 않음
+  }
+}
+
+// 버퍼 앞쪽의 완전한 패킷들을 처리하고 남은 바이트를 앞으로 당김
+void mqttParse()
+{
+  while (mqttRxLength > 0 && mqttStage != MQTT_STAGE_DISCONNECTED)
+  {
+    size_t length = 0, header = 0;
+    for (size_t i = 1, shift = 0; i < mqttRxLength && i < MQTT_HEADER_MAX; i++, shift += 7)
+    {
+      length |= (size_t)(mqttRx[i] & 0x7F) << shift;
+      if ((mqttRx[i] & 0x80) == 0)
+      {
+        header = i + 1;
+        break;
+      }
+    }
+    if (header == 0)
+    {
+      if (mqttRxLength >= MQTT_HEADER_MAX) mqttDisconnect();  // 잘못된 길이
+      return;
+    }
+    if (header + length > sizeof(mqttRx))
+    {
+      // 명령 토픽에 올 수 없는 큰 패킷: 나머지는 도착하는 대로 버림
+      mqttRxSkip = header + length - mqttRxLength;
+      mqttRxLength = 0;
+      return;
+    }
+    if (mqttRxLength < header + length) return;
+
+    mqttHandlePacket(mqttRx[0], mqttRx + header, length);
+    if (mqttRxLength < header + length) return;  // 처리 중 연결을 닫음
+    mqttRxLength -= header + length;
+    memmove(mqttRx, mqttRx + header + length, mqttRxLength);
+  }
+}
+
+// 이미 도착한 바이트만 읽어 처리 (기다리지 않음), 연결이 끊겼으면 false
+bool mqttReceive()
+{
+  while (mqttStage != MQTT_STAGE_DISCONNECTED && mqttNet.available() > 0)
+  {
+    int n;
+    if (mqttRxSkip > 0)
+    {
+      uint8_t scratch[64];
+      n = mqttNet.read(scratch, min(mqttRxSkip, sizeof(scratch)));
+      if (n > 0) mqttRxSkip -= n;
+    }
+    else
+    {
+      n = mqttNet.read(mqttRx + mqttRxLength, sizeof(mqttRx) - mqttRxLength);
+      if (n > 0)
+      {
+        mqttRxLength += n;
+        mqttParse();
+      }
+    }
+    if (n <= 0) break;
+    mqttLastIn = millis();
+  }
+  return mqttStage != MQTT_STAGE_DISCONNECTED && mqttNet.connected();
+}
+
+// keep alive: MQTT_KEEPALIVE 동안 주고받은 것이 없으면 PINGREQ, 그 응답도 없이 다시 지나면 끊김
+bool mqttKeepAlive()
+{
+  unsigned long now = millis();
+  if (now - mqttLastIn < MQTT_KEEPALIVE * 1000UL && now - mqttLastOut < MQTT_KEEPALIVE * 1000UL) return true;
+  if (mqttPingPending) return false;
+
+  mqttPacketStart();
+  if (!mqttPacketSend(MQTT_PACKET_PINGREQ)) return false;
+  mqttPingPending = true;
+  mqttLastIn = now;
+  return true;
+}
+
+// 접속 한 단계 진행: TCP 연결, 다음 호출에서 CONNECT 전송, 그 뒤로는 CONNACK 확인만
+void mqttConnectStep()
+{
+  switch (mqttStage)
+  {
+    case MQTT_STAGE_DISCONNECTED:
+    {
+      if (millis() - mqttLastAttempt < mqttRetryDelay) return;
+      mqttLastAttempt = millis();
+
+      // 주소 찾기는 한 번만 (IP 문자열이면 바로)
+      if (!mqttBrokerIP.isSet() && !mqttBrokerIP.fromString(MQTT_HOST) &&
+          !WiFi.hostByName(MQTT_HOST, mqttBrokerIP, MQTT_CONNECT_TIMEOUT))
+      {
+        mqttBackOff();
+        return;
+      }
+      if (!mqttNet.connect(mqttBrokerIP, MQTT_PORT))
+      {
+        mqttBackOff();
+        return;
+      }
+      mqttStage = MQTT_STAGE_TCP;
+      return;
+    }
+    case MQTT_STAGE_TCP:
+    {
+      char willTopic[48];
+      snprintf(willTopic, sizeof(willTopic), "%s/available", mqttBaseTopic);
+      if (!mqttSendConnect(willTopic))
+      {
+        mqttBackOff();
+        return;
+      }
+      mqttConnectSentAt = millis();
+      mqttLastIn = mqttConnectSentAt;
+      mqttStage = MQTT_STAGE_CONNACK;
+      return;
+    }
+    case MQTT_STAGE_CONNACK:
+      // CONNACK이 오면 mqttHandlePacket()이 다음 단계로 넘김
+      if (!mqttReceive())
+      {
+        if (mqttStage == MQTT_STAGE_CONNACK) mqttBackOff();  // 응답 없이 끊김 (거절은 이미 처리됨)
+        return;
+      }
+      if (mqttStage == MQTT_STAGE_CONNACK && millis() - mqttConnectSentAt >= MQTT_CONNACK_TIMEOUT) mqttBackOff();
+      return;
+    default:
+      return;
+  }
+}
+
+// 현재 상태를 retained로 발행
+void mqttPublishState(const MqttLightState &state)
+{
+  char topic[48];
+  char json[160];
+  snprintf(topic, sizeof(topic), "%s/state", mqttBaseTopic);
+  snprintf(json, sizeof(json),
+           "{\"state\":\"%s\",\"brightness\":%u,\"color_mode\":\"rgb\","
+           "\"color\":{\"r\":%u,\"g\":%u,\"b\":%u},\"effect\":\"%s\"}",
+           state.brightness > 0 ? "ON" : "OFF", state.brightness,
+           state.r, state.g, state.b, getModeName((Mode)state.mode));
+
+  if (mqttPublish(topic, json, true))
+  {
+    mqttPublished = state;
+    mqttHasPublished = true;
+  }
+}
+
+// Home Assistant 탐색 설정 발행 (모드 목록은 getModeName()에서 가져옴)
+void mqttPublishDiscovery()
+{
+  char topic[64];
+  char json[MQTT_BUFFER_SIZE - 96];
+  snprintf(topic, sizeof(topic), "homeassistant/light/%s/config", mqttObjectId);
+
+  int n = snprintf(json, sizeof(json),
+                   "{\"name\":\"IoT Mood Light\",\"uniq_id\":\"%s\",\"schema\":\"json\","
+                   "\"cmd_t\":\"%s/set\",\"stat_t\":\"%s/state\",\"brightness\":true,"
+                   "\"supported_color_modes\":[\"rgb\"],\"effect\":true,\"effect_list\":[",
+                   mqttObjectId, mqttBaseTopic, mqttBaseTopic);
+  for (uint8_t m = 0; m < MODE_COUNT && n < (int)sizeof(json); m++)
+  {
+    n += snprintf(json + n, sizeof(json) - n, "%s\"%s\"", m > 0 ? "," : "", getModeName((Mode)m));
+  }
+  if (n < (int)sizeof(json))
+  {
+    n += snprintf(json + n, sizeof(json) - n,
+                  "],\"dev\":{\"ids\":[\"%s\"],\"name\":\"IoT Mood Light\",\"sw\":\"%s\"}}",
+                  mqttObjectId, version.c_str());
+  }
+  if (n >= (int)sizeof(json)) return;  // 버퍼 부족
+
+  mqttPublish(topic, json, true);
+}
+
+// loop()에서 호출: 한 번에 한 단계씩만 처리
+void mqttLoop()
+{
+  if (WiFi.status() != WL_CONNECTED) return;
+
+  if (mqttStage < MQTT_STAGE_SUBSCRIBE)
+  {
+    mqttConnectStep();
+    return;
+  }
+
+  // 받은 명령 처리, 연결이 끊겼으면 처음 단계부터
+  if (!mqttReceive() || !mqttKeepAlive())
+  {
+    mqttDisconnect();
+    mqttConnectStep();
+    return;
+  }
+
+  switch (mqttStage)
+  {
+    case MQTT_STAGE_SUBSCRIBE:
+    {
+      char topic[48];
+      snprintf(topic, sizeof(topic), "%s/set", mqttBaseTopic);
+      mqttSubscribe(topic);
+      mqttStage = MQTT_STAGE_DISCOVERY;
+      return;
+    }
+    case MQTT_STAGE_DISCOVERY:
+      mqttPublishDiscovery();
+      mqttStage = MQTT_STAGE_READY;
+      return;
+    default:
+      break;
+  }
+
+  MqttLightState state;
+  state.mode = currentMode;
+  state.r = mr;
+  state.g = mg;
+  state.b = mb;
+  state.brightness = FastLED.getBrightness();
+  if (state.brightness > 0) mqttLastOnBrightness = state.brightness;
+
+  bool changed = !mqttHasPublished || memcmp(&state, &mqttPublished, sizeof(state)) != 0;
+  if (changed && millis() - mqttLastPublish >= MQTT_PUBLISH_INTERVAL)
+  {
+    mqttPublishState(state);
+    mqttLastPublish = millis();
+  }
+}
+
+#else
+
+void mqttBegin() {}
+void mqttLoop() {}
+
+#endif
@@ -0,0 +1,81 @@
+// 고정소수점 3D 그래디언트 노이즈 (오로라/바다/용암 모드, 색은 palettes.h에서 가져옴)
+// 좌표는 8비트 소수부를 가진 고정소수점(256 = 격자 한 칸)이고 결과는 약 -256 ~ 256이다.
+// NoiseCursor가 마지막 격자 칸의 모서리 그래디언트를 기억하므로, 스트립을 따라 이웃 픽셀을
+// 차례로 계산하면 같은 칸 안에서는 해시를 다시 계산하지 않는다 (칸을 넘을 때만 8개 모서리 갱신).
+// 시간축(z)은 프레임마다 한 번 정해지므로 z 방향 보간 계수도 프레임당 한 번만 계산된다.
+
+// 정육면체 모서리 방향 12개 + 분포를 맞추기 위한 4개 중복 (Perlin 개선판과 같은 구성)
+const int8_t noiseGradients[16][3] = {
+  {1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0},
+  {1, 0, 1}, {-1, 0, 1}, {1, 0, -1}, {-1, 0, -1},
+  {0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1},
+  {1, 1, 0}, {-1, 1, 0}, {0, -1, 1}, {0, -1, -1}
+};
+
+struct NoiseCursor {
+  bool valid;
+  int32_t cx, cy, cz;  // 현재 격자 칸
+  uint8_t grad[8];     // 모서리 그래디언트 번호 (비트 0: x, 1: y, 2: z)
+  uint32_t cellLoads;  // 모서리 갱신 횟수 (재사용률 확인용)
+};
+
+// 격자점 해시 -> 그래디언트 번호 (곱셈 3번, 표 없음)
+inline uint8_t noiseHash(int32_t x, int32_t y, int32_t z)
+{
+  uint32_t h = (uint32_t)x * 0x8DA6B343u ^ (uint32_t)y * 0xD8163841u ^ (uint32_t)z * 0xCB1AB31Fu;
+  h ^= h >> 15;
+  h *= 0x2C1B3C6Du;
+  return h >> 28;
+}
+
+inline int16_t noiseDot(uint8_t g, int16_t dx, int16_t dy, int16_t dz)
+{
+  return noiseGradients[g][0] * dx + noiseGradients[g][1] * dy + noiseGradients[g][2] * dz;
+}
+
+// 부드러운 보간 계수 3t^2 - 2t^3 (t: 0~255 -> 0~256)
+inline int16_t noiseFade(int32_t t)
+{
+  return (t * t * (768 - 2 * t)) >> 16;
+}
+
+inline int16_t noiseLerp(int16_t a, int16_t b, int16_t f)
+{
+  return a + (((int32_t)(b - a) * f) >> 8);
+}
+
+// (x, y, z) 위치의 노이즈 값
+int16_t noiseAt(NoiseCursor &cursor, uint32_t x, uint32_t y, uint32_t z)
+{
+  int32_t ix = x >> 8, iy = y >> 8, iz = z >> 8;
+  if (!cursor.valid || ix != cursor.cx || iy != cursor.cy || iz != cursor.cz)
+  {
+    for (uint8_t c = 0; c < 8; c++)
+    {
+      cursor.grad[c] = noiseHash(ix + (c & 1), iy + ((c >> 1) & 1), iz + (c >> 2));
+    }
+    cursor.cx = ix;
+    cursor.cy = iy;
+    cursor.cz = iz;
+    cursor.valid = true;
+    cursor.cellLoads++;
+  }
+
+  int16_t fx = x & 0xFF, fy = y & 0xFF, fz = z & 0xFF;
+  const uint8_t *g = cursor.grad;
+
+  int16_t x00 = noiseLerp(noiseDot(g[0], fx, fy, fz), noiseDot(g[1], fx - 256, fy, fz), noiseFade(fx));
+  int16_t x10 = noiseLerp(noiseDot(g[2], fx, fy - 256, fz), noiseDot(g[3], fx - 256, fy - 256, fz), noiseFade(fx));
+  int16_t x01 = noiseLerp(noiseDot(g[4], fx, fy, fz - 256), noiseDot(g[5], fx - 256, fy, fz - 256), noiseFade(fx));
+  int16_t x11 = noiseLerp(noiseDot(g[6], fx, fy - 256, fz - 256), noiseDot(g[7], fx - 256, fy - 256, fz - 256), noiseFade(fx));
+
+  int16_t fadeY = noiseFade(fy);
+  return noiseLerp(noiseLerp(x00, x10, fadeY), noiseLerp(x01, x11, fadeY), noiseFade(fz));
+}
+
+// 노이즈 값을 팔레트 번호(0~255)로 (실제 값은 대부분 -200 ~ 200 사이)
+inline uint8_t noiseToIndex(int16_t n)
+{
+  int v = 128 + n;
+  return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
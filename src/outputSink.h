@@ -0,0 +1,125 @@
+// 프레임 출력 대상
+// 렌더링이 끝난 leds[]를 내보내는 곳을 출력 대상(OutputSink) 표로 분리한다.
+//   strip  : LED 스트립 (FastLED.show())
+//   viewer : UDP 미리보기 (scripts/frame_viewer.py가 PC 터미널에 같은 프레임을 그림)
+//   spi/shm/socket : 리눅스 호스트 빌드에서만 (host/hostSinks.h)
+// 켜진 대상마다 write()를 차례로 호출하고 대상별 출력 시간을 기록한다.
+// 스트립 없이 효과를 확인하거나, 스트립 출력과 같은 프레임을 PC에서 볼 때 쓴다 (설정은 저장하지 않음).
+//
+// 미리보기 패킷 (리틀 엔디안, 스트립이 길면 여러 패킷으로 나눔)
+//   [0]     magic    'F' (0x46)
+//   [1]     version  1
+//   [2..3]  frame    프레임 번호 (같은 프레임의 패킷은 같은 번호)
+//   [4..5]  offset   이 패킷의 첫 픽셀 번호
+//   [6..7]  count    이 패킷의 픽셀 수
+//   [8..9]  total    스트립 전체 픽셀 수
+//   [10]    brightness  전역 밝기 (픽셀 값은 밝기 적용 전)
+//   [11]    reserved
+//   [12..]  픽셀 R,G,B 순서
+
+#define VIEWER_DEFAULT_PORT 4211
+#define VIEWER_MAGIC 0x46
+#define VIEWER_VERSION 1
+#define VIEWER_PIXELS_PER_PACKET 400  // 12 + 400*3 = 1212바이트 (MTU 이하, MAX_LEDS가 큰 호스트 빌드에서 나뉨)
+
+enum OutputSinkId {
+  SINK_STRIP = 0,
+  SINK_VIEWER,
+#ifdef HOST_BUILD
+  SINK_SPI,
+  SINK_SHM,
+  SINK_SOCKET,
+#endif
+  SINK_COUNT
+};
+
+struct __attribute__((packed)) ViewerPacketHeader {
+  uint8_t magic;
+  uint8_t version;
+  uint16_t frame;
+  uint16_t offset;
+  uint16_t count;
+  uint16_t total;
+  uint8_t brightness;
+  uint8_t reserved;
+};
+
+struct OutputSink {
+  const char *name;
+  bool (*write)(const CRGB *pixels, uint16_t count, uint8_t brightness);  // 실패하면 false
+};
+
+struct SinkStats {
+  LatencyStats latency;  // write() 시간
+  uint32_t errors;       // 실패한 출력 수
+};
+
+uint8_t sinkMask = 1 << SINK_STRIP;  // 켜진 출력 대상
+SinkStats sinkStats[SINK_COUNT];
+IPAddress viewerIP;
+uint16_t viewerPort = VIEWER_DEFAULT_PORT;
+uint16_t viewerFrame = 0;
+
+bool stripWrite(const CRGB *, uint16_t, uint8_t)
+{
+  FastLED.show();
+  return true;
+}
+
+// UDP 제어 소켓(controlUdp)으로 송신 (미리보기용 소켓을 따로 열지 않음)
+bool viewerWrite(const CRGB *pixels, uint16_t count, uint8_t brightness)
+{
+  bool ok = true;
+  for (uint16_t offset = 0; offset < count; offset += VIEWER_PIXELS_PER_PACKET)
+  {
+    uint16_t n = min((uint16_t)(count - offset), (uint16_t)VIEWER_PIXELS_PER_PACKET);
+    ViewerPacketHeader header = {VIEWER_MAGIC, VIEWER_VERSION, viewerFrame, offset, n, count, brightness, 0};
+    controlUdp.beginPacket(viewerIP, viewerPort);
+    controlUdp.write((const uint8_t *)&header, sizeof(header));
+    controlUdp.write((const uint8_t *)(pixels + offset), n * sizeof(CRGB));
+    if (!controlUdp.endPacket()) ok = false;
+  }
+  viewerFrame++;
+  return ok;
+}
+
+#ifdef HOST_BUILD
+#include "hostSinks.h"
+#endif
+
+const OutputSink outputSinks[SINK_COUNT] = {
+  {"strip", stripWrite},
+  {"viewer", viewerWrite},
+#ifdef HOST_BUILD
+  {"spi", spiWrite},
+  {"shm", shmWrite},
+  {"socket", socketWrite},
+#endif
+};
+
+inline bool sinkEnabled(uint8_t id)
+{
+  return sinkMask & (1 << id);
+}
+
+// 켜진 모든 대상으로 한 프레임 출력
+void outputFrame(const CRGB *pixels, uint16_t count, uint8_t brightness)
+{
+  for (uint8_t id = 0; id < SINK_COUNT; id++)
+  {
+    if (!sinkEnabled(id)) continue;
+    unsigned long start = micros();
+    if (!outputSinks[id].write(pixels, count, brightness)) sinkStats[id].errors++;
+    uint32_t elapsed = micros() - start;
+    recordLatency(sinkStats[id].latency, elapsed);
+    if (id == SINK_STRIP && elapsed > TRACE_SLOW_US) traceRecord(TRACE_SHOW, 0, traceDuration(elapsed));
+  }
+}
+
+void sinkEnable(uint8_t id, bool on)
+{
+  if (on) sinkMask |= 1 << id;
+  else sinkMask &= ~(1 << id);
+  // 끈 스트립에 마지막 프레임이 남지 않도록 한 번 지움 (leds[]는 그대로)
+  if (id == SINK_STRIP && !on) FastLED.showColor(CRGB::Black);
+}
@@ -0,0 +1,159 @@
+// 팔레트 라이브러리
+// 효과는 색을 직접 계산하지 않고 activePalette에서 번호(0~255)로 색을 가져온다.
+// 내장 팔레트는 PROGMEM 그래디언트(또는 FastLED 내장 팔레트)로 두고, 선택한 팔레트는
+// 16칸 RAM 팔레트(targetPalette)로 펼친 뒤 activePalette가 프레임마다 조금씩 따라가도록 섞는다.
+// 사용자 팔레트는 FastLED 그래디언트 형식 그대로(칸마다 번호, R, G, B 4바이트) 업로드해 EEPROM에 저장한다.
+
+#define PALETTE_ADDR LAYOUT_END_ADDR  // EEPROM 위치 (픽셀 배치 뒤)
+#define PALETTE_MAGIC 0x4C50          // 'PL'
+#define PALETTE_UPLOAD_MAX 16         // 사용자 그래디언트 최대 칸 수
+#define PALETTE_END_ADDR (PALETTE_ADDR + 3 + PALETTE_UPLOAD_MAX * 4)
+#define PALETTE_BLEND_INTERVAL_MS 20  // 팔레트 전환 단계 간격
+#define PALETTE_BLEND_STEP 48         // 단계마다 움직이는 색 채널 수 (채널당 1~2씩, 최대 48 = 전체)
+
+enum PaletteId {
+  PALETTE_AUTO = 0,  // 모드별 기본 팔레트
+  PALETTE_AURORA,
+  PALETTE_OCEAN,
+  PALETTE_LAVA,
+  PALETTE_FOREST,
+  PALETTE_CLOUD,
+  PALETTE_PARTY,
+  PALETTE_HEAT,
+  PALETTE_CAMPFIRE,
+  PALETTE_CHRISTMAS,
+  PALETTE_CUSTOM,    // 업로드한 팔레트
+  PALETTE_COUNT
+};
+
+const char *const paletteNames[PALETTE_COUNT] = {
+  "auto", "aurora", "ocean", "lava", "forest", "cloud", "party", "heat",
+  "campfire", "christmas", "custom"
+};
+
+// 오로라: 어두운 밤하늘에서 초록/청록/보라 띠
+DEFINE_GRADIENT_PALETTE(auroraGradient) {
+    0,   0,   0,   8,
+   70,   0,  20,  30,
+  110,   0, 160,  60,
+  150,  20, 255, 120,
+  190,   0, 120, 140,
+  225,  90,   0, 160,
+  255,   8,   0,  24
+};
+
+// 모닥불: 불꽃 강도 -> 빨강 위주, 초록은 빨강의 1/5 (기존 계산과 같은 비율)
+DEFINE_GRADIENT_PALETTE(campfireGradient) {
+    0,  10,   5,   0,
+  255, 255,  51,   0
+};
+
+// 크리스마스: 앞쪽 빨강, 가운데 초록, 끝 흰색 (별)
+DEFINE_GRADIENT_PALETTE(christmasGradient) {
+    0, 255,   0,   0,
+   95, 255,   0,   0,
+   96,   0, 255,   0,
+  191,   0, 255,   0,
+  192, 255, 255, 200,
+  255, 255, 255, 200
+};
+
+uint8_t customGradient[PALETTE_UPLOAD_MAX * 4];
+uint8_t customGradientLength = 0;  // 바이트 수 (0이면 없음)
+
+CRGBPalette16 activePalette;   // 효과가 읽는 팔레트
+CRGBPalette16 targetPalette;   // 전환 목표
+uint8_t targetPaletteId = PALETTE_COUNT;  // 아직 선택 안 됨
+unsigned long lastPaletteBlend = 0;
+bool paletteBlending = false;
+
+// 그래디언트 형식 검사: 4바이트 칸 2~16개, 번호는 0에서 시작해 255에서 끝나며 감소하지 않음
+bool isValidGradient(const uint8_t *data, size_t length)
+{
+  if (length % 4 != 0 || length < 8 || length > sizeof(customGradient)) return false;
+  if (data[0] != 0 || data[length - 4] != 255) return false;
+  for (size_t i = 4; i < length; i += 4)
+  {
+    if (data[i] < data[i - 4]) return false;
+  }
+  return true;
+}
+
+// 팔레트 번호 -> 16칸 팔레트
+void loadPalette(uint8_t id, CRGBPalette16 &out)
+{
+  switch (id)
+  {
+    case PALETTE_OCEAN: out = OceanColors_p; break;
+    case PALETTE_LAVA: out = LavaColors_p; break;
+    case PALETTE_FOREST: out = ForestColors_p; break;
+    case PALETTE_CLOUD: out = CloudColors_p; break;
+    case PALETTE_PARTY: out = PartyColors_p; break;
+    case PALETTE_HEAT: out = HeatColors_p; break;
+    case PALETTE_CAMPFIRE: out = campfireGradient; break;
+    case PALETTE_CHRISTMAS: out = christmasGradient; break;
+    case PALETTE_CUSTOM:
+      if (customGradientLength > 0) out.loadDynamicGradientPalette(customGradient);
+      else out = auroraGradient;  // 업로드한 팔레트가 없으면 오로라
+      break;
+    default: out = auroraGradient; break;
+  }
+}
+
+// 전환 목표 팔레트 변경 (처음 선택할 때는 섞지 않고 바로 적용)
+void setTargetPalette(uint8_t id, bool force = false)
+{
+  if (id == targetPaletteId && !force) return;
+  bool first = targetPaletteId == PALETTE_COUNT;
+  targetPaletteId = id;
+  loadPalette(id, targetPalette);
+  if (first) activePalette = targetPalette;
+  paletteBlending = !first;
+}
+
+// 일정 간격으로 activePalette를 목표 쪽으로 조금씩 이동, 전환 중이면 true
+bool paletteBlendStep(unsigned long now)
+{
+  if (!paletteBlending || now - lastPaletteBlend < PALETTE_BLEND_INTERVAL_MS) return paletteBlending;
+  lastPaletteBlend = now;
+  nblendPaletteTowardPalette(activePalette, targetPalette, PALETTE_BLEND_STEP);
+  paletteBlending = memcmp(&activePalette, &targetPalette, sizeof(CRGBPalette16)) != 0;
+  return true;
+}
+
+// 사용자 팔레트를 EEPROM 캐시에 씀 (커밋은 지연 저장의 saveSettings()에서 설정과 함께)
+void saveCustomPalette()
+{
+  EEPROM.write(PALETTE_ADDR, PALETTE_MAGIC & 0xFF);
+  EEPROM.write(PALETTE_ADDR + 1, PALETTE_MAGIC >> 8);
+  EEPROM.write(PALETTE_ADDR + 2, customGradientLength);
+  for (uint8_t i = 0; i < customGradientLength; i++)
+  {
+    EEPROM.write(PALETTE_ADDR + 3 + i, customGradient[i]);
+  }
+}
+
+void loadCustomPalette()
+{
+  uint16_t magic = EEPROM.read(PALETTE_ADDR) | (EEPROM.read(PALETTE_ADDR + 1) << 8);
+  uint8_t length = EEPROM.read(PALETTE_ADDR + 2);
+  customGradientLength = 0;
+  if (magic != PALETTE_MAGIC || length > sizeof(customGradient)) return;
+
+  for (uint8_t i = 0; i < length; i++)
+  {
+    customGradient[i] = EEPROM.read(PALETTE_ADDR + 3 + i);
+  }
+  if (isValidGradient(customGradient, length)) customGradientLength = length;
+}
+
+// 사용자 팔레트 업로드 (형식이 잘못되면 false), 저장은 조용해진 뒤 한 번
+bool uploadCustomPalette(const uint8_t *data, size_t length)
+{
+  if (!isValidGradient(data, length)) return false;
+  memcpy(customGradient, data, length);
+  customGradientLength = length;
+  requestStore(STORE_PALETTE, millis());
+  if (targetPaletteId == PALETTE_CUSTOM) setTargetPalette(PALETTE_CUSTOM, true);
+  return true;
+}
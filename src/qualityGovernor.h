@@ -0,0 +1,102 @@
+// 적응형 품질 조절
+// 실제로 나간 프레임 사이 간격(framePacerTake() 사이)이 최대 프레임 간격(QUALITY_MAX_GAP_US)을 넘는 일이
+// 잦으면 효과 품질을 한 단계씩 낮추고, 한동안 넘지 않으면 한 단계씩 되돌린다.
+// 낮은 단계일수록 눈에 덜 띄는 것부터 포기한다.
+//   1: FastLED 시간 디더링 끔
+//   2: OLED 갱신과 로그 출력을 여유가 생길 때까지 미룸
+//   3: 모닥불/웜라이트 이웃 확산 생략
+//   4: 시뮬레이션 단계 간격 2배 (조명 간 동기화 중이면 단계가 달라질 수 있음)
+// 웹 서버 입출력(HTTP_IO_BUDGET_US)과 단계 계산(renderChunks.h)은 이미 시간 제한이 있으므로,
+// 남는 부담을 여기서 덜어 프레임 간격이 최대 간격 아래에 머물게 한다.
+// 최대 간격을 하드웨어처럼 보장할 수는 없으므로(한 loop가 길어지면 그 프레임은 늦음), 넘는 일이 구간 안에서
+// 되풀이되면 부담을 줄여 다음 프레임부터 다시 지키게 하는 방식이다. 가장 긴 간격은 /metrics pacer.maxGapUs.
+// loop 간격이 아니라 프레임 간격을 보므로, 프레임 사이에 loop가 여러 번 돌며 짧게 끝나는 경우는 초과가 아니고
+// 프레임이 반 주기 넘게 늦은 경우(틱을 놓친 경우 포함)만 초과로 센다.
+// 시간은 모두 인자로 받으므로 가짜 시계로 동작을 확인할 수 있다.
+
+// 틱 간격 + 반 주기: 틱을 하나 놓치면(2주기) 넘고, loop 흔들림(반 주기 미만)으로는 넘지 않음
+#define QUALITY_MAX_GAP_US (FRAME_PERIOD_MS * 1500UL)
+#define QUALITY_WINDOW_MS 1000   // 초과 횟수를 세는 구간
+#define QUALITY_DOWN_OVERRUNS 3  // 구간 안에서 이만큼 초과하면 한 단계 낮춤
+#define QUALITY_HOLD_MS 500      // 단계를 바꾼 뒤 다음 단계로 내려가기까지 최소 시간
+#define QUALITY_UP_MS 5000       // 이 시간 동안 초과가 없으면 한 단계 올림
+
+enum QualityLevel {
+  QUALITY_FULL = 0,
+  QUALITY_NO_DITHER,
+  QUALITY_DEFER_IO,
+  QUALITY_NO_DIFFUSION,
+  QUALITY_HALF_RATE,
+  QUALITY_LEVELS
+};
+
+struct QualityGovernor {
+  uint8_t level;
+  uint8_t windowOverruns;      // 현재 구간의 초과 횟수
+  unsigned long windowStart;
+  unsigned long lastOverrun;   // 마지막 초과 시각
+  unsigned long lastChange;    // 마지막 단계 변경 시각
+  uint32_t overruns;           // 누적 초과 횟수
+  uint32_t stepsDown;          // 낮춘 횟수
+  uint32_t stepsUp;            // 올린 횟수
+};
+
+QualityGovernor quality;
+
+inline uint8_t qualityLevel()
+{
+  return quality.level;
+}
+
+// 단계 간격 (최저 단계에서는 2배)
+inline uint16_t qualityPeriod(uint16_t ms)
+{
+  return quality.level >= QUALITY_HALF_RATE ? ms * 2 : ms;
+}
+
+inline bool qualityDiffusion()
+{
+  return quality.level < QUALITY_NO_DIFFUSION;
+}
+
+inline bool qualityDefersIO()
+{
+  return quality.level >= QUALITY_DEFER_IO;
+}
+
+// 프레임마다 직전 프레임과의 간격을 알려줌 (0이면 비교할 직전 프레임 없음), 단계가 바뀌었으면 true
+bool qualityNote(uint32_t gapUs, unsigned long now)
+{
+  if (now - quality.windowStart >= QUALITY_WINDOW_MS)
+  {
+    quality.windowStart = now;
+    quality.windowOverruns = 0;
+  }
+
+  if (gapUs > QUALITY_MAX_GAP_US)
+  {
+    quality.overruns++;
+    quality.windowOverruns++;
+    quality.lastOverrun = now;
+    if (quality.windowOverruns >= QUALITY_DOWN_OVERRUNS && quality.level < QUALITY_LEVELS - 1 &&
+        now - quality.lastChange >= QUALITY_HOLD_MS)
+    {
+      quality.level++;
+      quality.stepsDown++;
+      quality.lastChange = now;
+      quality.windowOverruns = 0;
+      return true;
+    }
+    return false;
+  }
+
+  if (quality.level > 0 && now - quality.lastOverrun >= QUALITY_UP_MS &&
+      now - quality.lastChange >= QUALITY_UP_MS)
+  {
+    quality.level--;
+    quality.stepsUp++;
+    quality.lastChange = now;
+    return true;
+  }
+  return false;
+}
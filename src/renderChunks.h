@@ -0,0 +1,114 @@
+// 청크 단위 단계 계산
+// 시뮬레이션 단계 하나를 RENDER_CHUNK 픽셀 청크로 나눠 계산한다.
+// 청크마다 (단계, 청크 번호)로 난수 시드를 따로 잡고, 이웃 확산 항은 단계 시작 시점의 값만 읽는다
+// (청크 경계 바깥 값은 시작할 때 halo에 복사). 그래서 청크를 어떤 순서로, 몇 번의 loop에 나눠
+// 계산해도 결과가 한 번에 계산한 것과 비트 단위로 같다.
+// 보간하지 않는 효과는 loop 한 번에 RENDER_SLICE_US만 쓰고 나머지 청크는 다음 프레임으로 넘겨
+// 긴 스트립의 단계 계산이 웹/UDP 처리를 막지 않게 한다.
+// 호스트 빌드에서는 chunkParallel을 정하면 한 번에 끝까지 계산하는 단계를 여러 스레드로 나눈다
+// (host/renderPool.h, 청크마다 시드를 다시 잡으므로 스레드별 난수 상태로도 결과가 같다).
+// 시간 예산을 두고 나눠 계산하는 단계는 기기와 같이 순차로 계산한다.
+
+#define RENDER_CHUNK 32          // 청크 크기 (픽셀)
+#define RENDER_CHUNKS ((MAX_LEDS + RENDER_CHUNK - 1) / RENDER_CHUNK)
+#define RENDER_SLICE_US 2000     // 나눠 계산하는 효과가 loop 한 번에 쓰는 최대 시간
+
+struct ChunkJob {
+  uint32_t step;      // 계산 중인 단계
+  uint16_t count;     // 픽셀 수
+  uint16_t next;      // 다음 청크 시작 픽셀 (count면 끝남)
+  uint8_t passes;     // 이 단계를 계산하는 데 쓴 loop 횟수
+  uint8_t haloLo[RENDER_CHUNKS];  // 청크 왼쪽 바깥 픽셀의 단계 시작 값
+  uint8_t haloHi[RENDER_CHUNKS];  // 청크 오른쪽 바깥 픽셀의 단계 시작 값
+};
+
+struct ChunkStats {
+  uint32_t jobs;    // 계산한 단계 수
+  uint32_t chunks;  // 계산한 청크 수
+  uint32_t sliced;  // 여러 loop에 나눠 계산한 단계 수
+};
+
+ChunkStats chunkStats;
+
+inline bool chunkJobBusy(const ChunkJob &job)
+{
+  return job.next < job.count;
+}
+
+// 새 단계 시작: cells(이웃 확산에 쓰는 픽셀별 값, 없으면 nullptr)의 청크 경계 값을 halo에 복사
+void chunkJobStart(ChunkJob &job, uint32_t step, const uint8_t *cells, uint16_t count)
+{
+  job.step = step;
+  job.count = count;
+  job.next = 0;
+  job.passes = 0;
+  if (!cells) return;
+  for (uint16_t lo = 0, c = 0; lo < count; lo += RENDER_CHUNK, c++)
+  {
+    uint16_t hi = min((uint16_t)(lo + RENDER_CHUNK), count);
+    job.haloLo[c] = lo > 0 ? cells[lo - 1] : 0;
+    job.haloHi[c] = hi < count ? cells[hi] : 0;
+  }
+}
+
+inline uint16_t chunkCount(const ChunkJob &job)
+{
+  return (job.count + RENDER_CHUNK - 1) / RENDER_CHUNK;
+}
+
+// c번째 청크 하나 계산 (job.next와 무관하게, 어느 순서/스레드에서 불러도 같은 결과)
+template <typename StepChunk>
+void chunkRun(const ChunkJob &job, uint16_t c, StepChunk &stepChunk)
+{
+  uint16_t lo = c * RENDER_CHUNK;
+  uint16_t hi = min((uint16_t)(lo + RENDER_CHUNK), job.count);
+  seedEffectRandom(job.step * RENDER_CHUNKS + c);
+  stepChunk(lo, hi, job.haloLo[c], job.haloHi[c]);
+}
+
+#ifdef HOST_BUILD
+// [first, last) 청크를 나눠 계산하고 모두 끝나면 돌아옴 (run(context, c)는 청크 하나)
+inline void (*chunkParallel)(uint16_t first, uint16_t last, void (*run)(void *, uint16_t), void *context) = nullptr;
+
+template <typename StepChunk>
+void chunkRunThunk(void *context, uint16_t c)
+{
+  const std::pair<const ChunkJob *, StepChunk *> &call = *(std::pair<const ChunkJob *, StepChunk *> *)context;
+  chunkRun(*call.first, c, *call.second);
+}
+#endif
+
+// 남은 청크를 budgetUs 안에서 계산 (0이면 끝까지), 한 청크라도 계산했으면 true
+// stepChunk(lo, hi, left, right): [lo, hi) 계산, left/right는 구간 바깥 이웃의 단계 시작 값
+template <typename StepChunk>
+bool chunkJobRun(ChunkJob &job, uint32_t budgetUs, StepChunk stepChunk)
+{
+  if (!chunkJobBusy(job)) return false;
+#ifdef HOST_BUILD
+  if (budgetUs == 0 && chunkParallel != nullptr)
+  {
+    std::pair<const ChunkJob *, StepChunk *> call(&job, &stepChunk);
+    uint16_t first = job.next / RENDER_CHUNK;
+    chunkParallel(first, chunkCount(job), chunkRunThunk<StepChunk>, &call);
+    chunkStats.chunks += chunkCount(job) - first;
+    job.next = job.count;
+  }
+#endif
+  unsigned long start = micros();
+  while (chunkJobBusy(job))
+  {
+    uint16_t c = job.next / RENDER_CHUNK;
+    chunkRun(job, c, stepChunk);
+    job.next = min((uint16_t)((c + 1) * RENDER_CHUNK), job.count);
+    chunkStats.chunks++;
+    if (budgetUs != 0 && micros() - start >= budgetUs) break;
+  }
+
+  if (job.passes < 255) job.passes++;
+  if (!chunkJobBusy(job))
+  {
+    chunkStats.jobs++;
+    if (job.passes > 1) chunkStats.sliced++;
+  }
+  return true;
+}
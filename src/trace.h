@@ -0,0 +1,125 @@
+// 이벤트 추적 (비행 기록기)
+// 처리한 HTTP 요청, UDP 명령, 설정 변경, EEPROM 저장, 느린 렌더링/출력, loop 정지를
+// 8바이트 이진 레코드로 고정 크기 링 버퍼에 계속 기록한다 (가득 차면 가장 오래된 것부터 덮어씀).
+// GET /trace로 헤더 + 레코드(오래된 것부터)를 내려받아 scripts/trace_timeline.py로 시간순 분석한다.
+// TRACE_EVENTS=0으로 빌드하면 기록 호출은 모두 빈 함수가 된다.
+
+#ifndef TRACE_EVENTS
+#define TRACE_EVENTS 160  // 기록 개수 (다운로드 시 jsonBuffer에 들어가야 함)
+#endif
+
+#define TRACE_MAGIC 0x31435254  // 'TRC1'
+#define TRACE_VERSION 1
+#define TRACE_STALL_US 20000    // 이보다 긴 loop 간격은 정지로 기록
+#define TRACE_SLOW_US 8000      // 이보다 오래 걸린 렌더링/출력만 기록
+#define TRACE_PARAM_TABLE 16    // TRACE_PARAM id: 이 값 + 효과 설정 항목 번호
+
+enum TraceType {
+  TRACE_MARK = 0,    // id: TraceMark
+  TRACE_STALL,       // value: loop 간격
+  TRACE_HTTP,        // id: 라우트 번호 (255 = 없는 경로), value: 핸들러 시간
+  TRACE_UDP,         // id: opcode
+  TRACE_PARAM,       // id: PendingFlag 비트 번호 또는 TRACE_PARAM_TABLE + 항목 번호, value: 새 값
+  TRACE_EEPROM,      // id: TraceStore, value: commit 시간
+  TRACE_RENDER,      // id: 모드, value: 렌더링 시간
+  TRACE_SHOW         // value: FastLED.show() 시간
+};
+
+enum TraceMark {
+  TRACE_MARK_BOOT = 0,
+  TRACE_MARK_CLEAR,
+  TRACE_MARK_QUALITY   // value: 새 품질 단계
+};
+
+enum TraceStore {
+  TRACE_STORE_SETTINGS = 0,
+  TRACE_STORE_LAYOUT,
+  TRACE_STORE_PALETTE
+};
+
+struct TraceRecord {
+  uint32_t timeUs;  // 기록 시각 (micros, 이벤트가 끝난 시각)
+  uint8_t type;
+  uint8_t id;
+  uint16_t value;   // 시간 값은 traceDuration() 형식
+};
+
+struct TraceHeader {
+  uint32_t magic;
+  uint8_t version;
+  uint8_t recordSize;
+  uint16_t count;     // 뒤따르는 레코드 수
+  uint32_t nowUs;     // 내려받은 시각 (micros)
+  uint32_t overwritten;  // 덮어써서 잃은 레코드 수
+};
+
+// 시간 값 압축: 32767us 이하는 us 그대로, 그 이상은 최상위 비트 + ms (최대 약 32초)
+inline uint16_t traceDuration(uint32_t us)
+{
+  if (us < 0x8000) return us;
+  uint32_t ms = us / 1000;
+  return 0x8000 | (ms > 0x7FFF ? 0x7FFF : ms);
+}
+
+#if TRACE_EVENTS > 0
+
+static_assert(sizeof(TraceRecord) == 8, "trace record must stay 8 bytes");
+static_assert(sizeof(TraceHeader) + TRACE_EVENTS * sizeof(TraceRecord) <= JSON_BUFFER_SIZE,
+              "trace download must fit jsonBuffer");
+
+TraceRecord traceBuffer[TRACE_EVENTS];
+uint16_t traceNext = 0;    // 다음에 쓸 위치
+uint16_t traceCount = 0;   // 저장된 레코드 수
+uint32_t traceOverwritten = 0;
+
+void traceRecord(uint8_t type, uint8_t id, uint16_t value)
+{
+  TraceRecord &record = traceBuffer[traceNext];
+  record.timeUs = micros();
+  record.type = type;
+  record.id = id;
+  record.value = value;
+  traceNext = (traceNext + 1) % TRACE_EVENTS;
+  if (traceCount < TRACE_EVENTS) traceCount++;
+  else traceOverwritten++;
+}
+
+void traceClear()
+{
+  traceNext = 0;
+  traceCount = 0;
+  traceOverwritten = 0;
+  traceRecord(TRACE_MARK, TRACE_MARK_CLEAR, 0);
+}
+
+// 헤더 + 레코드(오래된 것부터)를 buffer에 펼침, 쓴 바이트 수 반환
+size_t traceSnapshot(uint8_t *buffer)
+{
+  TraceHeader header = {TRACE_MAGIC, TRACE_VERSION, sizeof(TraceRecord), traceCount,
+                        (uint32_t)micros(), traceOverwritten};
+  memcpy(buffer, &header, sizeof(header));
+  size_t offset = sizeof(header);
+  uint16_t first = (traceNext + TRACE_EVENTS - traceCount) % TRACE_EVENTS;
+  for (uint16_t i = 0; i < traceCount; i++)
+  {
+    memcpy(buffer + offset, &traceBuffer[(first + i) % TRACE_EVENTS], sizeof(TraceRecord));
+    offset += sizeof(TraceRecord);
+  }
+  return offset;
+}
+
+#else
+
+inline void traceRecord(uint8_t, uint8_t, uint16_t) {}
+inline void traceClear() {}
+inline size_t traceSnapshot(uint8_t *) { return 0; }
+
+#endif
+
+// EEPROM.commit() 시간을 재서 기록
+void timedCommit(uint8_t store)
+{
+  unsigned long start = micros();
+  EEPROM.commit();
+  traceRecord(TRACE_EEPROM, store, traceDuration(micros() - start));
+}
@@ -0,0 +1,153 @@
+// UDP 바이너리 제어 프로토콜
+// HTTP 요청/String 파싱 없이 고정 길이 패킷으로 모드/색상/밝기/웜 설정을 변경한다.
+// 수신한 명령은 큐에 쌓였다가 다음 프레임 시작 시점(loop()의 렌더링 직전)에 적용된다.
+// 수신 경로는 정적 버퍼만 사용하며 힙 할당이 없다.
+//
+// 패킷 구조 (14바이트, 리틀 엔디안)
+//   [0]    magic    'M' (0x4D)
+//   [1]    version  1
+//   [2]    opcode   CTRL_OP_*
+//   [3]    flags    bit0: ACK 요청, bit1: EEPROM 저장
+//   [4..5] seq      시퀀스 번호 (ACK에 그대로 반환)
+//   [6..13] payload
+//     SET_MODE       [0]=mode
+//     SET_COLOR      [0]=r [1]=g [2]=b
+//     SET_BRIGHTNESS [0]=brightness
+//     SET_WARM       [0]=색온도/100 [1]=chance [2]=min [3]=max [4]=speed [5]=smooth
+//     SYNC           [0..3]=리더 시간(ms) [4..7]=효과 시드 (frameSync.h 참고)
+//     RECALL_PRESET  [0]=프리셋 슬롯
+//     SYNC_PROBE     (없음) 팔로워의 왕복 시간 측정, 리더가 같은 seq의 SYNC로 회신
+// ACK는 같은 헤더에 opcode|0x80, payload[0]=결과(0: 성공, 1: 실패)로 송신 측 포트에 회신한다.
+
+#include <WiFiUdp.h>
+
+#define UDP_CONTROL_PORT 4210
+#define CTRL_MAGIC 0x4D
+#define CTRL_VERSION 1
+#define CTRL_QUEUE_SIZE 8       // 한 프레임 동안 쌓아둘 수 있는 최대 명령 수
+#define CTRL_MAX_PACKETS_PER_LOOP 8
+
+enum ControlOpcode {
+  CTRL_OP_PING = 0,
+  CTRL_OP_SET_MODE = 1,
+  CTRL_OP_SET_COLOR = 2,
+  CTRL_OP_SET_BRIGHTNESS = 3,
+  CTRL_OP_SET_WARM = 4,
+  CTRL_OP_SYNC = 5,
+  CTRL_OP_RECALL_PRESET = 6,
+  CTRL_OP_SYNC_PROBE = 7,
+  CTRL_OP_ACK = 0x80
+};
+
+#define CTRL_FLAG_ACK 0x01
+#define CTRL_FLAG_PERSIST 0x02
+
+struct __attribute__((packed)) ControlPacket {
+  uint8_t magic;
+  uint8_t version;
+  uint8_t opcode;
+  uint8_t flags;
+  uint16_t seq;
+  uint8_t payload[8];
+};
+
+// 대기 중인 명령 (ACK 회신용 송신자 주소 포함)
+struct PendingControl {
+  ControlPacket packet;
+  uint32_t remoteIP;
+  uint16_t remotePort;
+};
+
+WiFiUDP controlUdp;
+PendingControl controlQueue[CTRL_QUEUE_SIZE];
+uint8_t controlQueueCount = 0;
+uint32_t controlDropped = 0;  // 잘못된 패킷 또는 큐 초과로 버린 수
+
+// main.cpp에서 구현: 명령을 현재 상태에 적용하고 성공 여부 반환
+bool applyControlPacket(const ControlPacket &packet);
+// frameSync.h에서 구현: 보낸 쪽에 바로 회신해야 하는 동기 프로브
+void frameSyncAnswerProbe(const PendingControl &probe);
+
+void udpControlBegin()
+{
+  controlUdp.begin(UDP_CONTROL_PORT);
+}
+
+void sendControlAck(const PendingControl &pending, bool ok)
+{
+  ControlPacket ack = pending.packet;
+  ack.opcode |= CTRL_OP_ACK;
+  memset(ack.payload, 0, sizeof(ack.payload));
+  ack.payload[0] = ok ? 0 : 1;
+
+  controlUdp.beginPacket(IPAddress(pending.remoteIP), pending.remotePort);
+  controlUdp.write((const uint8_t *)&ack, sizeof(ack));
+  controlUdp.endPacket();
+}
+
+// 도착한 패킷을 읽어 큐에 저장 (loop마다 최대 CTRL_MAX_PACKETS_PER_LOOP개)
+void pollUdpControl()
+{
+  for (int n = 0; n < CTRL_MAX_PACKETS_PER_LOOP; n++)
+  {
+    int size = controlUdp.parsePacket();
+    if (size <= 0) return;
+
+    if (size != sizeof(ControlPacket) || controlQueueCount >= CTRL_QUEUE_SIZE)
+    {
+      controlUdp.flush();
+      controlDropped++;
+      continue;
+    }
+
+    PendingControl &pending = controlQueue[controlQueueCount];
+    controlUdp.read((uint8_t *)&pending.packet, sizeof(ControlPacket));
+    if (pending.packet.magic != CTRL_MAGIC || pending.packet.version != CTRL_VERSION)
+    {
+      controlDropped++;
+      continue;
+    }
+    pending.remoteIP = controlUdp.remoteIP();
+    pending.remotePort = controlUdp.remotePort();
+    controlQueueCount++;
+  }
+}
+
+// 다른 입력 경로(MQTT 등)에서 명령을 큐에 추가 (ACK 없음)
+bool queueControl(uint8_t opcode, const uint8_t *payload, uint8_t length, uint8_t flags)
+{
+  if (controlQueueCount >= CTRL_QUEUE_SIZE || length > sizeof(ControlPacket::payload))
+  {
+    controlDropped++;
+    return false;
+  }
+
+  PendingControl &pending = controlQueue[controlQueueCount++];
+  memset(&pending, 0, sizeof(pending));
+  pending.packet.magic = CTRL_MAGIC;
+  pending.packet.version = CTRL_VERSION;
+  pending.packet.opcode = opcode;
+  pending.packet.flags = flags & ~CTRL_FLAG_ACK;
+  memcpy(pending.packet.payload, payload, length);
+  return true;
+}
+
+// 프레임 시작 시점에 큐의 명령을 순서대로 적용
+void applyUdpControl()
+{
+  for (uint8_t i = 0; i < controlQueueCount; i++)
+  {
+    const PendingControl &pending = controlQueue[i];
+    if (pending.packet.opcode == CTRL_OP_SYNC_PROBE)
+    {
+      frameSyncAnswerProbe(pending);
+      continue;
+    }
+    bool ok = applyControlPacket(pending.packet);
+    if (pending.packet.flags & CTRL_FLAG_ACK)
+    {
+      sendControlAck(pending, ok);
+    }
+  }
+  controlQueueCount = 0;
+}
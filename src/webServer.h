@@ -0,0 +1,478 @@
+// 이벤트 기반 논블로킹 HTTP 서버
+// ESP8266WebServer는 handleClient() 안에서 헤더 수신과 응답 전송을 끝까지 기다리므로
+// 느린 클라이언트가 있으면 애니메이션이 그동안 멈춘다.
+// 이 서버는 연결마다 상태를 두고 poll() 한 번에 주어진 시간(us)만큼만 읽기/쓰기를 진행하며,
+// 응답 본문은 프레임 사이사이에 나누어 전송한다.
+//
+// 제약
+//   - 요청은 GET(쿼리 인자)과 Content-Length가 있는 작은 POST 본문만 지원
+//   - send()에 넘기는 본문은 전송이 끝날 때까지 유효해야 한다 (정적 버퍼, 문자열 상수, PROGMEM)
+//   - jsonBuffer 본문 응답은 한 번에 하나만 전송하며, 그동안 다른 요청의 핸들러 실행은 다음 poll로 미뤄진다
+//     (핸들러들이 jsonBuffer를 공유하기 때문, 문자열 상수/PROGMEM 본문은 막지 않음)
+
+#define HTTP_MAX_CLIENTS 4
+#define HTTP_REQUEST_SIZE 512      // 요청 라인 + 헤더 + 본문 최대 크기
+#define HTTP_MAX_ARGS 12
+#define HTTP_MAX_ROUTES 24
+#define HTTP_READ_TIMEOUT 3000     // 요청 수신 제한 시간 (ms)
+#define HTTP_WRITE_TIMEOUT 5000    // 응답 전송 제한 시간 (ms)
+#define HTTP_WRITE_CHUNK 256       // 한 번에 쓰는 최대 바이트 수
+
+typedef void (*HttpHandler)();
+
+enum HttpSlotState {
+  HTTP_IDLE = 0,
+  HTTP_READING,
+  HTTP_READY,     // 요청 수신 완료, 핸들러 실행 대기
+  HTTP_WRITING
+};
+
+struct HttpRoute {
+  const char *path;
+  HttpHandler handler;
+};
+
+struct HttpSlot {
+  WiFiClient client;
+  HttpSlotState state;
+  unsigned long since;       // 현재 상태에 들어간 시각 (ms)
+  char request[HTTP_REQUEST_SIZE + 1];
+  uint16_t requestLength;
+  uint16_t bodyOffset;       // 요청 본문 시작 위치 (헤더 끝)
+  uint16_t contentLength;
+  char header[160];
+  uint16_t headerLength;
+  const char *body;
+  uint32_t bodyLength;
+  uint32_t sent;             // header + body 중 전송한 바이트 수
+  bool bodyProgmem;
+};
+
+class LightWebServer
+{
+public:
+  LightWebServer(uint16_t port) : listener(port), routeCount(0), current(nullptr), argCount(0) {}
+
+  void begin()
+  {
+    listener.begin();
+    listener.setNoDelay(true);
+  }
+
+  void on(const char *path, HttpHandler handler)
+  {
+    if (routeCount >= HTTP_MAX_ROUTES) return;
+    routes[routeCount].path = path;
+    routes[routeCount].handler = handler;
+    routeCount++;
+  }
+
+  // 주어진 시간(us) 안에서 연결 수락/요청 수신/핸들러 실행/응답 전송을 진행
+  void poll(uint32_t budgetUs)
+  {
+    unsigned long start = micros();
+
+    acceptClients();
+
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++)
+    {
+      if (micros() - start > budgetUs) return;
+
+      HttpSlot &slot = slots[i];
+      switch (slot.state)
+      {
+        case HTTP_READING:
+          readRequest(slot);
+          break;
+        case HTTP_READY:
+          if (!sharedBodyInFlight()) dispatch(slot);
+          break;
+        case HTTP_WRITING:
+          writeResponse(slot, start, budgetUs);
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
+  // --- 핸들러에서 사용하는 함수들 ---
+
+  bool hasArg(const char *name) const { return findArg(name) >= 0; }
+
+  // 인자 값 (없으면 빈 문자열), 요청 버퍼 안을 그대로 가리킴
+  const char *arg(const char *name) const
+  {
+    int index = findArg(name);
+    return index >= 0 ? argValues[index] : "";
+  }
+
+  // 요청 인자 수와 index번째 이름 (요청 순서)
+  uint8_t args() const { return argCount; }
+  const char *argName(uint8_t index) const { return index < argCount ? argNames[index] : ""; }
+
+  const char *body() const { return current ? current->request + current->bodyOffset : ""; }
+  uint16_t bodyLength() const { return current ? current->contentLength : 0; }
+
+  void send(int code, const char *contentType, const char *content)
+  {
+    send(code, contentType, content, strlen(content));
+  }
+
+  void send(int code, const char *contentType, const char *content, size_t length)
+  {
+    prepareResponse(code, contentType, content, length, false);
+  }
+
+  void send_P(int code, const char *contentType, PGM_P content)
+  {
+    prepareResponse(code, contentType, content, strlen_P(content), true);
+  }
+
+  // 진행 중인 연결 수 (상태 표시용)
+  uint8_t activeClients() const
+  {
+    uint8_t count = 0;
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++)
+    {
+      if (slots[i].state != HTTP_IDLE) count++;
+    }
+    return count;
+  }
+
+private:
+  WiFiServer listener;
+  HttpSlot slots[HTTP_MAX_CLIENTS];
+  HttpRoute routes[HTTP_MAX_ROUTES];
+  uint8_t routeCount;
+  HttpSlot *current;         // 핸들러 실행 중인 연결
+  const char *argNames[HTTP_MAX_ARGS];
+  const char *argValues[HTTP_MAX_ARGS];
+  uint8_t argCount;
+
+  void setState(HttpSlot &slot, HttpSlotState state)
+  {
+    slot.state = state;
+    slot.since = millis();
+  }
+
+  // 보낸 데이터는 이미 lwIP 송신 큐에 있으므로 ACK를 기다리지 않고 닫음
+  // (기본 stop()은 ACK를 최대 수백 ms 동안 기다리며 loop를 막는다)
+  void closeSlot(HttpSlot &slot)
+  {
+    slot.client.stop(1);
+    setState(slot, HTTP_IDLE);
+  }
+
+  void acceptClients()
+  {
+    while (listener.hasClient())
+    {
+      HttpSlot *freeSlot = nullptr;
+      for (int i = 0; i < HTTP_MAX_CLIENTS; i++)
+      {
+        if (slots[i].state == HTTP_IDLE)
+        {
+          freeSlot = &slots[i];
+          break;
+        }
+      }
+
+      WiFiClient client = listener.accept();
+      if (freeSlot == nullptr)
+      {
+        // 연결 수 초과: RST로 바로 끊음 (stop()은 FIN의 ACK를 기다리며 loop를 막음)
+        client.abort();
+        return;
+      }
+
+      client.setNoDelay(true);
+      freeSlot->client = client;
+      freeSlot->requestLength = 0;
+      freeSlot->contentLength = 0;
+      freeSlot->bodyOffset = 0;
+      freeSlot->request[0] = '\0';
+      setState(*freeSlot, HTTP_READING);
+    }
+  }
+
+  // 지금 도착한 만큼만 읽음 (기다리지 않음)
+  void readRequest(HttpSlot &slot)
+  {
+    int available = slot.client.available();
+    if (available > 0)
+    {
+      size_t room = HTTP_REQUEST_SIZE - slot.requestLength;
+      size_t n = min((size_t)available, room);
+      n = slot.client.read((uint8_t *)slot.request + slot.requestLength, n);
+      slot.requestLength += n;
+      slot.request[slot.requestLength] = '\0';
+    }
+
+    if (slot.bodyOffset == 0)
+    {
+      char *end = strstr(slot.request, "\r\n\r\n");
+      if (end != nullptr)
+      {
+        slot.bodyOffset = end - slot.request + 4;
+        int32_t length = parseContentLength(slot.request, end);
+        if (length < 0)
+        {
+          respondError(slot, 400, "Bad Content-Length");
+          return;
+        }
+        if (length > HTTP_REQUEST_SIZE - slot.bodyOffset)
+        {
+          respondError(slot, 413, "Request too large");
+          return;
+        }
+        slot.contentLength = length;
+      }
+    }
+
+    if (slot.bodyOffset > 0 && slot.requestLength >= slot.bodyOffset + slot.contentLength)
+    {
+      setState(slot, HTTP_READY);
+      return;
+    }
+
+    if (slot.requestLength >= HTTP_REQUEST_SIZE)
+    {
+      respondError(slot, 413, "Request too large");
+      return;
+    }
+    if (!slot.client.connected() || millis() - slot.since > HTTP_READ_TIMEOUT)
+    {
+      closeSlot(slot);
+    }
+  }
+
+  // Content-Length 값 (없으면 0, 숫자가 아니거나 음수면 -1, 너무 크면 HTTP_REQUEST_SIZE + 1)
+  static int32_t parseContentLength(const char *request, const char *headerEnd)
+  {
+    const char *p = request;
+    while (p < headerEnd)
+    {
+      const char *line = strstr(p, "\r\n");
+      if (line == nullptr || line >= headerEnd) break;
+      p = line + 2;
+      if (strncasecmp(p, "Content-Length:", 15) == 0)
+      {
+        p += 15;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p < '0' || *p > '9') return -1;
+        int32_t length = 0;
+        while (*p >= '0' && *p <= '9')
+        {
+          if (length <= HTTP_REQUEST_SIZE) length = length * 10 + (*p - '0');
+          p++;
+        }
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p != '\r') return -1;
+        return min(length, (int32_t)HTTP_REQUEST_SIZE + 1);
+      }
+    }
+    return 0;
+  }
+
+  // 요청 라인 파싱 후 라우트 핸들러 실행
+  void dispatch(HttpSlot &slot)
+  {
+    // "GET /path?a=1&b=2 HTTP/1.1"
+    char *target = strchr(slot.request, ' ');
+    if (target == nullptr)
+    {
+      respondError(slot, 400, "Bad request");
+      return;
+    }
+    target++;
+    char *targetEnd = strchr(target, ' ');
+    if (targetEnd == nullptr)
+    {
+      respondError(slot, 400, "Bad request");
+      return;
+    }
+    *targetEnd = '\0';
+
+    char *query = strchr(target, '?');
+    if (query != nullptr) *query++ = '\0';
+    parseArgs(query);
+
+    HttpHandler handler = nullptr;
+    uint8_t route = 255;
+    for (uint8_t i = 0; i < routeCount; i++)
+    {
+      if (strcmp(routes[i].path, target) == 0)
+      {
+        handler = routes[i].handler;
+        route = i;
+        break;
+      }
+    }
+
+    current = &slot;
+    slot.body = nullptr;
+    unsigned long start = micros();
+    if (handler != nullptr)
+    {
+      handler();
+    }
+    traceRecord(TRACE_HTTP, route, traceDuration(micros() - start));
+    if (slot.body == nullptr)
+    {
+      send(handler ? 500 : 404, "text/plain", handler ? "No response" : "Not found");
+    }
+    current = nullptr;
+    argCount = 0;
+  }
+
+  // 쿼리 문자열을 제자리에서 분리/디코딩
+  void parseArgs(char *query)
+  {
+    argCount = 0;
+    while (query != nullptr && *query && argCount < HTTP_MAX_ARGS)
+    {
+      char *next = strchr(query, '&');
+      if (next != nullptr) *next++ = '\0';
+
+      char *value = strchr(query, '=');
+      if (value != nullptr) *value++ = '\0';
+      else value = query + strlen(query);
+
+      urlDecode(query);
+      urlDecode(value);
+      argNames[argCount] = query;
+      argValues[argCount] = value;
+      argCount++;
+      query = next;
+    }
+  }
+
+  static uint8_t hexValue(char c)
+  {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return 0;
+  }
+
+  static void urlDecode(char *s)
+  {
+    char *out = s;
+    while (*s)
+    {
+      if (*s == '+')
+      {
+        *out++ = ' ';
+        s++;
+      }
+      else if (*s == '%' && s[1] && s[2])
+      {
+        *out++ = (hexValue(s[1]) << 4) | hexValue(s[2]);
+        s += 3;
+      }
+      else
+      {
+        *out++ = *s++;
+      }
+    }
+    *out = '\0';
+  }
+
+  int findArg(const char *name) const
+  {
+    for (uint8_t i = 0; i < argCount; i++)
+    {
+      if (strcmp(argNames[i], name) == 0) return i;
+    }
+    return -1;
+  }
+
+  static const char *statusText(int code)
+  {
+    switch (code)
+    {
+      case 200: return "OK";
+      case 400: return "Bad Request";
+      case 404: return "Not Found";
+      case 413: return "Payload Too Large";
+      default: return "Error";
+    }
+  }
+
+  void prepareResponse(int code, const char *contentType, const char *content, size_t length, bool progmem)
+  {
+    if (current == nullptr) return;
+    fillResponse(*current, code, contentType, content, length, progmem);
+  }
+
+  void fillResponse(HttpSlot &slot, int code, const char *contentType, const char *content, size_t length, bool progmem)
+  {
+    slot.headerLength = snprintf(slot.header, sizeof(slot.header),
+                                 "HTTP/1.1 %d %s\r\nContent-Type: %s\r\nContent-Length: %u\r\n"
+                                 "Connection: close\r\n\r\n",
+                                 code, statusText(code), contentType, (unsigned)length);
+    if (slot.headerLength >= sizeof(slot.header)) slot.headerLength = sizeof(slot.header) - 1;
+    slot.body = content;
+    slot.bodyLength = length;
+    slot.bodyProgmem = progmem;
+    slot.sent = 0;
+    setState(slot, HTTP_WRITING);
+  }
+
+  void respondError(HttpSlot &slot, int code, const char *message)
+  {
+    fillResponse(slot, code, "text/plain", message, strlen(message), false);
+  }
+
+  // 공유 jsonBuffer를 본문으로 전송 중인 연결이 있는지
+  bool sharedBodyInFlight() const
+  {
+    for (int i = 0; i < HTTP_MAX_CLIENTS; i++)
+    {
+      if (slots[i].state == HTTP_WRITING && slots[i].body == jsonBuffer) return true;
+    }
+    return false;
+  }
+
+  // 송신 버퍼에 들어가는 만큼만 쓰고 돌아옴
+  void writeResponse(HttpSlot &slot, unsigned long start, uint32_t budgetUs)
+  {
+    uint32_t total = slot.headerLength + slot.bodyLength;
+    char chunk[HTTP_WRITE_CHUNK];
+
+    while (slot.sent < total && micros() - start <= budgetUs)
+    {
+      size_t room = slot.client.availableForWrite();
+      if (room == 0) break;
+
+      size_t n;
+      if (slot.sent < slot.headerLength)
+      {
+        n = min((size_t)(slot.headerLength - slot.sent), room);
+        n = slot.client.write((const uint8_t *)slot.header + slot.sent, n);
+      }
+      else
+      {
+        uint32_t offset = slot.sent - slot.headerLength;
+        n = min((size_t)(slot.bodyLength - offset), min(room, sizeof(chunk)));
+        if (slot.bodyProgmem)
+        {
+          memcpy_P(chunk, slot.body + offset, n);
+          n = slot.client.write((const uint8_t *)chunk, n);
+        }
+        else
+        {
+          n = slot.client.write((const uint8_t *)slot.body + offset, n);
+        }
+      }
+      if (n == 0) break;
+      slot.sent += n;
+    }
+
+    if (slot.sent >= total || !slot.client.connected() || millis() - slot.since > HTTP_WRITE_TIMEOUT)
+    {
+      closeSlot(slot);
+    }
+  }
+};
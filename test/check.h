@@ -0,0 +1,39 @@
+// 호스트 시험 공통: 실패한 검사를 파일/줄과 함께 출력하고 main()의 종료 코드로 돌려줌
+//   CHECK(조건), CHECK_EQ(실제, 기대)
+//   int main() { ...; return checkResult(); }
+
+#pragma once
+
+#include <stdio.h>
+
+inline int checkFailures = 0;
+inline int checkCount = 0;
+
+#define CHECK(cond)                                                      \
+  do {                                                                   \
+    checkCount++;                                                        \
+    if (!(cond))                                                         \
+    {                                                                    \
+      checkFailures++;                                                   \
+      fprintf(stderr, "%s:%d: CHECK(%s) 실패\n", __FILE__, __LINE__, #cond); \
+    }                                                                    \
+  } while (0)
+
+#define CHECK_EQ(actual, expected)                                                        \
+  do {                                                                                    \
+    checkCount++;                                                                         \
+    long long checkActual = (long long)(actual);                                          \
+    long long checkExpected = (long long)(expected);                                      \
+    if (checkActual != checkExpected)                                                     \
+    {                                                                                     \
+      checkFailures++;                                                                    \
+      fprintf(stderr, "%s:%d: %s == %lld, 기대값 %lld\n", __FILE__, __LINE__, #actual,      \
+              checkActual, checkExpected);                                                \
+    }                                                                                     \
+  } while (0)
+
+inline int checkResult()
+{
+  fprintf(stderr, "%s: 검사 %d개, 실패 %d개\n", checkFailures ? "FAIL" : "ok", checkCount, checkFailures);
+  return checkFailures ? 1 : 0;
+}
@@ -0,0 +1,66 @@
+// 펌웨어 전체(src/main.cpp)를 포함하는 시험용 도구
+// 빈 포트로 부팅하고, loop()를 돌리면서 실제 소켓으로 HTTP/UDP 요청을 보낸다.
+// 부팅/유휴 대기 시간은 hostClockAdvance()로 건너뛴다.
+
+#pragma once
+
+#include "main.cpp"
+#include "check.h"
+
+#include <string>
+
+// 빈 포트로 setup() 후 부팅 단계를 모두 진행
+inline void firmwareBoot()
+{
+  Serial.muted = true;
+  hostMapPort(80, 0);
+  hostMapPort(UDP_CONTROL_PORT, 0);
+  setup();
+  for (int i = 0; i < 100 && !bootDone(); i++)
+  {
+    if (bootStage == BOOT_IP_SCREEN) hostClockAdvance(BOOT_IP_SCREEN_MS * 1000UL);
+    loop();
+  }
+}
+
+inline void firmwareLoops(int count)
+{
+  for (int i = 0; i < count; i++)
+  {
+    hostRunTimers();
+    loop();
+  }
+}
+
+// HTTP GET을 보내고 응답이 끝날 때까지 loop()를 돌림 (응답 전체, 실패하면 빈 문자열)
+inline std::string firmwareGet(const char *path)
+{
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(hostBoundPort(80));
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) return "";
+
+  std::string request = std::string("GET ") + path + " HTTP/1.1\r\nHost: test\r\n\r\n";
+  send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+
+  std::string response;
+  for (int i = 0; i < 1000; i++)
+  {
+    loop();
+    char buffer[1024];
+    ssize_t n = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (n > 0) response.append(buffer, n);
+    else if (n == 0) break;
+  }
+  close(fd);
+  return response;
+}
+
+// 응답 본문 (헤더 뒤)
+inline std::string firmwareBody(const std::string &response)
+{
+  size_t start = response.find("\r\n\r\n");
+  return start == std::string::npos ? std::string() : response.substr(start + 4);
+}
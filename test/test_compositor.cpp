@@ -0,0 +1,124 @@
+// 레이어 합성: 느린 간격 효과(모닥불)를 오버레이로 올려도 기본 모드처럼 단계 사이가 보간되는지,
+// 레이어 효과를 바꾸면 이전 효과의 키프레임을 버리는지, 키프레임이 효과 영역 안에 있는지,
+// 레이어/baseLayer 버퍼를 켠 동안만 잡는지 확인
+
+#include "firmware.h"
+
+static std::string snapshot()
+{
+  return std::string((const char *)leds, NUMPIXELS * sizeof(CRGB));
+}
+
+int main()
+{
+  firmwareBoot();
+  CHECK(bootDone());
+
+  // 기본은 검은 단색, 그 위에 모닥불을 덮어쓰기로
+  char path[64];
+  firmwareGet("/setColor?r=0&g=0&b=0");
+  snprintf(path, sizeof(path), "/setMode?mode=%d", NORMAL_MODE);
+  firmwareGet(path);
+  firmwareLoops(2);
+  CHECK(overlays[0] == nullptr && overlays[1] == nullptr);
+  CHECK(baseLayer == nullptr);
+  CHECK_EQ(overlayBytes, 0u);
+
+  snprintf(path, sizeof(path), "/layers?slot=0&mode=%d&opacity=255&blend=normal", CAMPFIRE_MODE);
+  CHECK(firmwareBody(firmwareGet(path)).find("\"enabled\":true") != std::string::npos);
+  CHECK(overlays[0] != nullptr && overlays[1] == nullptr);
+  OverlayLayer &layer = *overlays[0];
+  CHECK(!layer.interp.valid);
+
+  // 실제 시간은 멈추고 단계 간격의 1/16씩 앞당기며 프레임을 그림
+  hostClockFreeze(true);
+  uint32_t baseKeyframes = interp.keyframes;
+  uint16_t period = modeStepPeriod(CAMPFIRE_MODE);
+  CHECK(period >= INTERP_FRAME_MS * 2);
+  uint32_t tick = max(period / 16, INTERP_FRAME_MS);
+  for (int i = 0; i < 64; i++)
+  {
+    hostClockAdvance(tick * 1000UL);
+    renderFrame();
+  }
+  CHECK(layer.interp.keyframes >= 3);
+
+  // 한 단계 안에서 출력이 여러 번 바뀜 (보간 없으면 단계마다 한 번)
+  // 덮어쓰기(불투명도 255)이므로 출력은 레이어의 두 키프레임 사이 보간값 그대로
+  uint32_t keyframes = layer.interp.keyframes;
+  while (layer.interp.keyframes == keyframes)
+  {
+    hostClockAdvance(tick * 1000UL);
+    renderFrame();
+  }
+  keyframes = layer.interp.keyframes;
+  int outputs = 0;
+  bool lerped = true;
+  std::string previous = snapshot();
+  for (;;)
+  {
+    hostClockAdvance(tick * 1000UL);
+    renderFrame();
+    if (layer.interp.keyframes != keyframes) break;
+    std::string now = snapshot();
+    if (now == previous) continue;
+    outputs++;
+    previous = now;
+
+    uint16_t frac = layer.interp.lastFrac;
+    const InterpFrames &frames = reinterpret_cast<const CampfireState *>(layer.arena)->keyframes;
+    for (int i = 0; i < NUMPIXELS; i++)
+    {
+      const CRGB &a = frames.prev[i], &b = frames.next[i];
+      CRGB expected(interpLerp(a.r, b.r, frac), interpLerp(a.g, b.g, frac), interpLerp(a.b, b.b, frac));
+      lerped = lerped && leds[i] == expected;
+    }
+  }
+  CHECK(outputs >= 2);
+  CHECK(lerped);
+
+  // 기본 모드의 보간 상태와는 따로 (기본은 단색이라 키프레임이 늘지 않음)
+  CHECK_EQ(interp.keyframes, baseKeyframes);
+
+  // 보간하지 않는 효과로 바꾸면 키프레임을 버리고, 돌아오면 처음부터
+  hostClockFreeze(false);
+  snprintf(path, sizeof(path), "/layers?slot=0&mode=%d", AURORA_MODE);
+  firmwareGet(path);
+  CHECK(!layer.interp.valid);
+  snprintf(path, sizeof(path), "/layers?slot=0&mode=%d", CAMPFIRE_MODE);
+  firmwareGet(path);
+  CHECK(!layer.interp.valid);
+  firmwareLoops(5);
+
+  // 키프레임은 지금 그리는 효과 영역 안 (보간하지 않는 모드는 없음)
+  const uint8_t *arenaFrames = (const uint8_t *)modeKeyframes(CHRISTMAS_MODE);
+  CHECK(arenaFrames >= effectArena && arenaFrames + sizeof(InterpFrames) <= effectArena + effectArenaSize);
+  CHECK(modeKeyframes(AURORA_MODE) == nullptr);
+
+  // 켠 레이어는 효과 상태 영역과 한 번에 할당되고, 합성하는 동안만 baseLayer가 있음
+  CHECK(compositing && baseLayer != nullptr);
+  CHECK(layer.arena == (uint8_t *)&layer + sizeof(OverlayLayer));
+  CHECK_EQ(overlayBytes, (uint32_t)(sizeof(OverlayLayer) + effectArenaSize + NUMPIXELS * sizeof(CRGB)));
+
+  // 불투명도 0이면 레이어는 남아 있어도 합성하지 않으므로 baseLayer를 돌려줌
+  firmwareGet("/layers?slot=0&opacity=0");
+  renderFrame();
+  CHECK(overlays[0] != nullptr);
+  CHECK(!compositing && baseLayer == nullptr);
+  CHECK_EQ(overlayBytes, (uint32_t)(sizeof(OverlayLayer) + effectArenaSize));
+
+  // 끄면 레이어 버퍼도 돌려주고 기본 모드(검은 단색)만 남음
+  firmwareGet("/layers?slot=0&opacity=255");
+  renderFrame();
+  CHECK(compositing);
+  CHECK(firmwareBody(firmwareGet("/layers?slot=0&mode=-1")).find("\"ramBytes\":") != std::string::npos);
+  CHECK(overlays[0] == nullptr);
+  renderFrame();
+  CHECK(!compositing && baseLayer == nullptr);
+  CHECK_EQ(overlayBytes, 0u);
+  bool black = true;
+  for (int i = 0; i < NUMPIXELS; i++) black = black && !leds[i];
+  CHECK(black);
+
+  return checkResult();
+}
@@ -0,0 +1,116 @@
+// 조명 간 동기화: 효과 초기 상태가 공유 시드로만 정해지는지, 왕복 시간 절반을 한쪽 지연으로 보정하는지,
+// 리더가 프로브에 같은 seq로 회신하는지 확인
+
+#include "firmware.h"
+
+// animMillis()가 정확히 at이 되도록 맞춤
+static void setAnimTime(uint32_t at)
+{
+  syncOffset = (int32_t)(at - millis());
+}
+
+// 효과를 처음부터 한 단계 계산한 결과 (이전 난수 상태를 흐트러뜨린 뒤)
+static std::string renderFresh(bool (*mode)(), long noise)
+{
+  randomSeed(noise);
+  for (long i = 0; i < noise % 17; i++) random(100);
+  resetEffectArena();
+  setAnimTime(1000000);
+  mode();
+  return std::string((const char *)leds, NUMPIXELS * sizeof(CRGB));
+}
+
+static void testSeededInit()
+{
+  effectSeed = 0x12345678;
+  CHECK(renderFresh(campfireMode, 1) == renderFresh(campfireMode, 987654));
+  CHECK(renderFresh(warmLightMode, 3) == renderFresh(warmLightMode, 55555));
+
+  // 시드가 다르면 다른 불꽃
+  std::string a = renderFresh(campfireMode, 1);
+  effectSeed = 0x87654321;
+  CHECK(a != renderFresh(campfireMode, 1));
+}
+
+static void testLatencyCorrection()
+{
+  frameSyncBegin(SYNC_FOLLOWER);
+  hostClockFreeze(true);
+  setAnimTime(50000);
+
+  // 프로브 송신 후 40ms 뒤 응답: 한쪽 지연 20ms
+  hostClockAdvance(SYNC_PROBE_INTERVAL * 1000UL);
+  frameSyncLoop();
+  CHECK(syncProbePending);
+  uint16_t seq = syncProbeSeq;
+  hostClockAdvance(40000);
+
+  // 리더 시계는 5초 앞서 있고, 응답에 찍힌 시간은 20ms 전 값
+  uint32_t follower = animMillis();
+  frameSyncReceive(follower + 5000 - 20, 7, seq);
+  CHECK_EQ(syncRtt, 40);
+  CHECK_EQ(syncLatency, 20);
+  CHECK(!syncProbePending);
+  CHECK(abs((int32_t)(animMillis() - (follower + 5000))) <= 1);
+  CHECK_EQ(effectSeed, 7);
+
+  // 이후 브로드캐스트(seq 0)도 같은 지연을 더함: 20ms 전 리더 시간이면 오차 없음
+  frameSyncReceive(animMillis() - 20, 7, 0);
+  CHECK(abs(syncLastError) <= 1);
+  CHECK_EQ(syncLatency, 20);
+
+  // 번호가 다르거나 너무 늦은 응답은 지연 추정에 쓰지 않음
+  hostClockAdvance(SYNC_PROBE_INTERVAL * 1000UL);
+  frameSyncLoop();
+  frameSyncReceive(animMillis(), 7, syncProbeSeq + 1);
+  CHECK(syncProbePending);
+  hostClockAdvance((SYNC_MAX_RTT + 50) * 1000UL);
+  frameSyncReceive(animMillis(), 7, syncProbeSeq);
+  CHECK_EQ(syncLatency, 20);
+  hostClockFreeze(false);
+}
+
+static void testLeaderAnswersProbe()
+{
+  frameSyncBegin(SYNC_LEADER);
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  ControlPacket probe = {};
+  probe.magic = CTRL_MAGIC;
+  probe.version = CTRL_VERSION;
+  probe.opcode = CTRL_OP_SYNC_PROBE;
+  probe.seq = 9;
+  struct sockaddr_in to = {};
+  to.sin_family = AF_INET;
+  to.sin_port = htons(hostBoundPort(UDP_CONTROL_PORT));
+  to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  sendto(fd, &probe, sizeof(probe), 0, (struct sockaddr *)&to, sizeof(to));
+  firmwareLoops(2);
+
+  ControlPacket reply = {};
+  CHECK(recv(fd, &reply, sizeof(reply), MSG_DONTWAIT) == (ssize_t)sizeof(reply));
+  CHECK_EQ(reply.opcode, CTRL_OP_SYNC);
+  CHECK_EQ(reply.seq, 9);
+  uint32_t leaderTime, seed;
+  memcpy(&leaderTime, reply.payload, 4);
+  memcpy(&seed, reply.payload + 4, 4);
+  CHECK(animMillis() - leaderTime < 100);
+  CHECK_EQ(seed, effectSeed);
+  close(fd);
+
+  // 리더가 아니면 회신하지 않음
+  frameSyncBegin(SYNC_OFF);
+  fd = socket(AF_INET, SOCK_DGRAM, 0);
+  sendto(fd, &probe, sizeof(probe), 0, (struct sockaddr *)&to, sizeof(to));
+  firmwareLoops(2);
+  CHECK(recv(fd, &reply, sizeof(reply), MSG_DONTWAIT) < 0);
+  close(fd);
+}
+
+int main()
+{
+  firmwareBoot();
+  testSeededInit();
+  testLatencyCorrection();
+  testLeaderAnswersProbe();
+  return checkResult();
+}
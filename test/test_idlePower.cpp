@@ -0,0 +1,105 @@
+// 유휴 추적: 가짜 시계(인자로 넘기는 now)로 진입/해제 시점과 누적 시간,
+// WiFi 절전 설정을 STA 연결 시에만 바꾸고 이전 값으로 되돌리는지 확인
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "idlePower.h"
+#include "check.h"
+
+static void resetTracker()
+{
+  memset(&idleTracker, 0, sizeof(idleTracker));
+}
+
+static void testTiming()
+{
+  resetTracker();
+  WiFi.mode(WIFI_AP);
+  unsigned long t = 1000;
+  idleNoteFrame(true, t);
+
+  // IDLE_ENTER_MS 직전까지는 유휴 아님
+  idleNoteFrame(false, t + IDLE_ENTER_MS - 1);
+  CHECK(!idleTracker.idle);
+  idleNoteFrame(false, t + IDLE_ENTER_MS);
+  CHECK(idleTracker.idle);
+  CHECK_EQ(idleTracker.entries, 1);
+  CHECK_EQ(idleTimeMs(t + IDLE_ENTER_MS + 500), 500);
+
+  // 출력이 바뀌면 깨어나고 누적 시간에 더함
+  idleNoteFrame(true, t + IDLE_ENTER_MS + 700);
+  CHECK(!idleTracker.idle);
+  CHECK_EQ(idleTracker.idleTotalMs, 700);
+  CHECK_EQ(idleTimeMs(t + 99999), 700);
+
+  // 다시 IDLE_ENTER_MS 동안 변화가 없어야 진입
+  idleNoteFrame(false, t + IDLE_ENTER_MS + 700 + IDLE_ENTER_MS - 1);
+  CHECK(!idleTracker.idle);
+  idleNoteFrame(false, t + 2 * IDLE_ENTER_MS + 700);
+  CHECK(idleTracker.idle);
+  CHECK_EQ(idleTracker.entries, 2);
+
+  // 외부 활동도 깨우고 대기 시간을 처음부터 다시 셈
+  unsigned long wake = t + 2 * IDLE_ENTER_MS + 1000;
+  idleWake(wake);
+  CHECK(!idleTracker.idle);
+  CHECK_EQ(idleTracker.idleTotalMs, 1000);
+  idleNoteFrame(false, wake + IDLE_ENTER_MS - 1);
+  CHECK(!idleTracker.idle);
+
+  // millis() 넘침을 건너도 간격 계산이 맞음
+  resetTracker();
+  unsigned long nearWrap = (unsigned long)-500;
+  idleNoteFrame(true, nearWrap);
+  idleNoteFrame(false, nearWrap + IDLE_ENTER_MS);
+  CHECK(idleTracker.idle);
+  CHECK_EQ(idleTimeMs(nearWrap + IDLE_ENTER_MS + 100), 100);
+}
+
+static void enterAndExit()
+{
+  resetTracker();
+  idleNoteFrame(true, 0);
+  idleNoteFrame(false, IDLE_ENTER_MS);
+  CHECK(idleTracker.idle);
+}
+
+static void testSleepMode()
+{
+  // AP 전용: 절전 설정을 건드리지 않음
+  WiFi.mode(WIFI_AP);
+  WiFi.setSleepMode(WIFI_MODEM_SLEEP);
+  uint32_t changes = WiFi.sleepChanges;
+  enterAndExit();
+  CHECK_EQ(WiFi.sleepChanges, changes);
+  idleWake(IDLE_ENTER_MS + 1);
+  CHECK_EQ(WiFi.sleepChanges, changes);
+
+  // STA 모드지만 아직 연결 안 됨: 건드리지 않음
+  WiFi.mode(WIFI_AP_STA);
+  WiFi.staStatus = WL_DISCONNECTED;
+  enterAndExit();
+  CHECK_EQ(WiFi.sleepChanges, changes);
+  idleWake(IDLE_ENTER_MS + 1);
+
+  // STA 연결됨: 유휴 동안 라이트 슬립, 깨어나면 사용자가 정한 이전 값(절전 없음)으로 복원
+  WiFi.staStatus = WL_CONNECTED;
+  WiFi.setSleepMode(WIFI_NONE_SLEEP);
+  enterAndExit();
+  CHECK_EQ(WiFi.getSleepMode(), WIFI_LIGHT_SLEEP);
+  idleWake(IDLE_ENTER_MS + 1);
+  CHECK_EQ(WiFi.getSleepMode(), WIFI_NONE_SLEEP);
+
+  // 유휴 중에 연결이 끊겨도 복원은 함
+  enterAndExit();
+  WiFi.staStatus = WL_DISCONNECTED;
+  idleNoteFrame(true, IDLE_ENTER_MS + 5);
+  CHECK_EQ(WiFi.getSleepMode(), WIFI_NONE_SLEEP);
+}
+
+int main()
+{
+  testTiming();
+  testSleepMode();
+  return checkResult();
+}
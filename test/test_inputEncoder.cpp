@@ -0,0 +1,151 @@
+// 엔코더 입력: 쿼드러처 상태 머신의 한 칸 판정과 채터링/역회전 처리, 링 버퍼, GPIO 레지스터로 돈 ISR
+
+#include <Arduino.h>
+#include "inputEncoder.h"
+#include "check.h"
+
+// 핀 값 순서(bit1 = CLK, bit0 = DT)를 넣고 나온 칸 수 합
+static int feed(std::initializer_list<uint8_t> sequence)
+{
+  uint8_t state = QUAD_START;
+  int total = 0;
+  for (uint8_t pins : sequence) total += quadratureStep(state, pins);
+  return total;
+}
+
+static void testQuadrature()
+{
+  // 멈춤 위치는 둘 다 HIGH(11), 시계방향은 CLK가 먼저 떨어짐
+  CHECK_EQ(feed({0b11, 0b01, 0b00, 0b10, 0b11}), 1);
+  CHECK_EQ(feed({0b11, 0b10, 0b00, 0b01, 0b11}), -1);
+
+  // 칸은 마지막(11로 돌아올 때) 한 번만
+  uint8_t state = QUAD_START;
+  CHECK_EQ(quadratureStep(state, 0b01), 0);
+  CHECK_EQ(quadratureStep(state, 0b00), 0);
+  CHECK_EQ(quadratureStep(state, 0b10), 0);
+  CHECK_EQ(quadratureStep(state, 0b11), 1);
+  CHECK_EQ(state & 0x0F, QUAD_START);
+
+  // 접점 채터링: 같은 경계를 여러 번 오가도 한 칸
+  CHECK_EQ(feed({0b11, 0b01, 0b11, 0b01, 0b00, 0b01, 0b00, 0b10, 0b00, 0b10, 0b11}), 1);
+  // 반 칸 돌렸다 되돌아옴
+  CHECK_EQ(feed({0b11, 0b01, 0b00, 0b01, 0b11}), 0);
+  // 단계를 건너뛴 잘못된 전이는 무시
+  CHECK_EQ(feed({0b11, 0b00, 0b11}), 0);
+  CHECK_EQ(feed({0b11, 0b01, 0b10, 0b11}), 0);
+
+  // 빠르게 여러 칸: 놓치지 않음
+  uint8_t fast = QUAD_START;
+  int total = 0;
+  for (int i = 0; i < 100; i++)
+  {
+    for (uint8_t pins : {0b01, 0b00, 0b10, 0b11}) total += quadratureStep(fast, pins);
+  }
+  CHECK_EQ(total, 100);
+  for (int i = 0; i < 30; i++)
+  {
+    for (uint8_t pins : {0b10, 0b00, 0b01, 0b11}) total += quadratureStep(fast, pins);
+  }
+  CHECK_EQ(total, 70);
+}
+
+static void testQueue()
+{
+  inputHead = inputTail = 0;
+  inputDropped = 0;
+
+  // 한 칸은 비워 두므로 INPUT_QUEUE_SIZE - 1개까지
+  for (int i = 0; i < INPUT_QUEUE_SIZE - 1; i++) CHECK(pushInputEvent(INPUT_ROTATE, 1, i));
+  CHECK(!pushInputEvent(INPUT_ROTATE, 1, 99));
+  CHECK_EQ(inputDropped, 1);
+
+  InputEvent event;
+  for (int i = 0; i < INPUT_QUEUE_SIZE - 1; i++)
+  {
+    CHECK(popInputEvent(event));
+    CHECK_EQ(event.cycles, i);
+  }
+  CHECK(!popInputEvent(event));
+
+  // 끝을 넘어 돌아도 순서 유지
+  for (int round = 0; round < 3; round++)
+  {
+    for (int i = 0; i < 10; i++) pushInputEvent(INPUT_BUTTON_PRESS, 0, round * 10 + i);
+    for (int i = 0; i < 10; i++)
+    {
+      CHECK(popInputEvent(event));
+      CHECK_EQ(event.cycles, round * 10 + i);
+    }
+  }
+}
+
+static void setPins(bool clk, bool dt, bool sw)
+{
+  uint32_t gpio = 0xFFFFFFFF;
+  if (!clk) gpio &= ~(1UL << ENCODER_CLK_PIN);
+  if (!dt) gpio &= ~(1UL << ENCODER_DT_PIN);
+  if (!sw) gpio &= ~(1UL << ENCODER_SW_PIN);
+  hostGpioInput = gpio;
+}
+
+static void testInterrupts()
+{
+  inputHead = inputTail = 0;
+  quadratureState = QUAD_START;
+
+  // 핀마다 CHANGE 인터럽트가 오는 것처럼 한 칸 시계방향
+  const bool steps[4][2] = {{0, 1}, {0, 0}, {1, 0}, {1, 1}};
+  for (const bool *pins : steps)
+  {
+    setPins(pins[0], pins[1], true);
+    encoderISR();
+  }
+  InputEvent event;
+  CHECK(popInputEvent(event));
+  CHECK_EQ(event.type, INPUT_ROTATE);
+  CHECK_EQ(event.delta, 1);
+  CHECK(!popInputEvent(event));
+
+  // 버튼: 누름만 이벤트, BUTTON_DEBOUNCE_US 안의 튐은 무시
+  hostClockAdvance(BUTTON_DEBOUNCE_US * 2);
+  setPins(true, true, false);
+  buttonISR();
+  hostClockAdvance(1000);
+  setPins(true, true, true);
+  buttonISR();
+  setPins(true, true, false);
+  buttonISR();
+  CHECK(popInputEvent(event));
+  CHECK_EQ(event.type, INPUT_BUTTON_PRESS);
+  CHECK(!popInputEvent(event));
+
+  // 떼기(HIGH)는 이벤트 없음, 다시 누르면 이벤트
+  hostClockAdvance(BUTTON_DEBOUNCE_US * 2);
+  setPins(true, true, true);
+  buttonISR();
+  CHECK(!popInputEvent(event));
+  hostClockAdvance(BUTTON_DEBOUNCE_US * 2);
+  setPins(true, true, false);
+  buttonISR();
+  CHECK(popInputEvent(event));
+}
+
+static void testAcceleration()
+{
+  CHECK_EQ(encoderAcceleration(0), 16);
+  CHECK_EQ(encoderAcceleration(14999), 16);
+  CHECK_EQ(encoderAcceleration(15000), 8);
+  CHECK_EQ(encoderAcceleration(40000), 4);
+  CHECK_EQ(encoderAcceleration(100000), 2);
+  CHECK_EQ(encoderAcceleration(0xFFFFFFFF), 2);
+}
+
+int main()
+{
+  testQuadrature();
+  testQueue();
+  testInterrupts();
+  testAcceleration();
+  return checkResult();
+}
@@ -0,0 +1,99 @@
+// JsonWriter: 쉼표/중첩/정수 경계/버퍼 초과, parseIntStrict: 허용/거부하는 입력
+
+#include <Arduino.h>
+#include "jsonWriter.h"
+#include "check.h"
+
+#include <limits.h>
+
+static void testStructure()
+{
+  char buffer[256];
+  JsonWriter json(buffer, sizeof(buffer));
+  json.beginObject();
+  json.field("a", 1);
+  json.key("list");
+  json.beginArray();
+  json.value(0);
+  json.value(-7);
+  json.beginObject();
+  json.field("on", true);
+  json.endObject();
+  json.beginArray();
+  json.endArray();
+  json.endArray();
+  json.field("name", "Campfire");
+  json.field("off", false);
+  json.endObject();
+  CHECK(strcmp(json.c_str(), "{\"a\":1,\"list\":[0,-7,{\"on\":true},[]],\"name\":\"Campfire\",\"off\":false}") == 0);
+  CHECK_EQ(json.length(), strlen(json.c_str()));
+  CHECK(!json.overflowed());
+}
+
+static void testIntegerLimits()
+{
+  char buffer[128];
+  JsonWriter json(buffer, sizeof(buffer));
+  json.beginArray();
+  json.value(LONG_MIN);
+  json.value(LONG_MAX);
+  json.value(ULONG_MAX);
+  json.value((unsigned int)0);
+  json.endArray();
+  char expected[128];
+  snprintf(expected, sizeof(expected), "[%ld,%ld,%lu,0]", LONG_MIN, LONG_MAX, ULONG_MAX);
+  CHECK(strcmp(json.c_str(), expected) == 0);
+}
+
+static void testOverflow()
+{
+  // 용량에는 끝의 '\0'이 포함됨: "[1]"은 4바이트 버퍼에 맞음
+  char exact[4];
+  JsonWriter fits(exact, sizeof(exact));
+  fits.beginArray();
+  fits.value(1);
+  fits.endArray();
+  CHECK(!fits.overflowed());
+  CHECK(strcmp(exact, "[1]") == 0);
+
+  char small[8];
+  JsonWriter json(small, sizeof(small));
+  json.beginObject();
+  json.field("long", "abcdefgh");
+  json.endObject();
+  CHECK(json.overflowed());
+  CHECK(json.length() < sizeof(small));
+  CHECK_EQ(strlen(small), json.length());  // 넘친 뒤에도 문자열은 끝이 있음
+}
+
+static void testParseIntStrict()
+{
+  int value = 123;
+  CHECK(parseIntStrict("0", value) && value == 0);
+  CHECK(parseIntStrict("42", value) && value == 42);
+  CHECK(parseIntStrict("007", value) && value == 7);
+  CHECK(parseIntStrict("-5", value) && value == -5);
+  CHECK(parseIntStrict("1000000", value) && value == 1000000);
+
+  value = 99;
+  CHECK(!parseIntStrict(nullptr, value));
+  CHECK(!parseIntStrict("", value));
+  CHECK(!parseIntStrict("-", value));
+  CHECK(!parseIntStrict("+5", value));
+  CHECK(!parseIntStrict(" 5", value));
+  CHECK(!parseIntStrict("5 ", value));
+  CHECK(!parseIntStrict("12a", value));
+  CHECK(!parseIntStrict("1.5", value));
+  CHECK(!parseIntStrict("1000001", value));
+  CHECK(!parseIntStrict("99999999999999999999", value));  // int32 넘침 전에 거부
+  CHECK_EQ(value, 99);  // 실패하면 출력값을 건드리지 않음
+}
+
+int main()
+{
+  testStructure();
+  testIntegerLimits();
+  testOverflow();
+  testParseIntStrict();
+  return checkResult();
+}
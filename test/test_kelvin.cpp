@@ -0,0 +1,55 @@
+// 색온도 -> RGB: 표의 점은 그대로, 사이는 선형 보간, 범위 밖은 끝 값
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "kelvin.h"
+#include "check.h"
+
+static bool same(const CRGB &color, uint8_t r, uint8_t g, uint8_t b)
+{
+  return color.r == r && color.g == g && color.b == b;
+}
+
+int main()
+{
+  // 표의 점
+  CHECK(same(kelvinToRGB(1500), 255, 109, 0));
+  CHECK(same(kelvinToRGB(2500), 255, 164, 79));
+  CHECK(same(kelvinToRGB(6500), 255, 249, 253));
+  CHECK(same(kelvinToRGB(10000), 204, 219, 255));
+  for (int k = KELVIN_MIN; k <= KELVIN_MAX; k += KELVIN_STEP)
+  {
+    const uint8_t *row = kelvinTable[(k - KELVIN_MIN) / KELVIN_STEP];
+    CHECK(same(kelvinToRGB(k), row[0], row[1], row[2]));
+  }
+
+  // 사이 값: 2000K(255,147,41)와 2500K(255,164,79)의 1/5 지점
+  CHECK(same(kelvinToRGB(2100), 255, 147 + 17 / 5, 41 + 38 / 5));
+  // 6500K(255,249,253)와 7000K(245,243,255)의 중간 (빨강/초록은 줄어듦)
+  CHECK(same(kelvinToRGB(6750), 250, 246, 254));
+  // 마지막 구간 바로 아래: 9500K(208,222,255)에서 10000K 쪽으로 499/500 (나눗셈은 0 쪽으로 버림)
+  CHECK(same(kelvinToRGB(9999), 205, 220, 255));
+
+  // 범위 밖은 끝 값으로 자름
+  CHECK(same(kelvinToRGB(0), 255, 109, 0));
+  CHECK(same(kelvinToRGB(1499), 255, 109, 0));
+  CHECK(same(kelvinToRGB(10001), 204, 219, 255));
+  CHECK(same(kelvinToRGB(65535), 204, 219, 255));
+
+  // 온도가 올라가면 파랑은 줄지 않고 빨강은 늘지 않음
+  CRGB previous = kelvinToRGB(KELVIN_MIN);
+  for (int k = KELVIN_MIN + 10; k <= KELVIN_MAX; k += 10)
+  {
+    CRGB color = kelvinToRGB(k);
+    CHECK(color.b >= previous.b);
+    CHECK(color.r <= previous.r);
+    previous = color;
+  }
+
+  CHECK(isValidKelvin(KELVIN_MIN));
+  CHECK(isValidKelvin(KELVIN_MAX));
+  CHECK(!isValidKelvin(KELVIN_MIN - 1));
+  CHECK(!isValidKelvin(KELVIN_MAX + 1));
+  CHECK(!isValidKelvin(0));
+  return checkResult();
+}
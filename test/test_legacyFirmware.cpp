@@ -0,0 +1,106 @@
+// AVR NeoPixel 펌웨어(src/legacy/main.cpp): 공용 커널이 NeoPixel 버퍼에 바로 쓴 값이
+// 라이브러리의 setPixelColor()와 같은지 (모든 색 순서, 밝기), 앞쪽 SKIP_PIXELS개는 꺼진 채인지,
+// 크리스마스/모닥불 패턴이 스트립에 그려지는지 확인
+
+#include "legacy/main.cpp"
+#include "check.h"
+
+// 전송 순서 바이트를 R, G, B로 (스트립의 NEO_ 형식으로 푼 값)
+static CRGB stripColor(uint16_t i)
+{
+  const uint8_t *p = strip.getPixels() + i * 3;
+  return CRGB(p[orderByte(LED_COLOR_ORDER, 0)], p[orderByte(LED_COLOR_ORDER, 1)], p[orderByte(LED_COLOR_ORDER, 2)]);
+}
+
+static bool skippedDark()
+{
+  for (int i = 0; i < SKIP_PIXELS; i++)
+  {
+    if (stripColor(i)) return false;
+  }
+  return true;
+}
+
+// 같은 색을 PackedSink와 setPixelColor()로 써서 버퍼가 같은지
+template <EOrder Order>
+static void checkOrder(neoPixelType type)
+{
+  CHECK_EQ(neoPixelOrder(Order), type);
+  for (uint8_t brightness : {0, 1, 40, 128, 254, 255})
+  {
+    Adafruit_NeoPixel reference(8, 0, type);
+    Adafruit_NeoPixel packed(8, 0, type);
+    reference.setBrightness(brightness);
+    packed.setBrightness(brightness);
+    PackedSink<Order, 2> sink = {packed.getPixels(), (uint16_t)(packed.getBrightness() + 1)};
+    for (uint16_t i = 0; i < 6; i++)
+    {
+      CRGB color(random(256), random(256), random(256));
+      reference.setPixelColor(i + 2, color.r, color.g, color.b);
+      sink.set(i, color);
+    }
+    CHECK(memcmp(reference.getPixels(), packed.getPixels(), 8 * 3) == 0);
+  }
+}
+
+int main()
+{
+  checkOrder<RGB>(NEO_RGB);
+  checkOrder<RBG>(NEO_RBG);
+  checkOrder<GRB>(NEO_GRB);
+  checkOrder<GBR>(NEO_GBR);
+  checkOrder<BRG>(NEO_BRG);
+  checkOrder<BGR>(NEO_BGR);
+
+  // 시작은 흰색 (밝기 40), 앞쪽은 꺼짐
+  Serial.muted = true;
+  hostClockFreeze(true);
+  setup();
+  CHECK(skippedDark());
+  CHECK(stripColor(SKIP_PIXELS) == CRGB(40, 40, 40));
+
+  // 버튼을 누르기 전에는 크리스마스: 첫 3초는 4픽셀 중 앞 2개 빨강, 뒤 2개 초록 (별은 흰색)
+  hostClockAdvance(300 * 1000UL);
+  uint32_t shows = strip.shows;
+  loop();
+  CHECK_EQ(strip.shows, shows + 1);
+  CHECK(skippedDark());
+  int matched = 0;
+  for (int i = 0; i < LIT_PIXELS; i++)
+  {
+    CRGB color = stripColor(SKIP_PIXELS + i);
+    CRGB expected = (i % 4 == 0 || i % 4 == 1) ? CRGB(40, 0, 0) : CRGB(0, 40, 0);
+    if (color == expected) matched++;
+    else CHECK(color == CRGB(40, 40, 32));
+  }
+  CHECK(matched > LIT_PIXELS * 9 / 10);
+
+  // 버튼(엔코더 SW, LOW가 눌림)으로 모닥불: 빨간색 위주, 파란색 없음
+  hostGpioInput &= ~(1u << ENCODER_SW);
+  hostClockAdvance(300 * 1000UL);
+  loop();
+  hostGpioInput |= 1u << ENCODER_SW;
+  CHECK(currentMode == CAMPFIRE_MODE);
+  hostClockAdvance(100 * 1000UL);
+  loop();
+  CHECK(skippedDark());
+  bool fire = true;
+  for (int i = SKIP_PIXELS; i < NUM_PIXELS; i++)
+  {
+    CRGB color = stripColor(i);
+    fire = fire && color.b == 0 && color.r > 0 && color.r >= color.g;
+  }
+  CHECK(fire);
+
+  // 엔코더로 밝기를 올리면 다음 갱신부터 그 밝기로 (setPixelColor()와 같은 계산)
+  encoderPos++;
+  encoderChanged = true;
+  hostClockAdvance(100 * 1000UL);
+  loop();
+  CHECK_EQ(strip.getBrightness(), 65);
+  uint8_t brightest = 0;
+  for (int i = SKIP_PIXELS; i < NUM_PIXELS; i++) brightest = max(brightest, stripColor(i).r);
+  CHECK(brightest > 40 && brightest <= 65);
+
+  return checkResult();
+}
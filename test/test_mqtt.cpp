@@ -0,0 +1,211 @@
+// MQTT: 브로커가 없을 때 재접속 간격이 두 배씩 늘어나는지, TCP 연결과 CONNECT, CONNACK 확인이
+// 다른 loop에서 기다림 없이 진행되는지, 받은 명령이 제어 큐를 거쳐 적용되는지 확인
+// (시험이 소켓 하나로 브로커 역할)
+
+#include <stdint.h>
+inline uint16_t testBrokerPort = 0;  // MQTT_PORT
+
+#include "firmware.h"
+
+#include <netinet/tcp.h>
+
+static std::string brokerReceived;
+
+static uint16_t freePort()
+{
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  bind(fd, (struct sockaddr *)&addr, sizeof(addr));
+  socklen_t length = sizeof(addr);
+  getsockname(fd, (struct sockaddr *)&addr, &length);
+  close(fd);
+  return ntohs(addr.sin_port);
+}
+
+static void brokerRead(int fd)
+{
+  char buffer[2048];
+  ssize_t n;
+  while ((n = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) brokerReceived.append(buffer, n);
+}
+
+static void brokerPublish(int fd, const std::string &topic, const std::string &payload)
+{
+  std::string packet(1, (char)0x30);
+  size_t length = 2 + topic.size() + payload.size();
+  packet += (char)(length % 128 | (length >= 128 ? 0x80 : 0));
+  if (length >= 128) packet += (char)(length / 128);
+  packet += (char)(topic.size() >> 8);
+  packet += (char)(topic.size() & 0xFF);
+  packet += topic + payload;
+  send(fd, packet.data(), packet.size(), MSG_NOSIGNAL);
+}
+
+// 콜백 해석: 명령 하나가 제어 큐의 어떤 항목이 되는지
+static void testCallbackParsing()
+{
+  controlQueueCount = 0;
+  char topic[] = "t";
+  char off[] = "{\"state\":\"OFF\",\"brightness\":200}";
+  mqttCallback(topic, (uint8_t *)off, strlen(off));
+  CHECK_EQ(controlQueueCount, 1);
+  CHECK_EQ(controlQueue[0].packet.opcode, CTRL_OP_SET_BRIGHTNESS);
+  CHECK_EQ(controlQueue[0].packet.payload[0], 0);
+
+  controlQueueCount = 0;
+  char on[] = "{\"state\":\"ON\",\"brightness\": 300,\"color\":{\"r\":1,\"g\":2,\"b\":3},\"effect\":\"Christmas\"}";
+  mqttCallback(topic, (uint8_t *)on, strlen(on));
+  CHECK_EQ(controlQueueCount, 3);
+  CHECK_EQ(controlQueue[0].packet.payload[0], 255);  // 범위 밖 밝기는 자름
+  CHECK_EQ(controlQueue[1].packet.opcode, CTRL_OP_SET_COLOR);
+  CHECK_EQ(controlQueue[1].packet.payload[2], 3);
+  CHECK_EQ(controlQueue[2].packet.opcode, CTRL_OP_SET_MODE);
+  CHECK_EQ(controlQueue[2].packet.payload[0], CHRISTMAS_MODE);
+  CHECK(controlQueue[2].packet.flags & CTRL_FLAG_PERSIST);
+
+  // 너무 긴 본문과 숫자가 아닌 값은 무시
+  controlQueueCount = 0;
+  char negative[] = "{\"brightness\":-5}";
+  uint8_t brightness = FastLED.getBrightness();
+  FastLED.setBrightness(10);
+  mqttCallback(topic, (uint8_t *)negative, strlen(negative));
+  CHECK_EQ(controlQueueCount, 0);
+  std::string longJson(300, ' ');
+  mqttCallback(topic, (uint8_t *)longJson.data(), longJson.size());
+  CHECK_EQ(controlQueueCount, 0);
+  FastLED.setBrightness(brightness);
+}
+
+int main()
+{
+  testBrokerPort = freePort();  // 아직 아무도 듣지 않는 포트 (연결 거부)
+  firmwareBoot();
+  CHECK_EQ(WiFi.status(), WL_CONNECTED);
+
+  // 첫 시도는 바로, 실패하면 5초부터 두 배씩 늦춤
+  firmwareLoops(1);
+  CHECK_EQ(mqttConnectFailures, 1);
+  CHECK_EQ(mqttRetryDelay, MQTT_RECONNECT_INTERVAL);
+  firmwareLoops(5);
+  CHECK_EQ(mqttConnectFailures, 1);
+  hostClockAdvance(MQTT_RECONNECT_INTERVAL * 1000UL);
+  firmwareLoops(1);
+  CHECK_EQ(mqttConnectFailures, 2);
+  CHECK_EQ(mqttRetryDelay, 2 * MQTT_RECONNECT_INTERVAL);
+  hostClockAdvance(MQTT_RECONNECT_INTERVAL * 1000UL);
+  firmwareLoops(1);
+  CHECK_EQ(mqttConnectFailures, 2);  // 아직 10초가 안 됨
+  hostClockAdvance(MQTT_RECONNECT_INTERVAL * 1000UL);
+  firmwareLoops(1);
+  CHECK_EQ(mqttConnectFailures, 3);
+  CHECK_EQ(mqttRetryDelay, 4 * MQTT_RECONNECT_INTERVAL);
+
+  // 상한
+  mqttRetryDelay = MQTT_RECONNECT_MAX - 1000;
+  hostClockAdvance(MQTT_RECONNECT_MAX * 1000UL);
+  firmwareLoops(1);
+  CHECK_EQ(mqttRetryDelay, MQTT_RECONNECT_MAX);
+
+  // 브로커 시작: 다음 시도에서 TCP만 연결하고 loop를 끝냄
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  int on = 1;
+  setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(testBrokerPort);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  CHECK(bind(listener, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+  listen(listener, 1);
+
+  hostClockAdvance(MQTT_RECONNECT_MAX * 1000UL);
+  firmwareLoops(1);
+  CHECK_EQ(mqttStage, MQTT_STAGE_TCP);
+  int broker = accept(listener, nullptr, nullptr);
+  CHECK(broker >= 0);
+
+  // CONNECT를 보낸 뒤 CONNACK이 없으면 loop는 기다리지 않고 계속 돌며, 기한이 지나면 실패로 셈
+  uint32_t failures = mqttConnectFailures;
+  firmwareLoops(1);
+  CHECK_EQ(mqttStage, MQTT_STAGE_CONNACK);
+  unsigned long loopsStart = millis();
+  firmwareLoops(5);
+  CHECK(millis() - loopsStart < 100);
+  CHECK_EQ(mqttStage, MQTT_STAGE_CONNACK);
+  hostClockAdvance(MQTT_CONNACK_TIMEOUT * 1000UL);
+  firmwareLoops(1);
+  CHECK_EQ(mqttStage, MQTT_STAGE_DISCONNECTED);
+  CHECK_EQ(mqttConnectFailures, failures + 1);
+  close(broker);
+
+  // 다음 시도: CONNECT를 받은 뒤 CONNACK을 보내면 다음 loop에서 구독 단계로
+  hostClockAdvance(MQTT_RECONNECT_MAX * 1000UL);
+  firmwareLoops(1);
+  CHECK_EQ(mqttStage, MQTT_STAGE_TCP);
+  broker = accept(listener, nullptr, nullptr);
+  CHECK(broker >= 0);
+  setsockopt(broker, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));  // 명령 패킷을 모아 두지 않음
+  firmwareLoops(1);
+  CHECK_EQ(mqttStage, MQTT_STAGE_CONNACK);
+  brokerRead(broker);
+  CHECK_EQ((uint8_t)brokerReceived[0], 0x10);  // CONNECT
+  CHECK(brokerReceived.find("MQTT") != std::string::npos);
+  CHECK(brokerReceived.find(mqttObjectId) != std::string::npos);
+  const uint8_t connack[4] = {0x20, 0x02, 0x00, 0x00};
+  send(broker, connack, sizeof(connack), 0);
+  firmwareLoops(1);
+  CHECK_EQ(mqttStage, MQTT_STAGE_SUBSCRIBE);
+  CHECK_EQ(mqttConnectFailures, 0);
+  CHECK_EQ(mqttRetryDelay, MQTT_RECONNECT_INTERVAL);
+
+  // 구독, 탐색, 상태를 loop마다 하나씩 발행
+  firmwareLoops(4);
+  brokerRead(broker);
+  CHECK(brokerReceived.find("/available") != std::string::npos);
+  CHECK(brokerReceived.find("online") != std::string::npos);
+  CHECK(brokerReceived.find(std::string(mqttBaseTopic) + "/set") != std::string::npos);
+  CHECK(brokerReceived.find("homeassistant/light/") != std::string::npos);
+  CHECK(brokerReceived.find("\"effect_list\"") != std::string::npos);
+  CHECK(brokerReceived.find(std::string(mqttBaseTopic) + "/state") != std::string::npos);
+  CHECK_EQ(mqttStage, MQTT_STAGE_READY);
+
+  // 명령 수신: 다음 프레임 시작에 적용
+  brokerPublish(broker, std::string(mqttBaseTopic) + "/set",
+                "{\"state\":\"ON\",\"brightness\":120,\"color\":{\"r\":1,\"g\":2,\"b\":3}}");
+  firmwareLoops(3);
+  CHECK_EQ(FastLED.getBrightness(), 120);
+  CHECK_EQ(mr, 1);
+  CHECK_EQ(mg, 2);
+  CHECK_EQ(mb, 3);
+
+  // 수신 버퍼보다 큰 패킷은 버리고 그 뒤 명령은 그대로 처리
+  brokerPublish(broker, std::string(mqttBaseTopic) + "/set", "{\"effect\":\"" + std::string(400, 'x') + "\"}");
+  brokerPublish(broker, std::string(mqttBaseTopic) + "/set", "{\"brightness\":90}");
+  firmwareLoops(3);
+  CHECK_EQ(FastLED.getBrightness(), 90);
+  CHECK_EQ(mqttStage, MQTT_STAGE_READY);
+
+  // 보낸 것이 없이 keep alive가 지나면 PINGREQ
+  brokerReceived.clear();
+  hostClockAdvance(MQTT_KEEPALIVE * 1000000UL);
+  firmwareLoops(1);
+  brokerRead(broker);
+  CHECK(brokerReceived.find(std::string("\xC0\x00", 2)) != std::string::npos);
+  CHECK(mqttPingPending);
+  const uint8_t pingresp[2] = {0xD0, 0x00};
+  send(broker, pingresp, sizeof(pingresp), 0);
+  firmwareLoops(1);
+  CHECK(!mqttPingPending);
+
+  // 브로커가 끊으면 처음 단계로, 5초 뒤 재접속 (keep alive 시험으로 앞당긴 시계 기준으로 방금 접속한 것처럼)
+  mqttLastAttempt = millis();
+  close(broker);
+  firmwareLoops(1);
+  CHECK_EQ(mqttStage, MQTT_STAGE_DISCONNECTED);
+  CHECK_EQ(mqttLastAttempt + MQTT_RECONNECT_INTERVAL > millis(), true);
+  close(listener);
+
+  testCallbackParsing();
+  return checkResult();
+}
@@ -0,0 +1,136 @@
+// 고정소수점 노이즈: 격자점에서 0, 실수 계산과의 오차, 이웃 픽셀 간 연속성(칸 경계 포함),
+// 커서 재사용이 결과를 바꾸지 않고 칸을 넘을 때만 모서리를 다시 계산하는지 확인
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <math.h>
+#include "noiseField.h"
+#include "check.h"
+
+// 같은 해시/그래디언트로 실수 계산한 값 (격자 한 칸 = 1.0, 결과는 256배해서 비교)
+static double noiseReference(uint32_t x, uint32_t y, uint32_t z)
+{
+  int32_t ix = x >> 8, iy = y >> 8, iz = z >> 8;
+  double f[3] = {(x & 0xFF) / 256.0, (y & 0xFF) / 256.0, (z & 0xFF) / 256.0};
+  double corner[8];
+  for (int c = 0; c < 8; c++)
+  {
+    const int8_t *g = noiseGradients[noiseHash(ix + (c & 1), iy + ((c >> 1) & 1), iz + (c >> 2))];
+    corner[c] = g[0] * (f[0] - (c & 1)) + g[1] * (f[1] - ((c >> 1) & 1)) + g[2] * (f[2] - (c >> 2));
+  }
+  double fade[3];
+  for (int a = 0; a < 3; a++) fade[a] = f[a] * f[a] * (3 - 2 * f[a]);
+  auto lerp = [](double a, double b, double t) { return a + (b - a) * t; };
+  double x0 = lerp(lerp(corner[0], corner[1], fade[0]), lerp(corner[2], corner[3], fade[0]), fade[1]);
+  double x1 = lerp(lerp(corner[4], corner[5], fade[0]), lerp(corner[6], corner[7], fade[0]), fade[1]);
+  return lerp(x0, x1, fade[2]) * 256;
+}
+
+static int16_t noiseFresh(uint32_t x, uint32_t y, uint32_t z)
+{
+  NoiseCursor cursor = {};
+  return noiseAt(cursor, x, y, z);
+}
+
+static void testLatticeAndRange()
+{
+  // 격자점에서는 모서리까지의 거리가 0이므로 0
+  for (uint32_t i = 0; i < 50; i++)
+  {
+    CHECK_EQ(noiseFresh(i * 256, (i * 7) * 256, (i * 13) * 256), 0);
+  }
+
+  // 실수 계산과 거의 같음 (고정소수점 반올림만 차이), 범위는 약 -256 ~ 256
+  int worst = 0, lowest = 0, highest = 0;
+  uint32_t seed = 1;
+  for (int i = 0; i < 20000; i++)
+  {
+    seed = seed * 1103515245 + 12345;
+    uint32_t x = seed >> 8 & 0xFFFFF;
+    seed = seed * 1103515245 + 12345;
+    uint32_t y = seed >> 8 & 0xFFFFF;
+    seed = seed * 1103515245 + 12345;
+    uint32_t z = seed >> 8 & 0xFFFFF;
+    int16_t n = noiseFresh(x, y, z);
+    worst = max(worst, (int)fabs(n - noiseReference(x, y, z)));
+    lowest = min(lowest, (int)n);
+    highest = max(highest, (int)n);
+  }
+  CHECK(worst <= 4);
+  CHECK(lowest >= -300 && highest <= 300);
+  CHECK(lowest < -150 && highest > 150);  // 한쪽으로 치우치지 않음
+}
+
+static void testContinuity()
+{
+  // x 방향으로 1/256칸씩: 칸 경계(255 -> 256)에서도 값이 튀지 않음
+  for (uint32_t y = 0; y < 8 * 256; y += 77)
+  {
+    NoiseCursor cursor = {};
+    int16_t previous = noiseAt(cursor, 0, y, 300);
+    for (uint32_t x = 1; x < 16 * 256; x++)
+    {
+      int16_t n = noiseAt(cursor, x, y, 300);
+      if (abs(n - previous) > 6)
+      {
+        CHECK(abs(n - previous) <= 6);
+        return;
+      }
+      previous = n;
+    }
+  }
+  // 시간축(z)도 마찬가지
+  int16_t previous = noiseFresh(500, 900, 0);
+  bool smooth = true;
+  for (uint32_t z = 1; z < 8 * 256; z++)
+  {
+    int16_t n = noiseFresh(500, 900, z);
+    smooth = smooth && abs(n - previous) <= 6;
+    previous = n;
+  }
+  CHECK(smooth);
+}
+
+static void testCursorReuse()
+{
+  // 스트립을 따라 계산: 재사용한 커서와 매번 새 커서의 결과가 같음
+  NoiseCursor cursor = {};
+  bool same = true;
+  for (uint32_t i = 0; i < 1000; i++)
+  {
+    uint32_t x = i * 37, y = 2000 + i * 5;
+    same = same && noiseAt(cursor, x, y, 4321) == noiseFresh(x, y, 4321);
+  }
+  CHECK(same);
+
+  // 모서리는 칸을 넘을 때만 다시 계산: x만 0 ~ 10칸, 픽셀 1024개
+  NoiseCursor strip = {};
+  for (uint32_t x = 0; x < 10 * 256; x += 2) noiseAt(strip, x, 128, 64);
+  CHECK_EQ(strip.cellLoads, 10);
+
+  // 칸 좌표가 해시에 모두 들어감 (x/y/z 어느 쪽이 바뀌어도 다시 계산)
+  NoiseCursor moved = {};
+  noiseAt(moved, 10, 10, 10);
+  noiseAt(moved, 10, 300, 10);
+  noiseAt(moved, 10, 300, 600);
+  noiseAt(moved, 10, 300, 601);
+  CHECK_EQ(moved.cellLoads, 3);
+}
+
+static void testToIndex()
+{
+  CHECK_EQ(noiseToIndex(0), 128);
+  CHECK_EQ(noiseToIndex(-128), 0);
+  CHECK_EQ(noiseToIndex(-300), 0);
+  CHECK_EQ(noiseToIndex(127), 255);
+  CHECK_EQ(noiseToIndex(300), 255);
+}
+
+int main()
+{
+  testLatticeAndRange();
+  testContinuity();
+  testCursorReuse();
+  testToIndex();
+  return checkResult();
+}
@@ -0,0 +1,134 @@
+// 호스트 출력 대상: 1000픽셀로 빌드해 미리보기 패킷이 400픽셀씩 나뉘는지 (UNIX 소켓),
+// 공유 메모리 프레임과 시퀀스 번호, spi 파일의 APA102 프레임, /output으로 끄고 켜기를 확인
+
+#include "firmware.h"
+
+#include <sys/un.h>
+
+static_assert(NUMPIXELS == 1000, "built with NUM_LEDS=1000");
+
+static void fillPattern(uint8_t salt)
+{
+  for (int i = 0; i < NUMPIXELS; i++) leds[i] = CRGB(i & 0xFF, (i >> 8) + salt, salt);
+}
+
+static void testSocket(const char *path)
+{
+  int receiver = socket(AF_UNIX, SOCK_DGRAM, 0);
+  struct sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  unlink(path);
+  CHECK(bind(receiver, (struct sockaddr *)&addr, sizeof(addr)) == 0);
+
+  fillPattern(7);
+  CHECK(socketWrite(leds, NUMPIXELS, 99));
+
+  // 400 + 400 + 200, 같은 프레임 번호, 픽셀은 R,G,B 그대로
+  const uint16_t expected[3][2] = {{0, 400}, {400, 400}, {800, 200}};
+  bool pixelsMatch = true;
+  for (const uint16_t *part : expected)
+  {
+    uint8_t packet[2048];
+    ssize_t n = recv(receiver, packet, sizeof(packet), MSG_DONTWAIT);
+    CHECK_EQ(n, (ssize_t)(sizeof(ViewerPacketHeader) + part[1] * 3));
+    ViewerPacketHeader header;
+    memcpy(&header, packet, sizeof(header));
+    CHECK_EQ(header.magic, VIEWER_MAGIC);
+    CHECK_EQ(header.frame, 0);
+    CHECK_EQ(header.offset, part[0]);
+    CHECK_EQ(header.count, part[1]);
+    CHECK_EQ(header.total, NUMPIXELS);
+    CHECK_EQ(header.brightness, 99);
+    pixelsMatch = pixelsMatch && memcmp(packet + sizeof(header), leds + part[0], part[1] * 3) == 0;
+  }
+  CHECK(pixelsMatch);
+  CHECK(recv(receiver, nullptr, 0, MSG_DONTWAIT) < 0);
+
+  // 받는 쪽이 없으면 실패로 기록 (기다리지 않음)
+  close(receiver);
+  unlink(path);
+  CHECK(!socketWrite(leds, NUMPIXELS, 99));
+  CHECK_EQ(hostSocketFrame, 2);
+}
+
+static void testShm(const char *name)
+{
+  CHECK(shmWrite(leds, NUMPIXELS, 42));
+  std::string file = std::string("/dev/shm/") + name;
+  int fd = open(file.c_str(), O_RDONLY);
+  CHECK(fd >= 0);
+  const HostShmFrame *shared = (const HostShmFrame *)mmap(nullptr, sizeof(HostShmFrame), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  CHECK_EQ(shared->magic, HOST_SHM_MAGIC);
+  CHECK_EQ(shared->seq, 2);
+  CHECK_EQ(shared->frame, 1);
+  CHECK_EQ(shared->count, NUMPIXELS);
+  CHECK_EQ(shared->brightness, 42);
+  CHECK(memcmp(shared->pixels, leds, NUMPIXELS * 3) == 0);
+
+  fillPattern(9);
+  CHECK(shmWrite(leds, NUMPIXELS, 43));
+  CHECK_EQ(shared->seq, 4);  // 다 쓴 뒤에는 항상 짝수
+  CHECK_EQ(shared->frame, 2);
+  CHECK(memcmp(shared->pixels, leds, NUMPIXELS * 3) == 0);
+  munmap((void *)shared, sizeof(HostShmFrame));
+  shm_unlink(name);
+}
+
+static void testSpiFile(const char *path)
+{
+  leds[0] = CRGB(255, 128, 0);
+  CHECK(spiWrite(leds, NUMPIXELS, 255));
+  CHECK(spiWrite(leds, NUMPIXELS, 128));  // 파일은 매 프레임 처음부터 덮어씀
+
+  FILE *file = fopen(path, "rb");
+  std::vector<uint8_t> data(8192);
+  size_t n = fread(data.data(), 1, data.size(), file);
+  fclose(file);
+  CHECK_EQ(n, 4 + NUMPIXELS * 4 + (NUMPIXELS + 15) / 16);
+  CHECK(data[0] == 0 && data[1] == 0 && data[2] == 0 && data[3] == 0);
+  // 첫 픽셀: 헤더, B, G, R (밝기 128 적용)
+  CHECK_EQ(data[4], 0xFF);
+  CHECK_EQ(data[5], 0);
+  CHECK_EQ(data[6], scale8(128, 128));
+  CHECK_EQ(data[7], scale8(255, 128));
+  CHECK_EQ(data[n - 1], 0xFF);
+  unlink(path);
+}
+
+int main()
+{
+  char socketPath[64], shmName[64], spiPath[64];
+  snprintf(socketPath, sizeof(socketPath), "/tmp/test_outputSink.%d.sock", getpid());
+  snprintf(shmName, sizeof(shmName), "test_outputSink.%d", getpid());
+  snprintf(spiPath, sizeof(spiPath), "/tmp/test_outputSink.%d.spi", getpid());
+
+  // 경로가 없으면 실패
+  CHECK(!socketWrite(leds, NUMPIXELS, 1));
+  CHECK(!shmWrite(leds, NUMPIXELS, 1));
+  CHECK(!spiWrite(leds, NUMPIXELS, 1));
+
+  hostSinkConfig.socketPath = socketPath;
+  hostSinkConfig.shmName = shmName;
+  hostSinkConfig.spiPath = spiPath;
+  testSocket(socketPath);
+  testShm(shmName);
+  testSpiFile(spiPath);
+
+  // /output에서 이름=0/1로 끄고 켬
+  firmwareBoot();
+  CHECK(!sinkEnabled(SINK_SHM));
+  std::string body = firmwareBody(firmwareGet("/output?shm=1&spi=1"));
+  CHECK(sinkEnabled(SINK_SHM));
+  CHECK(sinkEnabled(SINK_SPI));
+  CHECK(body.find("\"name\":\"socket\"") != std::string::npos);
+  firmwareGet("/output?spi=0");
+  CHECK(!sinkEnabled(SINK_SPI));
+  CHECK(firmwareGet("/output?shm=2").compare(0, 12, "HTTP/1.1 400") == 0);
+  sinkEnable(SINK_SHM, false);
+  shm_unlink(shmName);
+  unlink(spiPath);
+
+  return checkResult();
+}
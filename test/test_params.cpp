@@ -0,0 +1,69 @@
+// 효과 설정 항목: 이름 조회가 모드 안으로 한정되는지 (여러 모드의 "speed"),
+// 같은 모드 안 이름 중복을 표 검사가 잡는지, /params가 모드에 없는 이름을 거부하는지 확인
+
+#include "firmware.h"
+
+constexpr ParamDesc clashingTable[] = {
+  {"speed", "", MODE_BIT(CAMPFIRE_MODE), PARAM_U8, 0, 255, 0, 1, 0},
+  {"speed", "", MODE_BIT(CHRISTMAS_MODE), PARAM_U8, 0, 255, 0, 1, 0},
+  {"speeds", "", MODE_BIT(CAMPFIRE_MODE), PARAM_U8, 0, 255, 0, 1, 0},
+  {"speed", "", MODE_BIT(AURORA_MODE) | MODE_BIT(CAMPFIRE_MODE), PARAM_U8, 0, 255, 0, 1, 0}
+};
+// 모드가 다르면 같은 이름 허용, 접두사만 같으면 다른 이름, 모드가 하나라도 겹치면 중복
+static_assert(!paramNamesClash(clashingTable, 3), "different modes may share a name");
+static_assert(paramNamesClash(clashingTable, 4), "overlapping modes must not share a name");
+static_assert(!paramNamesClash(paramTable, PARAM_COUNT), "firmware table");
+
+static int paramValue(const std::string &json, const char *name)
+{
+  size_t at = json.find(std::string("\"name\":\"") + name + "\"");
+  if (at == std::string::npos) return -1;
+  at = json.find("\"value\":", at);
+  return atoi(json.c_str() + at + 8);
+}
+
+int main()
+{
+  // 같은 이름이 모드마다 다른 항목
+  CHECK_EQ(paramFind(CAMPFIRE_MODE, "speed"), PARAM_FIRE_SPEED);
+  CHECK_EQ(paramFind(CHRISTMAS_MODE, "speed"), PARAM_XMAS_SPEED);
+  CHECK_EQ(paramFind(WARMLIGHT_MODE, "speed"), PARAM_WARM_SPEED);
+  CHECK_EQ(paramFind(OCEAN_MODE, "speed"), PARAM_NOISE_SPEED);
+  CHECK_EQ(paramFind(CAMPFIRE_MODE, "star"), -1);
+  CHECK_EQ(paramFind(NORMAL_MODE, "speed"), -1);
+  CHECK_EQ(paramFind(CHRISTMAS_MODE, "spee"), -1);
+
+  firmwareBoot();
+  CHECK(bootDone());
+
+  // 모닥불 speed만 바뀌고 크리스마스 speed는 그대로
+  char path[96];
+  uint16_t xmas = param(PARAM_XMAS_SPEED);
+  snprintf(path, sizeof(path), "/params?mode=%d&speed=100&spark=7", CAMPFIRE_MODE);
+  std::string response = firmwareGet(path);
+  CHECK(response.compare(0, 12, "HTTP/1.1 200") == 0);
+  CHECK_EQ(paramValue(firmwareBody(response), "speed"), 100);
+  firmwareLoops(2);
+  CHECK_EQ(param(PARAM_FIRE_SPEED), 100);
+  CHECK_EQ(param(PARAM_FIRE_SPARK), 7);
+  CHECK_EQ(param(PARAM_XMAS_SPEED), xmas);
+
+  // 그 모드에 없는 이름이 섞이면 아무것도 바꾸지 않음
+  snprintf(path, sizeof(path), "/params?mode=%d&speed=120&star=5", CAMPFIRE_MODE);
+  response = firmwareGet(path);
+  CHECK(response.compare(0, 12, "HTTP/1.1 400") == 0);
+  CHECK(firmwareBody(response) == "Unknown parameter");
+  firmwareLoops(2);
+  CHECK_EQ(param(PARAM_FIRE_SPEED), 100);
+
+  // 범위는 그 모드 항목 기준 (크리스마스 speed는 1000까지, 모닥불은 250까지)
+  snprintf(path, sizeof(path), "/params?mode=%d&speed=600", CAMPFIRE_MODE);
+  CHECK(firmwareGet(path).compare(0, 12, "HTTP/1.1 400") == 0);
+  snprintf(path, sizeof(path), "/params?mode=%d&speed=600", CHRISTMAS_MODE);
+  CHECK(firmwareGet(path).compare(0, 12, "HTTP/1.1 200") == 0);
+  firmwareLoops(2);
+  CHECK_EQ(param(PARAM_XMAS_SPEED), 600);
+  CHECK_EQ(param(PARAM_FIRE_SPEED), 100);
+
+  return checkResult();
+}
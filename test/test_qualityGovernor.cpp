@@ -0,0 +1,135 @@
+// 적응형 품질 조절: 가짜 시계로
+//   - qualityNote()가 구간 안 초과 횟수, 단계 유지 시간, 회복 시간대로 단계를 바꾸는지
+//   - 펌웨어 loop()가 loop 사이 간격이 아니라 프레임(framePacerTake()) 사이 간격을 넘기는지
+//   - 유휴 대기 뒤 첫 프레임은 초과로 세지 않는지, 가장 긴 프레임 간격이 /metrics에 나오는지 확인
+
+#include "firmware.h"
+
+static void testGovernor()
+{
+  quality = {};
+  unsigned long now = 10000;
+  const uint32_t onTime = FRAME_PERIOD_MS * 1000UL;
+  const uint32_t late = QUALITY_MAX_GAP_US + 1;
+
+  // 틱 간격과 최대 간격까지는 초과가 아님, 0은 직전 프레임 없음
+  CHECK(!qualityNote(onTime, now));
+  CHECK(!qualityNote(QUALITY_MAX_GAP_US, now));
+  CHECK(!qualityNote(0, now));
+  CHECK_EQ(quality.overruns, 0);
+  CHECK(QUALITY_MAX_GAP_US < 2 * onTime);  // 틱 하나를 놓치면 초과
+
+  // 구간(1초) 안에서 세 번 넘으면 한 단계 낮춤
+  CHECK(!qualityNote(late, now += 16));
+  CHECK(!qualityNote(late, now += 16));
+  CHECK(qualityNote(late, now += 16));
+  CHECK_EQ(qualityLevel(), QUALITY_NO_DITHER);
+  CHECK_EQ(quality.stepsDown, 1);
+
+  // 바꾼 뒤 QUALITY_HOLD_MS 동안은 더 내려가지 않음
+  for (int i = 0; i < 5; i++) CHECK(!qualityNote(late, now += 16));
+  CHECK_EQ(qualityLevel(), QUALITY_NO_DITHER);
+  now += QUALITY_HOLD_MS;
+  CHECK(qualityNote(late, now));
+  CHECK_EQ(qualityLevel(), QUALITY_DEFER_IO);
+  CHECK_EQ(quality.overruns, 9);
+
+  // 구간이 바뀌면 초과 횟수를 다시 셈: 구간마다 두 번씩은 내려가지 않음
+  for (int window = 0; window < 3; window++)
+  {
+    now += QUALITY_WINDOW_MS;
+    CHECK(!qualityNote(late, now));
+    CHECK(!qualityNote(late, now + 10));
+  }
+  CHECK_EQ(qualityLevel(), QUALITY_DEFER_IO);
+
+  // 마지막 초과와 마지막 변경 뒤 QUALITY_UP_MS 동안 제때 오면 한 단계씩 회복
+  unsigned long lastOverrun = now + 10;
+  now = lastOverrun + QUALITY_UP_MS - 1;
+  CHECK(!qualityNote(onTime, now));
+  CHECK(qualityNote(onTime, now += 1));
+  CHECK_EQ(qualityLevel(), QUALITY_NO_DITHER);
+  CHECK(!qualityNote(onTime, now += QUALITY_UP_MS - 1));
+  CHECK(qualityNote(onTime, now += 1));
+  CHECK_EQ(qualityLevel(), QUALITY_FULL);
+  CHECK(!qualityNote(onTime, now += QUALITY_UP_MS));
+  CHECK_EQ(quality.stepsUp, 2);
+
+  // 가장 낮은 단계 아래로는 내려가지 않음
+  for (int i = 0; i < 2 * QUALITY_LEVELS; i++)
+  {
+    now += QUALITY_WINDOW_MS;
+    for (int k = 0; k < QUALITY_DOWN_OVERRUNS; k++) qualityNote(late, now + k);
+  }
+  CHECK_EQ(qualityLevel(), QUALITY_LEVELS - 1);
+  CHECK_EQ(quality.stepsDown, 2 + QUALITY_LEVELS - 1);
+}
+
+// 가짜 시계를 us만큼 앞당기고 loop 한 번 (ticks > 0이면 그만큼 프레임 틱이 쌓인 상태)
+static void loopAfter(uint32_t us, uint16_t ticks)
+{
+  hostClockAdvance(us);
+  framePacerTicks = ticks;
+  loop();
+}
+
+static void testFirmware()
+{
+  firmwareBoot();
+  CHECK(bootDone());
+  framePacerTicker.detach();  // 틱은 시험이 직접 올림
+  hostClockFreeze(true);
+  currentMode = CAMPFIRE_MODE;  // 매 단계 출력이 바뀌어 유휴 대기로 가지 않음
+  loopAfter(0, 1);
+  quality = {};
+  applyQualityLevel();
+  framePacerStats = {};
+
+  // loop는 10ms마다 돌지만 프레임은 틱을 놓쳐 30ms마다: loop 간격은 짧아도 프레임 간격 초과로 셈
+  for (int frame = 0; frame < QUALITY_DOWN_OVERRUNS; frame++)
+  {
+    CHECK_EQ(qualityLevel(), QUALITY_FULL);
+    loopAfter(10000, 0);
+    loopAfter(10000, 0);
+    loopAfter(10000, 2);
+    CHECK_EQ(framePacerStats.gapUs, 30000);
+  }
+  CHECK_EQ(quality.overruns, 3);
+  CHECK_EQ(framePacerStats.missed, 3);
+  CHECK_EQ(qualityLevel(), QUALITY_NO_DITHER);
+  CHECK_EQ(FastLED.dither, 0);  // 바뀐 단계가 이번 프레임부터 적용됨
+  CHECK_EQ(framePacerStats.maxGapUs, 30000);
+
+  // 프레임은 제때(16ms), 그 사이 loop가 몇 번이든 초과가 아님
+  for (int frame = 0; frame < 20; frame++)
+  {
+    loopAfter(6000, 0);
+    loopAfter(5000, 0);
+    loopAfter(5000, 1);
+    CHECK_EQ(framePacerStats.gapUs, 16000);
+  }
+  CHECK_EQ(quality.overruns, 3);
+
+  // 유휴 대기 뒤에는 직전 프레임이 없는 것으로 보고 대기 시간을 간격으로 세지 않음
+  framePacerSkip();
+  loopAfter(500000, 1);
+  CHECK_EQ(framePacerStats.gapUs, 0);
+  CHECK_EQ(quality.overruns, 3);
+  CHECK_EQ(framePacerStats.maxGapUs, 30000);
+
+  // 초과 없이 QUALITY_UP_MS가 지나면 회복
+  for (uint32_t t = 0; t <= QUALITY_UP_MS; t += FRAME_PERIOD_MS) loopAfter(FRAME_PERIOD_MS * 1000UL, 1);
+  CHECK_EQ(qualityLevel(), QUALITY_FULL);
+  CHECK(FastLED.dither != 0);
+
+  std::string metrics = firmwareBody(firmwareGet("/metrics"));
+  CHECK(metrics.find("\"maxGapUs\":30000") != std::string::npos);
+  hostClockFreeze(false);
+}
+
+int main()
+{
+  testGovernor();
+  testFirmware();
+  return checkResult();
+}
@@ -0,0 +1,152 @@
+// 청크 단위 단계 계산: 모닥불/크리스마스/은은한 조명 청크 계산을 한 번에 순서대로 계산한 결과와
+// 청크 순서를 섞어 계산한 결과, 여러 loop에 나눠 계산한 결과, 작업 훔치기 스레드 풀(host/renderPool.h)로
+// 계산한 결과가 상태와 출력 모두 비트 단위로 같은지 여러 단계에 걸쳐 확인 (1000픽셀 = 청크 32개, 마지막은 8픽셀)
+
+#include "main.cpp"
+#include "check.h"
+#include "renderPool.h"
+
+#include <random>
+
+static_assert(NUMPIXELS == 1000, "built with NUM_LEDS=1000");
+
+#define STEPS 6
+
+// 효과 상태 두 줄(a: 현재값, b: 목표값)과 출력
+struct Strip {
+  uint8_t a[NUMPIXELS];
+  uint8_t b[NUMPIXELS];
+  CRGB out[NUMPIXELS];
+  ChunkJob job;
+
+  void init()
+  {
+    randomSeed(12345);
+    for (int i = 0; i < NUMPIXELS; i++)
+    {
+      a[i] = random(50, 200);
+      b[i] = a[i];
+      out[i] = CRGB::Black;
+    }
+  }
+
+  bool operator==(const Strip &other) const
+  {
+    return memcmp(a, other.a, sizeof(a)) == 0 && memcmp(b, other.b, sizeof(b)) == 0 &&
+           memcmp(out, other.out, sizeof(out)) == 0;
+  }
+};
+
+static CampfireKernel<NUMPIXELS, CrgbSink> campfire(Strip &s)
+{
+  return {s.a, s.b, {s.out}, &activePalette, layoutY, 30, 10, true};
+}
+
+static ChristmasKernel<NUMPIXELS, CrgbSink> christmas(Strip &s, uint32_t step)
+{
+  return {{s.out}, &activePalette, step, (uint8_t)(step % 3), 20};
+}
+
+static WarmLightKernel<NUMPIXELS, CrgbSink> warmLight(Strip &s)
+{
+  return {s.a, s.b, {s.out}, CRGB(255, 180, 107), 30, 20, 230, 4, true};
+}
+
+enum Order { SEQUENTIAL, SHUFFLED, SLICED };
+
+// 한 단계 계산: 새 단계를 시작하고 정한 방식으로 모든 청크 계산
+template <typename Kernel>
+static void step(Strip &s, uint32_t stepNumber, bool halo, Kernel kernel, Order order)
+{
+  chunkJobStart(s.job, stepNumber, halo ? s.a : nullptr, NUMPIXELS);
+  if (order == SHUFFLED)
+  {
+    std::vector<uint16_t> chunks(chunkCount(s.job));
+    for (uint16_t c = 0; c < chunks.size(); c++) chunks[c] = c;
+    std::shuffle(chunks.begin(), chunks.end(), std::mt19937(stepNumber));
+    for (uint16_t c : chunks) chunkRun(s.job, c, kernel);
+    s.job.next = s.job.count;
+  }
+  else if (order == SLICED)
+  {
+    // 예산 1us면 loop마다 청크 한두 개만 계산 (남은 청크는 다음 호출로)
+    int passes = 0;
+    while (chunkJobRun(s.job, 1, kernel)) passes++;
+    CHECK(passes > 1);
+  }
+  else
+  {
+    CHECK(chunkJobRun(s.job, 0, kernel));
+  }
+  CHECK(!chunkJobBusy(s.job));
+}
+
+// 기준(순서대로) 결과와 order/스레드 수로 계산한 결과를 단계마다 비교
+template <typename MakeKernel>
+static void compare(const char *name, bool halo, MakeKernel makeKernel, Order order, uint8_t threads)
+{
+  static Strip reference, other;
+  reference.init();
+  other.init();
+  bool same = true;
+  // 단계 0, 청크 0은 effectSeed(0) ^ 0 = 시드 0이므로 randomSeed(0)을 피하는지도 함께 확인
+  for (uint32_t n = 0; n < STEPS; n++)
+  {
+    renderPoolStop();
+    step(reference, n, halo, makeKernel(reference, n), SEQUENTIAL);
+    renderPoolStart(threads);
+    step(other, n, halo, makeKernel(other, n), order);
+    if (!(reference == other)) same = false;
+  }
+  renderPoolStop();
+  if (!same) fprintf(stderr, "%s: 순서 %d, %u스레드 결과가 다름\n", name, order, threads);
+  CHECK(same);
+
+  // 단계마다 실제로 값이 바뀌고 있어야 비교가 의미 있음
+  Strip fresh;
+  fresh.init();
+  CHECK(!(fresh == reference));
+}
+
+template <typename MakeKernel>
+static void compareAll(const char *name, bool halo, MakeKernel makeKernel)
+{
+  compare(name, halo, makeKernel, SHUFFLED, 1);
+  compare(name, halo, makeKernel, SLICED, 1);
+  for (uint8_t threads : {2, 3, 4, 8}) compare(name, halo, makeKernel, SEQUENTIAL, threads);
+}
+
+int main()
+{
+  // 크리스마스 기본 팔레트 (처음 선택이므로 바로 적용), 2D 배치의 y값도 청크마다 다르게 읽히도록 채움
+  currentMode = CHRISTMAS_MODE;
+  selectPalette();
+  for (int i = 0; i < NUMPIXELS; i++) layoutY[i] = (uint32_t)i * LAYOUT_COORD_MAX / (NUMPIXELS - 1);
+
+  compareAll("campfire", true, [](Strip &s, uint32_t) { return campfire(s); });
+  compareAll("christmas", false, [](Strip &s, uint32_t n) { return christmas(s, n); });
+  compareAll("warmLight", true, [](Strip &s, uint32_t) { return warmLight(s); });
+
+  // 풀은 청크를 빠짐없이 한 번씩 계산하고 chunkStats에도 그대로 셈
+  renderPoolStats = {};
+  renderPoolStart(4);
+  static Strip s;
+  s.init();
+  uint32_t chunksBefore = chunkStats.chunks;
+  for (uint32_t n = 0; n < 50; n++) step(s, n, true, campfire(s), SEQUENTIAL);
+  CHECK_EQ(renderPoolStats.runs, 50);
+  CHECK_EQ(renderPoolStats.chunks, 50 * 32);
+  CHECK_EQ(chunkStats.chunks - chunksBefore, 50 * 32);
+  renderPoolStop();
+  CHECK(chunkParallel == nullptr);
+
+  // 나눠 계산하는 예산이 있으면 풀을 쓰지 않음 (loop 한 번의 시간 제한을 지킴)
+  renderPoolStart(4);
+  renderPoolStats = {};
+  s.init();
+  step(s, 1, true, warmLight(s), SLICED);
+  CHECK_EQ(renderPoolStats.runs, 0);
+  renderPoolStop();
+
+  return checkResult();
+}
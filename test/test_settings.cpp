@@ -0,0 +1,213 @@
+// 설정 레코드 변환: 버전 4 이전(노말/비트 모드가 빨강/초록을 바꿔 그리던) 레코드를 불러오면
+// 현재 장면과 프리셋 모두 빨강/초록을 바꿔 같은 색으로 보이고, 버전 5로 다시 저장한 뒤에는 그대로인지 확인
+// 프리셋 저장/동기화 역할 변경은 바로 쓰지 않고 다른 설정처럼 조용해진 뒤(SAVE_QUIET_MS) 한 번에 저장하는지 확인
+// 픽셀 배치 변경과 사용자 팔레트 업로드도 같은 지연 저장으로 한 번만 커밋하는지 확인
+
+#include "firmware.h"
+
+// 이전 버전 레코드를 그 버전의 장면 크기로 EEPROM에 씀 (체크섬은 loadSettingsOld와 같은 계산)
+static void writeOldRecord(uint8_t version, size_t recordSize, const SceneRecord &current, const SceneRecord &preset)
+{
+  EEPROM.begin(EEPROM_SIZE);
+  for (size_t addr = 0; addr < EEPROM_SIZE; addr++) EEPROM.write(addr, 0xFF);
+
+  std::vector<uint8_t> bytes;
+  uint16_t magic = SETTINGS_MAGIC;
+  bytes.push_back(magic & 0xFF);
+  bytes.push_back(magic >> 8);
+  bytes.push_back(version);
+  bytes.push_back(SYNC_OFF);
+  for (int s = 0; s < PRESET_COUNT + 1; s++)
+  {
+    const uint8_t *scene = (const uint8_t *)(s <= 1 ? (s == 0 ? &current : &preset) : &current);
+    bytes.insert(bytes.end(), scene, scene + recordSize);
+  }
+  bytes.push_back(0x01);  // 프리셋 0만 저장됨
+
+  uint8_t sum = 0;
+  for (uint8_t b : bytes) sum = (sum << 1 | sum >> 7) ^ b;
+  bytes.push_back(sum);
+  for (size_t i = 0; i < bytes.size(); i++) EEPROM.write(SETTINGS_ADDR + i, bytes[i]);
+}
+
+static SceneRecord coloredScene(uint8_t r, uint8_t g, uint8_t b)
+{
+  SceneRecord scene;
+  defaultScene(scene);
+  scene.mode = NORMAL_MODE;
+  scene.red = r;
+  scene.green = g;
+  scene.blue = b;
+  return scene;
+}
+
+static void testOldVersions()
+{
+  const size_t sizes[] = {SCENE_RECORD_V2_SIZE, SCENE_RECORD_V3_SIZE, SCENE_RECORD_V4_SIZE};
+  for (uint8_t version = 2; version <= 4; version++)
+  {
+    writeOldRecord(version, sizes[version - 2], coloredScene(10, 200, 30), coloredScene(1, 2, 3));
+    loadSettings();
+
+    // 현재 장면: 빨강/초록을 바꿔 적용
+    CHECK_EQ(mr, 200);
+    CHECK_EQ(mg, 10);
+    CHECK_EQ(mb, 30);
+    CHECK_EQ(currentMode, NORMAL_MODE);
+    CHECK(userColor() == CRGB(200, 10, 30));
+
+    // 프리셋도 변환, 저장 안 된 슬롯 표시는 그대로
+    CHECK_EQ(settings.presetUsed, 1);
+    CHECK_EQ(settings.presets[0].red, 2);
+    CHECK_EQ(settings.presets[0].green, 1);
+    CHECK_EQ(settings.presets[0].blue, 3);
+
+    // 새 버전으로 저장됨
+    StoredSettings stored;
+    EEPROM.get(SETTINGS_ADDR, stored);
+    CHECK_EQ(stored.version, SETTINGS_VERSION);
+    CHECK_EQ(stored.checksum, settingsChecksum(stored));
+  }
+
+  // 버전 5 레코드는 다시 불러와도 바꾸지 않음
+  loadSettings();
+  CHECK_EQ(mr, 200);
+  CHECK_EQ(mg, 10);
+  CHECK_EQ(settings.presets[0].red, 2);
+  CHECK_EQ(settings.presets[0].green, 1);
+}
+
+static void testLegacyLayout()
+{
+  // 버전 레코드 이전의 바이트 단위 레이아웃
+  EEPROM.begin(EEPROM_SIZE);
+  for (size_t addr = 0; addr < EEPROM_SIZE; addr++) EEPROM.write(addr, 0xFF);
+  EEPROM.write(LEGACY_MODE_ADDR, NORMAL_MODE);
+  EEPROM.write(LEGACY_RED_ADDR, 40);
+  EEPROM.write(LEGACY_RED_ADDR + 1, 50);
+  EEPROM.write(LEGACY_RED_ADDR + 2, 60);
+  EEPROM.write(LEGACY_BRIGHTNESS_ADDR, 70);
+  loadSettings();
+  CHECK_EQ(mr, 50);
+  CHECK_EQ(mg, 40);
+  CHECK_EQ(mb, 60);
+  CHECK_EQ(FastLED.getBrightness(), 70);
+
+  // 지운 EEPROM의 기본 흰색은 바꿔도 같음
+  EEPROM.begin(EEPROM_SIZE);
+  for (size_t addr = 0; addr < EEPROM_SIZE; addr++) EEPROM.write(addr, 0xFF);
+  loadSettings();
+  CHECK_EQ(mr, 255);
+  CHECK_EQ(mg, 255);
+}
+
+// EEPROM에 저장된 레코드
+static StoredSettings storedSettings()
+{
+  StoredSettings stored;
+  EEPROM.get(SETTINGS_ADDR, stored);
+  return stored;
+}
+
+static void testDeferredSaves()
+{
+  firmwareBoot();
+  CHECK(bootDone());
+  hostClockFreeze(true);
+  firmwareLoops(1);
+  CHECK_EQ(settingsSaveAt, 0);
+  uint8_t presetsBefore = storedSettings().presetUsed;
+  uint32_t savesBefore = intakeStats.saves;
+
+  // 프리셋 저장과 역할 변경이 연달아 와도 바로 쓰지 않음
+  CHECK(firmwareBody(firmwareGet("/savePreset?slot=3")) == "OK");
+  CHECK(firmwareGet("/sync?role=1").find("200 OK") != std::string::npos);
+  CHECK(settingsSaveAt != 0);
+  CHECK_EQ(storedSettings().presetUsed, presetsBefore);
+  CHECK_EQ(intakeStats.saves, savesBefore);
+
+  // 조용한 시간이 지나기 전에는 그대로, 지나면 한 번에 저장
+  hostClockAdvance((SAVE_QUIET_MS - 100) * 1000UL);
+  firmwareLoops(1);
+  CHECK_EQ(storedSettings().presetUsed, presetsBefore);
+  hostClockAdvance(200 * 1000UL);
+  firmwareLoops(1);
+  CHECK_EQ(intakeStats.saves, savesBefore + 1);
+  CHECK_EQ(settingsSaveAt, 0);
+  StoredSettings stored = storedSettings();
+  CHECK(stored.presetUsed & (1 << 3));
+  CHECK_EQ(stored.syncRole, SYNC_LEADER);
+  CHECK_EQ(stored.checksum, settingsChecksum(stored));
+  hostClockFreeze(false);
+}
+
+static void testDeferredLayout()
+{
+  hostClockFreeze(true);
+  firmwareLoops(1);
+  uint32_t commits = EEPROM.commits;
+
+  // 연달아 바꿔도 커밋하지 않고 RAM 표만 바로 바뀜
+  CHECK(firmwareGet("/layout?type=2&w=20&h=10").find("200 OK") != std::string::npos);
+  CHECK(firmwareGet("/layout?type=1&w=10&h=20").find("200 OK") != std::string::npos);
+  CHECK_EQ(layoutType, LAYOUT_MATRIX);
+  CHECK_EQ(EEPROM.commits, commits);
+  CHECK(storeDirty & STORE_LAYOUT);
+
+  // 조용해지면 설정과 함께 한 번 커밋
+  hostClockAdvance((SAVE_QUIET_MS + 100) * 1000UL);
+  firmwareLoops(1);
+  CHECK_EQ(EEPROM.commits, commits + 1);
+  CHECK_EQ(storeDirty, 0);
+  LayoutHeader header;
+  EEPROM.get(LAYOUT_ADDR, header);
+  CHECK_EQ(header.magic, LAYOUT_MAGIC);
+  CHECK_EQ(header.type, LAYOUT_MATRIX);
+  CHECK_EQ(header.width, 10);
+  CHECK_EQ(header.height, 20);
+
+  // 정규화 위치는 첫 행 0, 마지막 행 LAYOUT_COORD_MAX
+  CHECK_EQ(layoutY[0], 0);
+  CHECK_EQ(layoutY[NUMPIXELS - 1], layoutNormalize((NUMPIXELS - 1) / 10, 20));
+  CHECK_EQ(layoutNormalize(19, 20), LAYOUT_COORD_MAX);
+  hostClockFreeze(false);
+}
+
+static void testDeferredPalette()
+{
+  hostClockFreeze(true);
+  firmwareLoops(1);
+  uint32_t commits = EEPROM.commits;
+
+  // 업로드는 바로 쓰이고(선택되면 바로 보임) 플래시에는 조용해진 뒤 한 번
+  const uint8_t first[8] = {0, 255, 0, 0, 255, 0, 0, 255};
+  const uint8_t second[12] = {0, 0, 255, 0, 128, 10, 20, 30, 255, 255, 255, 255};
+  CHECK(uploadCustomPalette(first, sizeof(first)));
+  CHECK(uploadCustomPalette(second, sizeof(second)));
+  CHECK_EQ(customGradientLength, sizeof(second));
+  CHECK_EQ(EEPROM.commits, commits);
+  CHECK(storeDirty & STORE_PALETTE);
+
+  hostClockAdvance((SAVE_QUIET_MS + 100) * 1000UL);
+  firmwareLoops(1);
+  CHECK_EQ(EEPROM.commits, commits + 1);
+  CHECK_EQ(storeDirty, 0);
+
+  // 저장된 것은 마지막 업로드
+  customGradientLength = 0;
+  loadCustomPalette();
+  CHECK_EQ(customGradientLength, sizeof(second));
+  CHECK(memcmp(customGradient, second, sizeof(second)) == 0);
+  hostClockFreeze(false);
+}
+
+int main()
+{
+  Serial.muted = true;
+  testOldVersions();
+  testLegacyLayout();
+  testDeferredSaves();
+  testDeferredLayout();
+  testDeferredPalette();
+  return checkResult();
+}
@@ -0,0 +1,81 @@
+// UDP 제어: 실제 UDP 소켓으로 패킷을 보내 프레임 경계에서 적용되는지,
+// /metrics?reset=1이 통계만 초기화하고 제어 포트를 다시 열지 않는지 확인
+
+#include "firmware.h"
+
+static int controlSocket = -1;
+
+static void sendControl(uint8_t opcode, uint8_t flags, uint16_t seq, const uint8_t *payload, size_t length,
+                        uint8_t magic = CTRL_MAGIC)
+{
+  ControlPacket packet = {};
+  packet.magic = magic;
+  packet.version = CTRL_VERSION;
+  packet.opcode = opcode;
+  packet.flags = flags;
+  packet.seq = seq;
+  memcpy(packet.payload, payload, length);
+
+  struct sockaddr_in to = {};
+  to.sin_family = AF_INET;
+  to.sin_port = htons(hostBoundPort(UDP_CONTROL_PORT));
+  to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  sendto(controlSocket, &packet, sizeof(packet), 0, (struct sockaddr *)&to, sizeof(to));
+}
+
+static bool receiveAck(ControlPacket &ack)
+{
+  return recv(controlSocket, &ack, sizeof(ack), MSG_DONTWAIT) == (ssize_t)sizeof(ack);
+}
+
+int main()
+{
+  firmwareBoot();
+  CHECK(bootDone());
+  uint16_t port = hostBoundPort(UDP_CONTROL_PORT);
+  CHECK(port != 0);
+
+  controlSocket = socket(AF_INET, SOCK_DGRAM, 0);
+
+  // 색상 변경 + ACK: 다음 loop에서 적용되고 같은 seq로 회신
+  const uint8_t color[3] = {10, 20, 30};
+  sendControl(CTRL_OP_SET_COLOR, CTRL_FLAG_ACK, 0x1234, color, sizeof(color));
+  firmwareLoops(2);
+  CHECK_EQ(mr, 10);
+  CHECK_EQ(mg, 20);
+  CHECK_EQ(mb, 30);
+  ControlPacket ack;
+  CHECK(receiveAck(ack));
+  CHECK_EQ(ack.opcode, CTRL_OP_SET_COLOR | CTRL_OP_ACK);
+  CHECK_EQ(ack.seq, 0x1234);
+  CHECK_EQ(ack.payload[0], 0);
+
+  // 잘못된 매직은 버리고 셈
+  uint32_t dropped = controlDropped;
+  sendControl(CTRL_OP_SET_BRIGHTNESS, CTRL_FLAG_ACK, 1, color, 1, 0x00);
+  firmwareLoops(2);
+  CHECK_EQ(controlDropped, dropped + 1);
+  CHECK(!receiveAck(ack));
+
+  // 없는 모드는 실패 ACK
+  const uint8_t badMode = MODE_COUNT;
+  sendControl(CTRL_OP_SET_MODE, CTRL_FLAG_ACK, 2, &badMode, 1);
+  firmwareLoops(2);
+  CHECK(receiveAck(ack));
+  CHECK_EQ(ack.payload[0], 1);
+
+  // 통계 초기화는 제어 포트를 건드리지 않음 (다시 열었다면 빈 포트가 새로 배정됨)
+  std::string response = firmwareGet("/metrics?reset=1");
+  CHECK(response.compare(0, 12, "HTTP/1.1 200") == 0);
+  CHECK_EQ(hostBoundPort(UDP_CONTROL_PORT), port);
+
+  const uint8_t brightness = 77;
+  sendControl(CTRL_OP_SET_BRIGHTNESS, CTRL_FLAG_ACK, 3, &brightness, 1);
+  firmwareLoops(2);
+  CHECK_EQ(FastLED.getBrightness(), 77);
+  CHECK(receiveAck(ack));
+  CHECK_EQ(ack.seq, 3);
+
+  close(controlSocket);
+  return checkResult();
+}
@@ -0,0 +1,155 @@
+// 웹 서버: 잘못된 Content-Length 거부, 연결 수 초과 시 RST로 바로 끊기,
+// 문자열 상수 본문 전송 중에는 다른 요청 핸들러가 기다리지 않는지 확인
+
+#include "firmware.h"
+
+#define TEST_DEVICE_PORT 8080
+
+LightWebServer testServer(TEST_DEVICE_PORT);
+uint32_t bigCalls = 0;
+uint32_t okCalls = 0;
+uint32_t echoLength = 0;
+static char bigBody[4 << 20];  // 소켓 버퍼를 채워 전송 중 상태로 남는 큰 본문 (RAM, jsonBuffer 아님)
+
+static int connectTest(int receiveBuffer = 0)
+{
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (receiveBuffer > 0) setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(hostBoundPort(TEST_DEVICE_PORT));
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  connect(fd, (struct sockaddr *)&addr, sizeof(addr));
+  return fd;
+}
+
+static void sendText(int fd, const std::string &text)
+{
+  send(fd, text.data(), text.size(), MSG_NOSIGNAL);
+}
+
+static void pollServer(int times)
+{
+  for (int i = 0; i < times; i++)
+  {
+    testServer.poll(HTTP_IO_BUDGET_US);
+    usleep(100);
+  }
+}
+
+// 연결이 닫힐 때까지 서버를 돌리며 응답을 모음
+static std::string exchange(const std::string &request)
+{
+  int fd = connectTest();
+  sendText(fd, request);
+  std::string response;
+  for (int i = 0; i < 2000; i++)
+  {
+    testServer.poll(HTTP_IO_BUDGET_US);
+    char buffer[1024];
+    ssize_t n = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (n > 0) response.append(buffer, n);
+    else if (n == 0) break;
+    else usleep(100);
+  }
+  close(fd);
+  return response;
+}
+
+static void testContentLength()
+{
+  std::string ok = exchange("POST /echo HTTP/1.1\r\nContent-Length: 5\r\n\r\nhello");
+  CHECK(ok.compare(0, 12, "HTTP/1.1 200") == 0);
+  CHECK_EQ(echoLength, 5);
+
+  std::string spaced = exchange("POST /echo HTTP/1.1\r\ncontent-length:\t3 \r\n\r\nabc");
+  CHECK(spaced.compare(0, 12, "HTTP/1.1 200") == 0);
+  CHECK_EQ(echoLength, 3);
+
+  // 음수는 예전에 65535가 되어 제한 시간까지 기다렸음
+  unsigned long start = millis();
+  CHECK(exchange("POST /echo HTTP/1.1\r\nContent-Length: -1\r\n\r\n").compare(0, 12, "HTTP/1.1 400") == 0);
+  CHECK(millis() - start < HTTP_READ_TIMEOUT);
+  CHECK(exchange("POST /echo HTTP/1.1\r\nContent-Length: abc\r\n\r\n").compare(0, 12, "HTTP/1.1 400") == 0);
+  CHECK(exchange("POST /echo HTTP/1.1\r\nContent-Length: 12x\r\n\r\n").compare(0, 12, "HTTP/1.1 400") == 0);
+  CHECK(exchange("POST /echo HTTP/1.1\r\nContent-Length: 99999999999\r\n\r\n").compare(0, 12, "HTTP/1.1 413") == 0);
+  CHECK(exchange("POST /echo HTTP/1.1\r\nContent-Length: 600\r\n\r\n").compare(0, 12, "HTTP/1.1 413") == 0);
+}
+
+static void testExcessClientAborted()
+{
+  int held[HTTP_MAX_CLIENTS];
+  for (int i = 0; i < HTTP_MAX_CLIENTS; i++) held[i] = connectTest();
+  pollServer(2);
+  CHECK_EQ(testServer.activeClients(), HTTP_MAX_CLIENTS);
+
+  int extra = connectTest();
+  unsigned long start = micros();
+  pollServer(1);
+  CHECK(micros() - start < 50000);
+
+  // FIN이 아니라 RST: 읽으면 0(정상 종료)이 아니라 ECONNRESET
+  char c;
+  ssize_t n = -1;
+  int error = 0;
+  for (int i = 0; i < 100; i++)
+  {
+    n = recv(extra, &c, 1, MSG_DONTWAIT);
+    error = errno;
+    if (!(n < 0 && error == EAGAIN)) break;
+    usleep(1000);
+  }
+  CHECK(n < 0);
+  CHECK_EQ(error, ECONNRESET);
+  close(extra);
+
+  for (int i = 0; i < HTTP_MAX_CLIENTS; i++) close(held[i]);
+  pollServer(10);
+  CHECK_EQ(testServer.activeClients(), 0);
+}
+
+static void testStaticBodyDoesNotBlock()
+{
+  // 읽지 않는 클라이언트에게 큰 상수 본문 전송 중
+  int slow = connectTest(4096);
+  sendText(slow, "GET /big HTTP/1.1\r\n\r\n");
+  pollServer(20);
+  CHECK_EQ(bigCalls, 1);
+  CHECK_EQ(testServer.activeClients(), 1);
+
+  // 다른 요청의 핸들러는 바로 실행됨
+  uint32_t before = okCalls;
+  int fast = connectTest();
+  sendText(fast, "GET /ok HTTP/1.1\r\n\r\n");
+  pollServer(20);
+  CHECK_EQ(okCalls, before + 1);
+
+  close(fast);
+  close(slow);
+  pollServer(10);
+}
+
+int main()
+{
+  firmwareBoot();
+  memset(bigBody, 'x', sizeof(bigBody));
+  hostMapPort(TEST_DEVICE_PORT, 0);
+  testServer.on("/echo", []() {
+    echoLength = testServer.bodyLength();
+    testServer.send(200, "text/plain", "OK");
+  });
+  testServer.on("/big", []() {
+    bigCalls++;
+    testServer.send(200, "text/plain", bigBody, sizeof(bigBody));
+  });
+  testServer.on("/ok", []() {
+    okCalls++;
+    testServer.send(200, "text/plain", "OK");
+  });
+  testServer.begin();
+
+  testContentLength();
+  testExcessClientAborted();
+  testStaticBodyDoesNotBlock();
+  return checkResult();
+}